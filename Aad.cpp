@@ -0,0 +1,45 @@
+#include "Aad.h"
+
+// Bande propre au thread appelant
+Tape& Tape::local() {
+    thread_local Tape tape;
+    return tape;
+}
+
+// Variable d'entre : noeud sans argument
+int Tape::newVariable() {
+    nodes.push_back(Node{-1, -1, 0.0, 0.0});
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+// Noeud unaire
+int Tape::push(int arg0, double weight0) {
+    nodes.push_back(Node{arg0, -1, weight0, 0.0});
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+// Noeud binaire
+int Tape::push(int arg0, double weight0, int arg1, double weight1) {
+    nodes.push_back(Node{arg0, arg1, weight0, weight1});
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+// Vide la bande sans librer la mmoire
+void Tape::clear() {
+    nodes.clear();
+}
+
+// Balayage arrire : accumulation des adjoints du rsultat vers les entres
+void Tape::propagate(int result) {
+    adjoints.assign(nodes.size(), 0.0);
+    if (result < 0) return; // Rsultat constant : toutes les drives sont nulles
+    adjoints[result] = 1.0;
+
+    for (int i = result; i >= 0; --i) {
+        double a = adjoints[i];
+        if (a == 0.0) continue;
+        const Node& node = nodes[i];
+        if (node.arg0 >= 0) adjoints[node.arg0] += a * node.weight0;
+        if (node.arg1 >= 0) adjoints[node.arg1] += a * node.weight1;
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef AAD_H
+#define AAD_H
+
+#include <cmath>   // Pour std::exp, std::log, std::sqrt
+#include <cstddef> // Pour std::size_t
+#include <vector>  // Pour le stockage de la bande
+
+// Diffrentiation automatique adjointe (AAD, mode inverse) par bande
+//
+// Chaque opration sur des ADouble enregistre sur la bande du thread courant au plus deux
+// drives partielles locales. Un seul balayage arrire (propagate) donne ensuite les
+// drives du rsultat par rapport  toutes les variables d'entre, pour un cot
+// proportionnel  celui du calcul direct, quel que soit le nombre d'entres.
+// Les constantes (index ngatif) ne sont pas enregistres.
+class Tape {
+public:
+    // Bande propre au thread appelant
+    static Tape& local();
+
+    // Cre une variable d'entre (feuille) et renvoie son index
+    int newVariable();
+
+    // Enregistre un noeud unaire ou binaire et renvoie son index
+    int push(int arg0, double weight0);
+    int push(int arg0, double weight0, int arg1, double weight1);
+
+    // Vide la bande en conservant la mmoire (aucune allocation d'une trajectoire  l'autre)
+    void clear();
+
+    // Balayage arrire depuis le noeud result (adjoint initial 1)
+    void propagate(int result);
+
+    // Adjoint d'un noeud aprs propagate
+    double adjoint(int index) const { return adjoints[index]; }
+
+    // Nombre de noeuds enregistrs
+    std::size_t size() const { return nodes.size(); }
+
+private:
+    // Noeud de la bande : au plus deux arguments et leurs drives partielles
+    struct Node {
+        int arg0;
+        int arg1;
+        double weight0;
+        double weight1;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<double> adjoints;
+};
+
+// Nombre rel diffrentiable enregistr sur la bande du thread courant
+class ADouble {
+public:
+    double value; // Valeur
+    int index;    // Index sur la bande (-1 pour une constante)
+
+    // Constante (non diffrentie)
+    ADouble(double value_ = 0.0) : value(value_), index(-1) {}
+
+    // Construction directe  partir d'une valeur et d'un index sur la bande
+    ADouble(double value_, int index_) : value(value_), index(index_) {}
+
+    // Cre une variable d'entre sur la bande
+    static ADouble variable(double value) { return ADouble(value, Tape::local().newVariable()); }
+
+    ADouble& operator+=(const ADouble& other) { return *this = *this + other; }
+    ADouble& operator*=(const ADouble& other) { return *this = *this * other; }
+
+    friend ADouble operator+(const ADouble& a, const ADouble& b);
+    friend ADouble operator*(const ADouble& a, const ADouble& b);
+};
+
+// Enregistre une opration unaire (sauf si l'argument est constant)
+inline ADouble unaryNode(const ADouble& a, double value, double da) {
+    if (a.index < 0) return ADouble(value);
+    return ADouble(value, Tape::local().push(a.index, da));
+}
+
+// Enregistre une opration binaire (rduite  une opration unaire si un argument est constant)
+inline ADouble binaryNode(const ADouble& a, const ADouble& b, double value, double da, double db) {
+    if (a.index < 0) return unaryNode(b, value, db);
+    if (b.index < 0) return unaryNode(a, value, da);
+    return ADouble(value, Tape::local().push(a.index, da, b.index, db));
+}
+
+inline ADouble operator+(const ADouble& a, const ADouble& b) { return binaryNode(a, b, a.value + b.value, 1.0, 1.0); }
+inline ADouble operator-(const ADouble& a, const ADouble& b) { return binaryNode(a, b, a.value - b.value, 1.0, -1.0); }
+inline ADouble operator*(const ADouble& a, const ADouble& b) { return binaryNode(a, b, a.value * b.value, b.value, a.value); }
+inline ADouble operator/(const ADouble& a, const ADouble& b) {
+    double inv = 1.0 / b.value;
+    return binaryNode(a, b, a.value * inv, inv, -a.value * inv * inv);
+}
+inline ADouble operator-(const ADouble& a) { return unaryNode(a, -a.value, -1.0); }
+
+inline ADouble exp(const ADouble& a) {
+    double e = std::exp(a.value);
+    return unaryNode(a, e, e);
+}
+inline ADouble log(const ADouble& a) { return unaryNode(a, std::log(a.value), 1.0 / a.value); }
+inline ADouble sqrt(const ADouble& a) {
+    double s = std::sqrt(a.value);
+    return unaryNode(a, s, 0.5 / s);
+}
+
+// max et min : la drive suit l'argument retenu
+inline ADouble max(const ADouble& a, const ADouble& b) { return a.value >= b.value ? a : b; }
+inline ADouble min(const ADouble& a, const ADouble& b) { return a.value <= b.value ? a : b; }
+
+// Comparaisons sur les valeurs
+inline bool operator<(const ADouble& a, const ADouble& b) { return a.value < b.value; }
+inline bool operator>(const ADouble& a, const ADouble& b) { return a.value > b.value; }
+inline bool operator<=(const ADouble& a, const ADouble& b) { return a.value <= b.value; }
+inline bool operator>=(const ADouble& a, const ADouble& b) { return a.value >= b.value; }
+
+// Indicatrice lisse 1{x >= 0} : rampe linaire de largeur width centre en 0
+// Remplace une indicatrice (barrire) dont la drive trajectorielle serait nulle presque partout
+inline ADouble smoothStep(const ADouble& x, double width) {
+    double t = x.value / width + 0.5;
+    if (t <= 0.0) return ADouble(0.0);
+    if (t >= 1.0) return ADouble(1.0);
+    return unaryNode(x, t, 1.0 / width);
+}
+
+#endif // AAD_H
@@ -1,7 +1,9 @@
 #include "AsianOption.h"
+#include "MonteCarloEngine.h" // Moteur Monte-Carlo commun (simulation des trajectoires)
+#include "PricingKey.h" // Cl de cache
 #include <numeric>  // Pour std::accumulate (calcul de la moyenne)
 #include <cmath>    // Pour std::exp (exponentielle)
-#include <random>   // Pour std::mt19937 et std::normal_distribution (gnration de nombres alatoires)
+#include <random>   // Pour std::mt19937
 #include <stdexcept>  // Pour std::logic_error (gestion des exceptions)
 
 // Constructeur de la classe AsianOption
@@ -20,95 +22,93 @@ double AsianOption::payoff(const std::vector<double>& path) const {
     }
 }
 
-// Implmentation de la mthode inutilise (hrite de ExoticOption)
-// Cette mthode n'a pas de sens pour une option asiatique et gnre une exception si appele
-double AsianOption::payoff(double spot) const {
-    throw std::logic_error("payoff(double spot) is not applicable for AsianOption.");
+// Payoff sur une vue de trajectoire : la moyenne porte sur les dates simules (hors prix initial)
+// La somme est accumule en double, y compris pour une trajectoire simule en float
+template <typename T>
+double AsianOption::pathPayoff(const BasicPathView<T>& path) const {
+    double sum = 0.0;
+    for (int j = 1; j < path.size(); ++j) {
+        sum += path[j];
+    }
+    double average = sum / (path.size() - 1); // Moyenne arithmtique
+    if (optionType == OptionType::Call) {
+        return std::max(average - strike, 0.0); // Payoff pour un call
+    } else { // OptionType::Put
+        return std::max(strike - average, 0.0); // Payoff pour un put
+    }
 }
 
-// Mthode pour calculer le prix par Monte-Carlo en utilisant la maturit par dfaut
-double AsianOption::price(const BlackScholesModel& model, int numPaths, int steps) const {
-    return this->price(model, numPaths, steps, maturity); // Appelle la version surcharge avec la maturit par dfaut
+double AsianOption::payoff(const PathView& path) const {
+    return pathPayoff(path);
 }
 
-// Mthode pour calculer le prix par Monte-Carlo en permettant une maturit ajuste
-double AsianOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity) const {
-    double sumPayoffs = 0.0; // Somme des payoffs simuls
-    double dt = adjustedMaturity / steps; // Pas temporel
-
-    std::mt19937 rng(std::random_device{}()); // Gnrateur alatoire avec une graine dynamique
-    std::normal_distribution<> dist(0.0, 1.0); // Distribution normale standard
-
-    for (int i = 0; i < numPaths; ++i) {
-        double spot = model.spot; // Prix initial du sous-jacent
-        std::vector<double> path; // Chemin pour stocker les prix simuls
-        path.reserve(steps); // Prallocation mmoire
-
-        // Simulation de la trajectoire du sous-jacent
-        for (int j = 0; j < steps; ++j) {
-            double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-            double diffusion = model.volatility * std::sqrt(dt) * dist(rng);
-            spot *= std::exp(drift + diffusion); // Mise  jour du prix
-            path.push_back(spot); // Enregistrement du prix simul
-        }
+double AsianOption::payoff(const PathViewF& path) const {
+    return pathPayoff(path);
+}
 
-        sumPayoffs += payoff(path); // Ajout du payoff bas sur la trajectoire
+// Moyenne courante des dates simules de la vue (variable de rgression)
+double AsianOption::pathStatistic(const PathView& path) const {
+    double sum = 0.0;
+    for (int j = 1; j < path.size(); ++j) {
+        sum += path[j];
     }
-
-    return std::exp(-model.rate * adjustedMaturity) * (sumPayoffs / numPaths); // Actualisation et moyenne des payoffs
+    return sum / (path.size() - 1);
 }
 
-// Mthode pour calculer le cot de rplication bas sur le delta hedging
-double AsianOption::hedgeCost(const BlackScholesModel& model, int steps) const {
-    int numPaths = 10000; // Nombre de trajectoires Monte-Carlo
-    double epsilon = 0.01 * model.spot; // Variation pour le calcul des diffrences finies
-
-    // Initialisation du delta
-    BlackScholesModel modelUp = model;
-    modelUp.spot += epsilon; // Modle avec spot augment
-    BlackScholesModel modelDown = model;
-    modelDown.spot -= epsilon; // Modle avec spot diminu
-
-    double priceUp = this->price(modelUp, numPaths, steps); // Prix pour spot augment
-    double priceDown = this->price(modelDown, numPaths, steps); // Prix pour spot diminu
-
-    double previousDelta = 0; // Delta  l'tape prcdente
-    double delta = (priceUp - priceDown) / (2 * epsilon); // Delta initial par diffrences finies
-
-    double dt = maturity / steps; // Pas temporel
-    double spot = model.spot; // Prix initial du sous-jacent
-    double cash = delta * spot; // Portefeuille initial en cash
-
-    // Pour sauvegarder la trajectoire
-    std::vector<double> path;
-    path.push_back(spot);
-
-    for (int i = 1; i < steps; ++i) {
-        // Maturit ajuste
-        double adjustedMaturity = maturity - i * dt;
-
-        // Simulation du prix du sous-jacent
-        double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-        double diffusion = model.volatility * std::sqrt(dt) * ((double)rand() / RAND_MAX - 0.5);
-        spot *= std::exp(drift + diffusion); // Mise  jour du prix simul
-        path.push_back(spot); // Enregistrement du prix simul
+// Payoff diffrentiable (AAD) : mme moyenne arithmtique, enregistre sur la bande
+ADouble AsianOption::payoff(const PathViewAD& path, double) const {
+    ADouble sum = 0.0;
+    for (int j = 1; j < path.size(); ++j) {
+        sum += path[j];
+    }
+    ADouble average = sum * (1.0 / (path.size() - 1)); // Moyenne arithmtique
+    if (optionType == OptionType::Call) {
+        return max(average - strike, 0.0); // Payoff pour un call
+    } else { // OptionType::Put
+        return max(strike - average, 0.0); // Payoff pour un put
+    }
+}
 
-        // Calcul du nouveau delta
-        double previousDelta = delta;
+// Implmentation de la mthode inutilise (hrite de ExoticOption)
+// Cette mthode n'a pas de sens pour une option asiatique et gnre une exception si appele
+double AsianOption::payoff(double spot) const {
+    throw std::logic_error("payoff(double spot) is not applicable for AsianOption.");
+}
 
-        modelUp.spot = spot + epsilon;
-        modelDown.spot = spot - epsilon;
+// Mthode pour calculer le prix par Monte-Carlo en utilisant la maturit par dfaut
+double AsianOption::price(const BlackScholesModel& model, int numPaths, int steps, const PricingContext& context) const {
+    return this->price(model, numPaths, steps, maturity, context); // Appelle la version surcharge avec la maturit par dfaut
+}
 
-        priceUp = this->price(modelUp, numPaths, steps - i);
-        priceDown = this->price(modelDown, numPaths, steps - i);
+// Mthode pour calculer le prix par Monte-Carlo en permettant une maturit ajuste
+double AsianOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity,
+                  const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, adjustedMaturity, SimulationPrecision::Double, rng).price;
+}
 
-        delta = (priceUp - priceDown) / (2 * epsilon); // Nouveau delta
+// Delta de couverture tir de l'option de maturit complte
+double AsianOption::hedgeHorizon(double) const {
+    return maturity;
+}
 
-        // Ajustement du portefeuille
-        cash += (delta - previousDelta) * spot; // Ajustement en fonction du changement de delta
-        cash *= std::exp(model.rate * dt); // Actualisation du cash
+// Moyenne de toutes les dates couvertes, prix initial compris
+double AsianOption::hedgePayoff(const PathView& path) const {
+    double sum = 0.0;
+    for (int j = 0; j < path.size(); ++j) {
+        sum += path[j];
     }
+    double average = sum / path.size(); // Moyenne arithmtique
+    if (optionType == OptionType::Call) {
+        return std::max(average - strike, 0.0); // Payoff pour un call
+    } else { // OptionType::Put
+        return std::max(strike - average, 0.0); // Payoff pour un put
+    }
+}
 
-    // Retourner le cot total de rplication en soustrayant le payoff
-    return cash - delta * spot + payoff(path); // Cot total ajust par le payoff final
+// Cl de cache du produit
+void AsianOption::appendKey(PricingKey& key) const {
+    key.add("AsianOption");
+    Option::appendKey(key);
+    key.add(static_cast<long long>(optionType));
 }
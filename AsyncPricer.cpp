@@ -0,0 +1,75 @@
+#include "AsyncPricer.h"
+#include "DeltaHedge.h"       // Couverture interruptible
+#include "ExoticOption.h"
+#include "MonteCarloEngine.h" // Sommes des payoffs par morceau
+#include <algorithm>          // Pour std::min
+#include <limits>             // Pour std::numeric_limits
+#include <random>             // Pour std::mt19937
+#include <stdexcept>          // Pour std::invalid_argument
+
+// Constructeur
+AsyncPricer::AsyncPricer(ThreadPool& pool_, int chunkPaths_) : pool(pool_), chunkPaths(chunkPaths_) {
+    if (chunkPaths <= 0) {
+        throw std::invalid_argument("AsyncPricer chunk size must be positive.");
+    }
+}
+
+// Raison de l'arrt, ou Completed si le calcul peut continuer
+static PricingStatus stopStatus(const CancellationToken& token, AsyncPricer::Clock::time_point deadline) {
+    if (token.isCancelled()) return PricingStatus::Cancelled;
+    if (AsyncPricer::Clock::now() >= deadline) return PricingStatus::DeadlineReached;
+    return PricingStatus::Completed;
+}
+
+// Morceaux successifs sur le gnrateur du contexte ; arrt coopratif entre deux morceaux
+std::future<AsyncPricingResult> AsyncPricer::price(const ExoticOption& option, const BlackScholesModel& model,
+                                                   int numPaths, int steps, const PricingContext& context,
+                                                   CancellationToken token, Clock::time_point deadline,
+                                                   SimulationPrecision precision) const {
+    const int chunk = chunkPaths;
+    return pool.submit([&option, model, numPaths, steps, context, token, deadline, precision, chunk]() {
+        std::mt19937 rng = context.generator(); // Mme flux que le prix synchrone
+        PayoffSums sums{0.0, 0.0, 0, 1.0};
+        PricingStatus status = PricingStatus::Completed;
+        for (int first = 0; first < numPaths; first += chunk) {
+            status = stopStatus(token, deadline);
+            if (status != PricingStatus::Completed) break;
+            MonteCarloEngine::accumulate(option, model, std::min(chunk, numPaths - first), steps,
+                                         option.maturity, precision, rng, sums);
+        }
+
+        AsyncPricingResult result;
+        if (sums.numPaths > 0) {
+            MonteCarloResult estimate = sums.result();
+            result.price = estimate.price;
+            result.standardError = estimate.standardError;
+        } else {
+            result.price = std::numeric_limits<double>::quiet_NaN();
+            result.standardError = std::numeric_limits<double>::infinity();
+        }
+        result.numPaths = static_cast<int>(sums.numPaths);
+        result.status = status;
+        return result;
+    });
+}
+
+// Couverture pas par pas pour une exotique ; arrt coopratif entre deux pas
+std::future<AsyncHedgeResult> AsyncPricer::hedgeCost(const Option& option, const BlackScholesModel& model, int steps,
+                                                     const PricingContext& context, CancellationToken token,
+                                                     Clock::time_point deadline) const {
+    return pool.submit([&option, model, steps, context, token, deadline]() {
+        PricingStatus status = stopStatus(token, deadline);
+        if (const ExoticOption* exotic = dynamic_cast<const ExoticOption*>(&option)) {
+            HedgeResult hedge = DeltaHedge(*exotic, model, steps, context).run(nullptr, 1, [&]() {
+                status = stopStatus(token, deadline);
+                return status != PricingStatus::Completed;
+            });
+            return AsyncHedgeResult{hedge.cost, hedge.standardError, hedge.deltaSteps, status};
+        }
+        if (status != PricingStatus::Completed) {
+            return AsyncHedgeResult{std::numeric_limits<double>::quiet_NaN(),
+                                    std::numeric_limits<double>::infinity(), 0, status};
+        }
+        return AsyncHedgeResult{option.hedgeCost(model, steps, context), 0.0, steps, status}; // Deltas exacts
+    });
+}
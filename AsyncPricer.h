@@ -0,0 +1,70 @@
+#ifndef ASYNC_PRICER_H
+#define ASYNC_PRICER_H
+
+#include "BlackScholesModel.h"
+#include "CancellationToken.h"
+#include "PricingContext.h"
+#include "SimulationPrecision.h"
+#include "ThreadPool.h"
+#include <chrono> // Pour les chances
+#include <future> // Pour std::future
+
+class ExoticOption;
+class Option;
+
+// Issue d'une demande de prix asynchrone
+enum class PricingStatus { Completed, Cancelled, DeadlineReached };
+
+// Prix rendu par AsyncPricer : estimation sur les trajectoires effectivement simules
+struct AsyncPricingResult {
+    double price;         // Prix actualis estim (NaN si aucune trajectoire n'a t simule)
+    double standardError; // Erreur standard de l'estimation
+    int numPaths;         // Trajectoires simules (numPaths demand si status == Completed)
+    PricingStatus status; // Termin, annul ou interrompu par l'chance
+};
+
+// Cot de rplication rendu par AsyncPricer : couverture rajuste aux pas dont le delta a t calcul
+struct AsyncHedgeResult {
+    double cost;          // Cot de rplication estim (NaN si aucun delta n'a t calcul)
+    double standardError; // Erreur standard due au bruit Monte-Carlo des deltas
+    int deltaSteps;       // Pas dont le delta a t calcul (steps si status == Completed)
+    PricingStatus status; // Termin, annul ou interrompu par l'chance
+};
+
+// Soumission de calculs de prix sans bloquer l'appelant
+//
+// Chaque demande est excute sur un thread du ThreadPool. Un prix est simul par morceaux de
+// chunkPaths trajectoires, une couverture pas par pas ; entre deux morceaux ou deux pas, le calcul
+// consulte le jeton d'annulation et l'chance et, s'il doit s'arrter, rend l'estimation obtenue
+// sur ce qui a dj t calcul, avec son erreur standard. Les morceaux successifs tirent leurs
+// trajectoires du mme gnrateur, celui de context : un prix men  terme est identique, bit 
+// bit,  ExoticOption::price avec le mme contexte et la mme prcision, et une couverture mene 
+// terme  hedgeCost. L'option rfrence doit rester valide jusqu' la fin du calcul ; le modle et
+// le contexte sont copis.
+class AsyncPricer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Constructeur : groupe de threads utilis et taille des morceaux
+    explicit AsyncPricer(ThreadPool& pool_ = ThreadPool::shared(), int chunkPaths_ = 4096);
+
+    // Prix Monte-Carlo d'une option exotique
+    std::future<AsyncPricingResult> price(const ExoticOption& option, const BlackScholesModel& model,
+                                          int numPaths, int steps, const PricingContext& context,
+                                          CancellationToken token = CancellationToken(),
+                                          Clock::time_point deadline = Clock::time_point::max(),
+                                          SimulationPrecision precision = SimulationPrecision::Double) const;
+
+    // Cot de rplication ; une option exotique est couverte pas par pas (DeltaHedge), les autres
+    // options (deltas analytiques) d'un seul tenant, l'arrt n'tant alors consult qu'au dmarrage
+    std::future<AsyncHedgeResult> hedgeCost(const Option& option, const BlackScholesModel& model, int steps,
+                                            const PricingContext& context,
+                                            CancellationToken token = CancellationToken(),
+                                            Clock::time_point deadline = Clock::time_point::max()) const;
+
+private:
+    ThreadPool& pool;
+    int chunkPaths;
+};
+
+#endif // ASYNC_PRICER_H
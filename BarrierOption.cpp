@@ -1,5 +1,7 @@
 #include "BarrierOption.h"
-#include <random>       // Pour std::mt19937 et std::normal_distribution (gnration de nombres alatoires)
+#include "MonteCarloEngine.h" // Moteur Monte-Carlo commun (simulation des trajectoires)
+#include "PricingKey.h" // Cl de cache
+#include <random>       // Pour std::mt19937
 #include <algorithm>    // Pour std::max et std::min
 #include <cmath>        // Pour std::exp
 #include <iostream>     // Pour le dbogage avec std::cout
@@ -18,13 +20,71 @@ double BarrierOption::payoff(double spot) const {
     }
 }
 
+// Payoff sur une trajectoire complte : payoff vanille conditionn par l'tat de la barrire
+template <typename T>
+double BarrierOption::pathPayoff(const BasicPathView<T>& path) const {
+    bool touched = isBarrierTouched(path); // Vrification si la barrire est franchie
+
+    if ((barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut) && touched) {
+        return 0.0; // Option invalide si barrire franchie
+    } else if ((barrierType == BarrierType::UpAndIn || barrierType == BarrierType::DownAndIn) && !touched) {
+        return 0.0; // Option inexistante si barrire non franchie
+    } else {
+        return payoff(path.back()); // Payoff bas sur le prix final
+    }
+}
+
+double BarrierOption::payoff(const PathView& path) const {
+    return pathPayoff(path);
+}
+
+double BarrierOption::payoff(const PathViewF& path) const {
+    return pathPayoff(path);
+}
+
+// Payoff diffrentiable (AAD)
+// La probabilit de survie est le produit des poids 1 - rampe(distance  la barrire) sur les dates
+// simules ; elle concide avec l'indicatrice non lisse ds que le prix initial est du bon ct
+// de la barrire et que smoothing tend vers 0. Seules les dates proches de la barrire crent des noeuds
+ADouble BarrierOption::payoff(const PathViewAD& path, double smoothing) const {
+    double width = smoothing * barrier; // Largeur de la rampe en units de prix
+    bool upBarrier = (barrierType == BarrierType::UpAndOut || barrierType == BarrierType::UpAndIn);
+
+    ADouble alive = 1.0; // Poids de survie (1 : barrire jamais approche)
+    for (int i = 1; i < path.size(); ++i) {
+        double distance = upBarrier ? path[i].value - barrier : barrier - path[i].value;
+        if (distance <= -0.5 * width) continue; // Loin de la barrire : poids 1
+        if (distance >= 0.5 * width) {           // Franchissement certain : poids 0
+            alive = 0.0;
+            break;
+        }
+        ADouble signedDistance = upBarrier ? path[i] - barrier : barrier - path[i];
+        alive = alive * (1.0 - smoothStep(signedDistance, width));
+    }
+
+    ADouble spot = path.back();
+    ADouble vanilla = (optionType == OptionType::Call) ? max(spot - strike, 0.0) : max(strike - spot, 0.0);
+    if (barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut) {
+        return vanilla * alive; // Option dsactive si la barrire est franchie
+    } else {
+        return vanilla * (1.0 - alive); // Option active si la barrire est franchie
+    }
+}
+
 // Mthode pour vrifier si la barrire a t franchie durant la trajectoire
 bool BarrierOption::isBarrierTouched(const std::vector<double>& path) const {
+    return isBarrierTouched(PathView(path.data(), static_cast<int>(path.size())));
+}
+
+// Mme vrification sur une vue de trajectoire (double ou float)
+template <typename T>
+bool BarrierOption::isBarrierTouched(const BasicPathView<T>& path) const {
+    int size = path.size();
     switch (barrierType) {
         case BarrierType::UpAndOut:
         case BarrierType::UpAndIn:
             // Vrifie s'il y a un franchissement  la hausse
-            for (size_t i = 1; i < path.size(); ++i) {
+            for (int i = 1; i < size; ++i) {
                 if (path[i - 1] < barrier && path[i] >= barrier) {
                     return true; // Franchissement  la hausse dtect
                 }
@@ -34,7 +94,7 @@ bool BarrierOption::isBarrierTouched(const std::vector<double>& path) const {
         case BarrierType::DownAndOut:
         case BarrierType::DownAndIn:
             // Vrifie s'il y a un franchissement  la baisse
-            for (size_t i = 1; i < path.size(); ++i) {
+            for (int i = 1; i < size; ++i) {
                 if (path[i - 1] > barrier && path[i] <= barrier) {
                     return true; // Franchissement  la baisse dtect
                 }
@@ -47,105 +107,26 @@ bool BarrierOption::isBarrierTouched(const std::vector<double>& path) const {
 }
 
 // Mthode pour calculer le prix en utilisant la maturit par dfaut
-double BarrierOption::price(const BlackScholesModel& model, int numPaths, int steps) const {
-    return this->price(model, numPaths, steps, maturity); // Appelle la mthode surcharge avec la maturit par dfaut
+double BarrierOption::price(const BlackScholesModel& model, int numPaths, int steps, const PricingContext& context) const {
+    return this->price(model, numPaths, steps, maturity, context); // Appelle la mthode surcharge avec la maturit par dfaut
 }
 
 // Mthode pour calculer le prix en utilisant une maturit ajuste
-double BarrierOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity) const {
-    double sumPayoffs = 0.0; // Somme des payoffs
-    double dt = adjustedMaturity / steps; // Pas temporel
-
-    std::mt19937 rng(std::random_device{}()); // Gnrateur alatoire avec graine dynamique
-    std::normal_distribution<> dist(0.0, 1.0); // Distribution normale standard
-
-    for (int i = 0; i < numPaths; ++i) {
-        double spot = model.spot; // Prix initial du sous-jacent
-        std::vector<double> path; // Chemin pour stocker les prix simuls
-        path.reserve(steps); // Prallocation mmoire
-
-        // Simulation de la trajectoire
-        for (int j = 0; j < steps; ++j) {
-            double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-            double diffusion = model.volatility * std::sqrt(dt) * dist(rng);
-            spot *= std::exp(drift + diffusion);
-            path.push_back(spot);
-        }
-
-        // Vrification si la barrire est franchie
-        bool touched = isBarrierTouched(path);
-
-        if ((barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut) && touched) {
-            sumPayoffs += 0.0; // Option invalide si barrire franchie
-        } else if ((barrierType == BarrierType::UpAndIn || barrierType == BarrierType::DownAndIn) && !touched) {
-            sumPayoffs += 0.0; // Option inexistante si barrire non franchie
-        } else {
-            sumPayoffs += payoff(path.back()); // Payoff bas sur le prix final
-        }
-    }
-
-    return std::exp(-model.rate * adjustedMaturity) * (sumPayoffs / numPaths); // Actualisation et moyenne des payoffs
+double BarrierOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity,
+                  const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, adjustedMaturity, SimulationPrecision::Double, rng).price;
 }
 
-// Mthode pour calculer le cot de rplication en utilisant la stratgie de delta hedging
-double BarrierOption::hedgeCost(const BlackScholesModel& model, int steps) const {
-    int numPaths = 10000; // Nombre de trajectoires pour les calculs Monte-Carlo
-    double epsilon = 0.01 * model.spot; // Variation pour les diffrences finies
-
-    // Initialisation du delta
-    BlackScholesModel modelUp = model;
-    modelUp.spot += epsilon; // Spot augment
-    double priceUp = this->price(modelUp, numPaths, steps);
-
-    BlackScholesModel modelDown = model;
-    modelDown.spot -= epsilon; // Spot diminu
-    double priceDown = this->price(modelDown, numPaths, steps);
-
-    double previousDelta = 0;
-    double delta = (priceUp - priceDown) / (2 * epsilon); // Calcul du delta initial
-
-    // Rplication dynamique
-    double dt = maturity / steps; // Pas temporel
-    double spot = model.spot; // Prix initial
-    double cash = delta * spot; // Portefeuille initial
-
-    std::vector<double> path; // Chemin des prix simuls
-    path.push_back(spot); // Ajout du prix initial
-    bool barrierTouched = isBarrierTouched(path); // Vrification initiale de la barrire
-
-    for (int i = 1; i < steps; ++i) {
-        double adjustedMaturity = maturity - i * dt; // Maturit ajuste
-
-        // Simulation du prix du sous-jacent
-        double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-        double diffusion = model.volatility * std::sqrt(dt) * ((double)rand() / RAND_MAX - 0.5);
-        spot *= std::exp(drift + diffusion);
-        path.push_back(spot); // Enregistrement du prix actuel
-        barrierTouched = isBarrierTouched(path); // Mise  jour de l'tat de la barrire
-
-        previousDelta = delta;
-
-        if (barrierTouched) {
-            delta = 0; // Si barrire franchie, delta devient nul
-        } else {
-            modelUp.spot = spot + epsilon;
-            modelDown.spot = spot - epsilon;
-            priceUp = this->price(modelUp, numPaths, steps - i, adjustedMaturity);
-            priceDown = this->price(modelDown, numPaths, steps - i, adjustedMaturity);
-            delta = (priceUp - priceDown) / (2 * epsilon); // Mise  jour du delta
-        }
-
-        cash += (delta - previousDelta) * spot; // Ajustement du portefeuille
-        cash *= std::exp(model.rate * dt); // Actualisation
-    }
-
-    // Calcul final du cot de rplication
-    double finalPayoff = payoff(spot);
-    if ((barrierType == BarrierType::UpAndIn || barrierType == BarrierType::DownAndIn) && barrierTouched) {
-        cash += finalPayoff;
-    } else if ((barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut) && !barrierTouched) {
-        cash += finalPayoff;
-    }
+// Dsactivation : barrire franchie pour une option knock-out (une knock-in active reste couverte)
+bool BarrierOption::hedgeKnockedOut(const PathView& path) const {
+    return (barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut) &&
+           isBarrierTouched(path);
+}
 
-    return cash - delta * spot; // Cot total ajust
+// Cl de cache du produit
+void BarrierOption::appendKey(PricingKey& key) const {
+    key.add("BarrierOption");
+    Option::appendKey(key);
+    key.add(barrier).add(static_cast<long long>(barrierType)).add(static_cast<long long>(optionType));
 }
@@ -17,21 +17,48 @@ public:
     BarrierOption(double strike_, double maturity_, double barrier_, BarrierType barrierType_, OptionType optionType_);
 
     // Mthode pour le payoff
-    double payoff(double spot) const;
+    double payoff(double spot) const override;
 
+    // Payoff sur une vue de trajectoire (prix initial en position 0), barrire comprise
+    double payoff(const PathView& path) const override;
+    double payoff(const PathViewF& path) const override;
+
+    // Payoff diffrentiable (AAD) : l'indicatrice de franchissement est remplace par une rampe
+    // de largeur smoothing * barrier pour que le delta et le vega restent informatifs
+    ADouble payoff(const PathViewAD& path, double smoothing) const override;
 
     // Mthode de pricing Monte-Carlo que l'on va utiliser en cas de maturit constante
-    double price(const BlackScholesModel& model, int numPaths, int steps) const override;
+    double price(const BlackScholesModel& model, int numPaths, int steps,
+                 const PricingContext& context) const override;
 
     // Surcharge de la mthode ci-dessus permettant de prendre en argument la maturit (utile pour calculer le delta)
-    double price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity) const;
+    double price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity,
+                 const PricingContext& context = PricingContext::fromEntropy()) const;
+
+
+    // Cl de cache : nom du produit, strike, maturit, barrire, type de barrire et type
+    void appendKey(PricingKey& key) const override;
+
+    // Rend visibles les surcharges de ExoticOption (sans contexte, choix de la prcision, autres modles)
+    using ExoticOption::price;
 
-    // Mthode pour calculer le cot de rplication
-    double hedgeCost(const BlackScholesModel& model, int steps) const override;
+    // Rend visibles les couvertures de ExoticOption (sans contexte, reprenable)
+    using ExoticOption::hedgeCost;
+
+    // Couverture : une option dsactivante dont la barrire est franchie n'est plus couverte
+    bool hedgeKnockedOut(const PathView& path) const override;
 
 private:
     // Vrifie si la barrire est franchie
     bool isBarrierTouched(const std::vector<double>& path) const;
+
+    // Mme vrification sur une vue de trajectoire (double ou float)
+    template <typename T>
+    bool isBarrierTouched(const BasicPathView<T>& path) const;
+
+    // Implmentation commune des payoffs sur vues double et float
+    template <typename T>
+    double pathPayoff(const BasicPathView<T>& path) const;
 };
 
 #endif // BARRIER_OPTION_H
@@ -0,0 +1,10 @@
+#ifndef BASKET_TYPE_H
+#define BASKET_TYPE_H
+
+// Agrgation des sous-jacents d'une option multi-actifs en une seule trajectoire
+// Basket  : somme pondre sum_a w_a S_a
+// Spread  : w_0 S_0 - w_1 S_1 (deux actifs)
+// WorstOf : min_a w_a S_a (avec w_a = 1 / S_a(0), performance du plus mauvais actif)
+enum class BasketType { Basket, Spread, WorstOf };
+
+#endif // BASKET_TYPE_H
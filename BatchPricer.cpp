@@ -0,0 +1,371 @@
+#include "BatchPricer.h"
+#include "AsianOption.h"
+#include "CallOption.h"
+#include "LookbackOption.h"
+#include "MonteCarloEngine.h" // Prix Monte-Carlo des exotiques
+#include "Parallel.h"         // Pour parallelFor et defaultThreadCount
+#include "PricingKey.h"       // Hash stable des identifiants
+#include "PutOption.h"
+#include "ResultSink.h"       // criture des fichiers de rsultats
+#include <algorithm>          // Pour std::sort, std::count, std::min et std::max
+#include <cerrno>             // Pour errno
+#include <charconv>           // Pour std::from_chars
+#include <cmath>              // Pour std::isfinite
+#include <cstdio>             // Pour std::remove
+#include <cstring>            // Pour std::strerror
+#include <fstream>            // Pour std::ifstream et std::ofstream
+#include <limits>             // Pour NaN
+#include <memory>             // Pour std::unique_ptr
+#include <random>             // Pour std::mt19937 et std::seed_seq
+#include <sstream>            // Pour std::istringstream
+#include <stdexcept>          // Pour std::invalid_argument et std::runtime_error
+#include <sys/wait.h>         // Pour waitpid
+#include <unistd.h>           // Pour fork et execvp
+
+static bool parseOptionType(const std::string& text, OptionType& type) {
+    if (text == "call") type = OptionType::Call;
+    else if (text == "put") type = OptionType::Put;
+    else return false;
+    return true;
+}
+
+static bool parseBarrierType(const std::string& text, BarrierType& type) {
+    if (text == "upout") type = BarrierType::UpAndOut;
+    else if (text == "upin") type = BarrierType::UpAndIn;
+    else if (text == "downout") type = BarrierType::DownAndOut;
+    else if (text == "downin") type = BarrierType::DownAndIn;
+    else return false;
+    return true;
+}
+
+// Lecture d'une transaction (aprs l'identifiant) ; rend false si la ligne est mal forme
+static bool parseTrade(std::istringstream& fields, const std::string& product, TradeRecord& trade) {
+    std::string type;
+    trade.optionType = OptionType::Call;
+    trade.barrierType = BarrierType::UpAndOut;
+    trade.barrier = 0.0;
+    if (product == "call" || product == "put") {
+        trade.product = product == "call" ? ProductKind::Call : ProductKind::Put;
+        return static_cast<bool>(fields >> trade.strike >> trade.maturity);
+    }
+    if (product == "asian" || product == "lookback") {
+        trade.product = product == "asian" ? ProductKind::Asian : ProductKind::Lookback;
+        return (fields >> type) && parseOptionType(type, trade.optionType) && (fields >> trade.strike >> trade.maturity);
+    }
+    if (product == "barrier") {
+        std::string barrierType;
+        trade.product = ProductKind::Barrier;
+        return (fields >> type) && parseOptionType(type, trade.optionType) &&
+               (fields >> trade.strike >> trade.maturity >> trade.barrier >> barrierType) &&
+               parseBarrierType(barrierType, trade.barrierType);
+    }
+    return false;
+}
+
+TradeBook BatchPricer::loadTrades(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open trade file " + filename + ".");
+    }
+    double spot = 0.0, rate = 0.0, volatility = 0.0, dividend = 0.0;
+    int numPaths = 0, steps = 0;
+    unsigned seed = 0;
+    bool hasModel = false, hasEngine = false;
+    std::vector<TradeRecord> trades;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream fields(line);
+        std::string first, second, rest;
+        if (!(fields >> first)) continue; // Ligne vide
+
+        bool valid;
+        if (first == "model") {
+            valid = static_cast<bool>(fields >> spot >> rate >> volatility >> dividend);
+            hasModel = true;
+        } else if (first == "engine") {
+            valid = (fields >> numPaths >> steps >> seed) && numPaths > 0 && steps > 0;
+            hasEngine = true;
+        } else {
+            TradeRecord trade;
+            trade.id = first;
+            valid = (fields >> second) && parseTrade(fields, second, trade) && trade.maturity > 0.0;
+            trades.push_back(trade);
+        }
+        if (!valid || (fields >> rest)) {
+            throw std::invalid_argument("Malformed line " + std::to_string(lineNumber) + " of " + filename + ".");
+        }
+    }
+    if (!hasModel || !hasEngine) {
+        throw std::invalid_argument("Trade file " + filename + " requires a model line and an engine line.");
+    }
+    return TradeBook{BlackScholesModel(spot, rate, volatility, dividend), numPaths, steps, seed, trades};
+}
+
+unsigned BatchPricer::tradeSeed(unsigned seed, const std::string& id) {
+    std::uint64_t hash = PricingKey().add(id.c_str()).hash();
+    std::seed_seq sequence{seed, static_cast<unsigned>(hash), static_cast<unsigned>(hash >> 32)};
+    unsigned result;
+    sequence.generate(&result, &result + 1);
+    return result;
+}
+
+// Prix d'une transaction
+static TradeResult computeTrade(const TradeBook& book, long long index) {
+    const TradeRecord& trade = book.trades[index];
+    TradeResult result{index, trade.id, 0.0, 0.0, TradeStatus::Ok};
+    if (trade.product == ProductKind::Call) {
+        CallOption option(trade.strike, trade.maturity);
+        result.price = book.model.priceAnalytic(&option, true);
+        return result;
+    }
+    if (trade.product == ProductKind::Put) {
+        PutOption option(trade.strike, trade.maturity);
+        result.price = book.model.priceAnalytic(&option, false);
+        return result;
+    }
+
+    std::unique_ptr<ExoticOption> option;
+    if (trade.product == ProductKind::Asian) {
+        option.reset(new AsianOption(trade.strike, trade.maturity, trade.optionType));
+    } else if (trade.product == ProductKind::Lookback) {
+        option.reset(new LookbackOption(trade.strike, trade.maturity, trade.optionType));
+    } else {
+        option.reset(new BarrierOption(trade.strike, trade.maturity, trade.barrier, trade.barrierType, trade.optionType));
+    }
+    std::mt19937 rng(BatchPricer::tradeSeed(book.seed, trade.id));
+    MonteCarloResult estimate = MonteCarloEngine::run(*option, book.model, book.numPaths, book.steps,
+                                                      trade.maturity, SimulationPrecision::Double, rng);
+    result.price = estimate.price;
+    result.standardError = estimate.standardError;
+    return result;
+}
+
+// Prix d'une transaction ; un chec ne concerne qu'elle
+static TradeResult priceTrade(const TradeBook& book, long long index) {
+    TradeResult result;
+    try {
+        result = computeTrade(book, index);
+    } catch (const std::exception&) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result = TradeResult{index, book.trades[index].id, nan, nan, TradeStatus::Error};
+    }
+    if (!std::isfinite(result.price)) result.status = TradeStatus::Error;
+    return result;
+}
+
+// Nombre de transactions du lot shard
+static std::size_t shardSize(const TradeBook& book, int shard, int numShards) {
+    if (numShards <= 0 || shard < 0 || shard >= numShards) {
+        throw std::invalid_argument("BatchPricer::priceShard requires 0 <= shard < numShards.");
+    }
+    const std::size_t total = book.trades.size();
+    return total > static_cast<std::size_t>(shard) ? (total - shard + numShards - 1) / numShards : 0;
+}
+
+// Transactions [first, first + results.size()) du lot shard, en parallle
+static void priceRange(const TradeBook& book, int shard, int numShards, std::size_t first,
+                       std::vector<TradeResult>& results, unsigned numThreads) {
+    parallelFor(results.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            results[k] = priceTrade(book, shard + static_cast<long long>(first + k) * numShards);
+        }
+    }, numThreads);
+}
+
+std::vector<TradeResult> BatchPricer::priceShard(const TradeBook& book, int shard, int numShards, unsigned numThreads) {
+    std::vector<TradeResult> results(shardSize(book, shard, numShards));
+    priceRange(book, shard, numShards, 0, results, numThreads);
+    return results;
+}
+
+void BatchPricer::priceShard(const TradeBook& book, int shard, int numShards, ResultSink& sink, unsigned numThreads) {
+    const std::size_t count = shardSize(book, shard, numShards);
+    std::vector<TradeResult> chunk;
+    for (std::size_t first = 0; first < count; first += STREAM_TRADES) {
+        chunk.resize(std::min<std::size_t>(STREAM_TRADES, count - first));
+        priceRange(book, shard, numShards, first, chunk, numThreads);
+        sink.write(chunk);
+    }
+}
+
+void BatchPricer::writeShard(const TradeBook& book, int shard, int numShards, const std::string& filename,
+                             unsigned numThreads) {
+    std::unique_ptr<ResultSink> sink = ResultSink::open(filename, true); // criture pendant le calcul
+    priceShard(book, shard, numShards, *sink, numThreads);
+    sink->close();
+}
+
+void BatchPricer::writeResults(const std::string& filename, const std::vector<TradeResult>& results) {
+    std::unique_ptr<ResultSink> sink = ResultSink::open(filename, true); // Formatage et criture en parallle
+    sink->write(results);
+    sink->close();
+}
+
+// Nombre occupant exactement [begin, end) (nan et inf compris pour un double)
+template <typename T>
+static bool parseNumber(const char* begin, const char* end, T& value) {
+    std::from_chars_result parsed = std::from_chars(begin, end, value);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+// Champs d'un enregistrement CSV spars par des virgules ; un champ entre guillemets peut contenir
+// virgules et sauts de ligne, et "" y reprsente un guillemet. Rend false si les guillemets sont mal placs
+static bool splitRecord(const std::string& record, std::vector<std::string>& fields) {
+    fields.assign(1, std::string());
+    std::size_t i = 0;
+    while (i < record.size()) {
+        if (record[i] == '"' && fields.back().empty()) { // Champ entre guillemets
+            for (++i; ; ++i) {
+                if (i == record.size()) return false;
+                if (record[i] == '"') {
+                    if (i + 1 < record.size() && record[i + 1] == '"') {
+                        ++i;
+                    } else {
+                        break;
+                    }
+                }
+                fields.back() += record[i];
+            }
+            ++i;
+            if (i < record.size() && record[i] != ',') return false;
+        } else if (record[i] == '"') {
+            return false;
+        } else if (record[i] != ',') {
+            fields.back() += record[i++];
+            continue;
+        }
+        if (i < record.size()) { // Virgule
+            fields.emplace_back();
+            ++i;
+        }
+    }
+    return true;
+}
+
+// Enregistrement "index,id,status,price,standard_error" ; rend false s'il est mal form
+static bool parseResult(const std::string& record, TradeResult& result) {
+    std::vector<std::string> fields;
+    if (!splitRecord(record, fields) || fields.size() != 5) return false;
+    const std::string& status = fields[2];
+    if (status == "ok") result.status = TradeStatus::Ok;
+    else if (status == "error") result.status = TradeStatus::Error;
+    else return false;
+    result.id = fields[1];
+    return parseNumber(fields[0].data(), fields[0].data() + fields[0].size(), result.index) &&
+           parseNumber(fields[3].data(), fields[3].data() + fields[3].size(), result.price) &&
+           parseNumber(fields[4].data(), fields[4].data() + fields[4].size(), result.standardError);
+}
+
+std::vector<TradeResult> BatchPricer::readResults(const std::string& filename) {
+    if (ResultSink::isColumnar(filename)) return ColumnarResultSink::read(filename);
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open result file " + filename + ".");
+    }
+    std::vector<TradeResult> results;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        if (++lineNumber == 1) continue; // En-tte
+        const int firstLine = lineNumber;
+        // Un saut de ligne entre guillemets (nombre impair de guillemets) prolonge l'enregistrement
+        std::string record = line;
+        while (std::count(record.begin(), record.end(), '"') % 2 != 0 && std::getline(file, line)) {
+            ++lineNumber;
+            record += '\n';
+            record += line;
+        }
+        TradeResult result;
+        if (!parseResult(record, result)) {
+            throw std::invalid_argument("Malformed result at line " + std::to_string(firstLine) + " of " + filename + ".");
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+void BatchPricer::merge(const std::vector<std::string>& shardFiles, const std::string& outputFile) {
+    std::vector<TradeResult> results;
+    for (const std::string& shardFile : shardFiles) {
+        std::vector<TradeResult> shardResults = readResults(shardFile);
+        results.insert(results.end(), shardResults.begin(), shardResults.end());
+    }
+    std::sort(results.begin(), results.end(),
+              [](const TradeResult& a, const TradeResult& b) { return a.index < b.index; });
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        if (results[i].index != static_cast<long long>(i)) {
+            throw std::invalid_argument("Shard results are missing or duplicate trade " + std::to_string(i) + ".");
+        }
+    }
+    writeResults(outputFile, results);
+}
+
+void BatchPricer::runSharded(const std::string& executable, const std::string& tradeFile,
+                             const std::string& outputFile, int numShards) {
+    if (numShards <= 0) {
+        throw std::invalid_argument("BatchPricer::runSharded requires at least one shard.");
+    }
+    loadTrades(tradeFile); // Fichier vrifi une fois avant de lancer les processus
+
+    // Coeurs partags entre les processus
+    const std::string threads = std::to_string(std::max(1u, defaultThreadCount() / numShards));
+    std::vector<std::string> shardFiles;
+    for (int shard = 0; shard < numShards; ++shard) {
+        shardFiles.push_back(outputFile + ".shard" + std::to_string(shard) + (ResultSink::isColumnar(outputFile) ? ".col" : ""));
+    }
+    auto removeShards = [&shardFiles]() {
+        for (const std::string& shardFile : shardFiles) std::remove(shardFile.c_str());
+    };
+
+    // Arguments de tous les processus prpars avant fork : d'autres threads peuvent dj tourner,
+    // le fils ne doit qu'appeler execvp ou _exit (aucune allocation)
+    std::vector<std::vector<std::string> > args(numShards);
+    std::vector<std::vector<char*> > argvs(numShards);
+    for (int shard = 0; shard < numShards; ++shard) {
+        args[shard] = {executable, "--shard", tradeFile, std::to_string(shard),
+                       std::to_string(numShards), shardFiles[shard], threads};
+        for (std::string& arg : args[shard]) argvs[shard].push_back(&arg[0]);
+        argvs[shard].push_back(nullptr);
+    }
+
+    std::vector<pid_t> workers;
+    for (int shard = 0; shard < numShards; ++shard) {
+        char* const* argv = argvs[shard].data();
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            ::execvp(argv[0], argv);
+            ::_exit(127); // exec impossible
+        }
+        if (pid < 0) {
+            std::string reason = std::strerror(errno);
+            for (pid_t worker : workers) ::waitpid(worker, nullptr, 0);
+            removeShards();
+            throw std::runtime_error("Cannot launch shard worker: " + reason);
+        }
+        workers.push_back(pid);
+    }
+
+    int failed = -1;
+    for (int shard = 0; shard < numShards; ++shard) {
+        int status = 0;
+        if (::waitpid(workers[shard], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if (failed < 0) failed = shard;
+        }
+    }
+    if (failed >= 0) {
+        removeShards(); // Rsultats partiels des autres lots
+        throw std::runtime_error("Shard worker " + std::to_string(failed) + " failed.");
+    }
+    try {
+        merge(shardFiles, outputFile);
+    } catch (...) {
+        removeShards();
+        throw;
+    }
+    removeShards();
+}
@@ -0,0 +1,107 @@
+#ifndef BATCH_PRICER_H
+#define BATCH_PRICER_H
+
+#include "BlackScholesModel.h"
+#include "PricingProtocol.h" // Pour ProductKind
+#include <cstdint>           // Pour std::uint8_t
+#include <string>            // Pour les identifiants et les noms de fichiers
+#include <vector>            // Pour les transactions et les rsultats
+
+class ResultSink;
+
+// Transaction lue dans un fichier de transactions
+struct TradeRecord {
+    std::string id;          // Identifiant (sans espace), dtermine la graine de la transaction
+    ProductKind product;
+    OptionType optionType;   // Asian, Barrier, Lookback
+    BarrierType barrierType; // Barrier
+    double strike;
+    double maturity;
+    double barrier;          // Barrier
+};
+
+// Fichier de transactions : modle, rglages Monte-Carlo et transactions
+struct TradeBook {
+    BlackScholesModel model;
+    int numPaths;
+    int steps;
+    unsigned seed;
+    std::vector<TradeRecord> trades;
+};
+
+// Issue du calcul d'une transaction
+enum class TradeStatus : std::uint8_t {
+    Ok,   // Prix calcul
+    Error // Calcul impossible (exception) ou prix non fini ; price et standardError sans signification
+};
+
+// Rsultat d'une transaction ; index est sa position dans le fichier de transactions
+struct TradeResult {
+    long long index;
+    std::string id;
+    double price;
+    double standardError; // 0 pour un prix analytique
+    TradeStatus status;
+};
+
+// Pricing d'un fichier de transactions, ventuellement rparti sur plusieurs processus
+//
+// Format du fichier (champs spars par des espaces, '#' commence un commentaire) :
+//   model  <spot> <rate> <volatility> <dividend>
+//   engine <numPaths> <steps> <seed>
+//   <id> call|put <strike> <maturity>
+//   <id> asian|lookback call|put <strike> <maturity>
+//   <id> barrier call|put <strike> <maturity> <barrier> upout|upin|downout|downin
+//
+// Chaque exotique est simule avec un gnrateur initialis par (seed, hash de son identifiant) :
+// son prix ne dpend ni de sa position, ni du dcoupage en lots, ni du nombre de threads. Le lot
+// shard sur numShards contient les transactions d'indice i tel que i % numShards == shard ; chaque
+// lot est calcul par un processus indpendant (pricer --shard, lanc localement par runSharded ou
+// sur une autre machine partageant les fichiers) qui crit ses rsultats avec leur indice, puis
+// merge les runit dans l'ordre du fichier de transactions.
+class BatchPricer {
+public:
+    // Lecture d'un fichier de transactions
+    // Lve std::runtime_error si le fichier ne peut tre ouvert, std::invalid_argument si une ligne
+    // est mal forme ou si les lignes model et engine manquent
+    static TradeBook loadTrades(const std::string& filename);
+
+    // Graine de la transaction id
+    static unsigned tradeSeed(unsigned seed, const std::string& id);
+
+    // Prix des transactions du lot shard (en parallle sur numThreads threads)
+    // Une transaction dont le calcul choue est rendue avec le statut Error, sans interrompre le lot
+    static std::vector<TradeResult> priceShard(const TradeBook& book, int shard, int numShards, unsigned numThreads = 0);
+
+    // Mme calcul, rsultats crits dans sink au fil de l'eau : les transactions sont calcules par
+    // tranches de STREAM_TRADES et chaque tranche est passe  sink avant le calcul de la suivante.
+    // Seule une tranche de rsultats est en mmoire, et l'criture en arrire-plan du sink recouvre le
+    // calcul de la tranche suivante. sink n'est pas ferm.
+    static const int STREAM_TRADES = 1024;
+    static void priceShard(const TradeBook& book, int shard, int numShards, ResultSink& sink, unsigned numThreads = 0);
+
+    // Calcul du lot shard crit dans le fichier de rsultats filename (voir writeResults)
+    static void writeShard(const TradeBook& book, int shard, int numShards, const std::string& filename,
+                           unsigned numThreads = 0);
+
+    // criture et lecture d'un fichier de rsultats : colonnes binaires pour l'extension .col,
+    // CSV index,id,status,price,standard_error sinon (voir ResultSink) ; les nombres sont relus par
+    // std::from_chars, sans locale, y compris nan et inf, et un identifiant entre guillemets est
+    // relu avec ses guillemets doubls rtablis
+    // Lve std::runtime_error si le fichier ne peut tre ouvert, std::invalid_argument s'il est mal form
+    static void writeResults(const std::string& filename, const std::vector<TradeResult>& results);
+    static std::vector<TradeResult> readResults(const std::string& filename);
+
+    // Runit les fichiers de rsultats des lots dans l'ordre des indices
+    // Lve std::invalid_argument si un indice manque ou apparat deux fois
+    static void merge(const std::vector<std::string>& shardFiles, const std::string& outputFile);
+
+    // Lance numShards processus "executable --shard <tradeFile> <shard> <numShards> <fichier du lot>",
+    // attend leur fin puis runit leurs rsultats dans outputFile (fichiers des lots supprims ensuite)
+    // Lve std::runtime_error si un processus ne peut tre lanc ou choue ; les fichiers des lots
+    // sont alors supprims eux aussi
+    static void runSharded(const std::string& executable, const std::string& tradeFile,
+                           const std::string& outputFile, int numShards);
+};
+
+#endif // BATCH_PRICER_H
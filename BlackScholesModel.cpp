@@ -1,4 +1,6 @@
 #include "BlackScholesModel.h"
+#include "NormalDistribution.h" // Fonction de rpartition de la loi normale partage
+#include "PricingKey.h" // Cl de cache
 #include <iostream> // Inclus pour l'affichage et le dbogage si ncessaire
 
 // Constructeur
@@ -8,35 +10,161 @@ BlackScholesModel::BlackScholesModel(double spot_, double rate_, double volatili
     : spot(spot_), rate(rate_), volatility(volatility_), dividend(dividend_) {}
 
 // Mthode pour le calcul analytique des options vanilles (calls et puts)
-// Utilise la formule de Black-Scholes pour calculer le prix
+// Utilise la formule de Black-Scholes avec les paramtres intgrs sur [0, T] (exacte pour des
+// courbes dterministes) et le spot diminu de la valeur des dividendes cash
 double BlackScholesModel::priceAnalytic(const Option *option, bool isCall) const {
+    double maturity = option->maturity;
+    double rateTerm = rateIntegral(0.0, maturity);         // int r
+    double dividendTerm = dividendIntegral(0.0, maturity); // int q
+    double variance = varianceIntegral(0.0, maturity);     // int sigma^2
+    double stdDev = std::sqrt(variance);
+    double adjustedSpot = spot - cashDividendValue(0.0, maturity); // Spot hors dividendes cash
+
     // Calcul de d1 et d2, des paramtres intermdiaires de la formule de Black-Scholes
-    double d1 = (std::log(spot / option->strike) +
-                 (rate - dividend + 0.5 * volatility * volatility) * option->maturity) /
-                (volatility * std::sqrt(option->maturity));
-    double d2 = d1 - volatility * std::sqrt(option->maturity);
+    double d1 = (std::log(adjustedSpot / option->strike) + rateTerm - dividendTerm + 0.5 * variance) / stdDev;
+    double d2 = d1 - stdDev;
 
     // Calcul des probabilits cumules associes  d1 et d2 pour une loi normale standard
-    double Nd1 = normalCDF(d1);  // Probabilit cumule pour d1
-    double Nd2 = normalCDF(d2);  // Probabilit cumule pour d2
-    double Nmd1 = normalCDF(-d1); // Probabilit cumule pour -d1
-    double Nmd2 = normalCDF(-d2); // Probabilit cumule pour -d2
+    double Nd1 = NormalDistribution::cdf(d1);  // Probabilit cumule pour d1
+    double Nd2 = NormalDistribution::cdf(d2);  // Probabilit cumule pour d2
+    double Nmd1 = NormalDistribution::cdf(-d1); // Probabilit cumule pour -d1
+    double Nmd2 = NormalDistribution::cdf(-d2); // Probabilit cumule pour -d2
 
     // Calcul du prix en fonction du type d'option (call ou put)
     if (isCall) {
         // Prix du call : S*exp(-qT)*N(d1) - K*exp(-rT)*N(d2)
-        return spot * std::exp(-dividend * option->maturity) * Nd1 -
-               option->strike * std::exp(-rate * option->maturity) * Nd2;
+        return adjustedSpot * std::exp(-dividendTerm) * Nd1 -
+               option->strike * std::exp(-rateTerm) * Nd2;
     } else {
         // Prix du put : K*exp(-rT)*N(-d2) - S*exp(-qT)*N(-d1)
-        return option->strike * std::exp(-rate * option->maturity) * Nmd2 -
-               spot * std::exp(-dividend * option->maturity) * Nmd1;
+        return option->strike * std::exp(-rateTerm) * Nmd2 -
+               adjustedSpot * std::exp(-dividendTerm) * Nmd1;
+    }
+}
+
+// Mthode pour le calcul analytique du vega (drive du prix par rapport  la volatilit)
+// Vega = S*exp(-qT)*phi(d1)*sqrt(T), utilis notamment par le solveur de volatilit implicite
+// Avec une courbe de volatilit, drive par rapport  un dplacement parallle de la courbe
+double BlackScholesModel::vegaAnalytic(const Option *option) const {
+    double maturity = option->maturity;
+    double variance = varianceIntegral(0.0, maturity);
+    double stdDev = std::sqrt(variance);
+    double adjustedSpot = spot - cashDividendValue(0.0, maturity);
+    double dividendTerm = dividendIntegral(0.0, maturity);
+    double d1 = (std::log(adjustedSpot / option->strike) + rateIntegral(0.0, maturity) - dividendTerm +
+                 0.5 * variance) / stdDev;
+    return adjustedSpot * std::exp(-dividendTerm) * NormalDistribution::pdf(d1) *
+           volatilityIntegral(0.0, maturity) / stdDev;
+}
+
+// Delta analytique : exp(-int q) N(d1) pour un call, exp(-int q) (N(d1) - 1) pour un put
+// Les dividendes cash ne dpendant pas du spot, la drive du spot ajust vaut 1
+double BlackScholesModel::deltaAnalytic(const Option *option, bool isCall) const {
+    double maturity = option->maturity;
+    double variance = varianceIntegral(0.0, maturity);
+    double adjustedSpot = spot - cashDividendValue(0.0, maturity);
+    double dividendTerm = dividendIntegral(0.0, maturity);
+    double d1 = (std::log(adjustedSpot / option->strike) + rateIntegral(0.0, maturity) - dividendTerm +
+                 0.5 * variance) / std::sqrt(variance);
+    double Nd1 = NormalDistribution::cdf(d1);
+    return std::exp(-dividendTerm) * (isCall ? Nd1 : Nd1 - 1.0);
+}
+
+// Courbes ou dividendes cash dfinis
+bool BlackScholesModel::hasTermStructure() const {
+    return !rateCurve.empty() || !dividendCurve.empty() || !volatilityCurve.empty() || !cashDividends.empty();
+}
+
+// Intgrales des paramtres (courbe si elle est dfinie, paramtre scalaire sinon)
+double BlackScholesModel::rateIntegral(double t0, double t1) const {
+    return rateCurve.empty() ? rate * (t1 - t0) : rateCurve.integral(t0, t1);
+}
+
+double BlackScholesModel::dividendIntegral(double t0, double t1) const {
+    return dividendCurve.empty() ? dividend * (t1 - t0) : dividendCurve.integral(t0, t1);
+}
+
+double BlackScholesModel::varianceIntegral(double t0, double t1) const {
+    return volatilityCurve.empty() ? volatility * volatility * (t1 - t0) : volatilityCurve.integralOfSquare(t0, t1);
+}
+
+double BlackScholesModel::volatilityIntegral(double t0, double t1) const {
+    return volatilityCurve.empty() ? volatility * (t1 - t0) : volatilityCurve.integral(t0, t1);
+}
+
+// Somme des dividendes cash de ]t, horizon], actualiss jusqu' t
+double BlackScholesModel::cashDividendValue(double t, double horizon) const {
+    double value = 0.0;
+    for (const CashDividend& d : cashDividends) {
+        if (d.time > t && d.time <= horizon) {
+            value += d.amount * std::exp(-rateIntegral(t, d.time));
+        }
+    }
+    return value;
+}
+
+// Courbes vues depuis t ; seuls les dividendes cash postrieurs  t sont conservs
+BlackScholesModel BlackScholesModel::rolled(double t) const {
+    BlackScholesModel result = *this;
+    result.rateCurve = rateCurve.rolled(t);
+    result.dividendCurve = dividendCurve.rolled(t);
+    result.volatilityCurve = volatilityCurve.rolled(t);
+    result.cashDividends.clear();
+    for (const CashDividend& d : cashDividends) {
+        if (d.time > t) result.cashDividends.push_back(CashDividend{d.time - t, d.amount});
     }
+    return result;
+}
+
+// Intgrales par pas : calcules une fois ici pour que la boucle par trajectoire se rduise
+//  exp(drift[j] + diffusion[j] * z) et un produit
+StepSchedule BlackScholesModel::schedule(double maturity, int steps, PathArena::Scope& scratch) const {
+    StepSchedule result;
+    result.drift = scratch.allocate(steps);
+    result.diffusion = scratch.allocate(steps);
+    result.dividendOffset = scratch.allocate(steps + 1);
+
+    double dt = maturity / steps; // Pas temporel
+    if (rateCurve.empty() && dividendCurve.empty() && volatilityCurve.empty()) {
+        // Paramtres constants : mmes valeurs  chaque pas
+        double drift = (rate - dividend - 0.5 * volatility * volatility) * dt;
+        double diffusion = volatility * std::sqrt(dt);
+        for (int j = 0; j < steps; ++j) {
+            result.drift[j] = drift;
+            result.diffusion[j] = diffusion;
+        }
+    } else {
+        for (int j = 0; j < steps; ++j) {
+            double t0 = j * dt;
+            double t1 = (j + 1 == steps) ? maturity : (j + 1) * dt;
+            double variance = varianceIntegral(t0, t1);
+            result.drift[j] = rateIntegral(t0, t1) - dividendIntegral(t0, t1) - 0.5 * variance;
+            result.diffusion[j] = std::sqrt(variance);
+        }
+    }
+
+    result.hasCashDividends = false;
+    for (int j = 0; j <= steps; ++j) {
+        result.dividendOffset[j] = cashDividends.empty() ? 0.0 : cashDividendValue(j * dt, maturity);
+        result.hasCashDividends = result.hasCashDividends || result.dividendOffset[j] != 0.0;
+    }
+    result.initialSpot = spot - result.dividendOffset[0];
+    result.discount = std::exp(-rateIntegral(0.0, maturity));
+    return result;
+}
+
+// Fonction caractristique gaussienne : exp(-1/2 sigma^2 T (i u + u^2))
+std::complex<double> BlackScholesModel::characteristicFunction(std::complex<double> u, double maturity) const {
+    const std::complex<double> i(0.0, 1.0);
+    return std::exp(-0.5 * volatility * volatility * maturity * (i * u + u * u));
 }
 
-// Mthode prive pour la fonction de rpartition (CDF) de la loi normale standard
-// Utilise la fonction std::erfc, qui donne la fonction d'erreur complmentaire
-// M_SQRT1_2 est une constante pour 1 / sqrt(2)
-double BlackScholesModel::normalCDF(double x) const {
-    return 0.5 * std::erfc(-x * M_SQRT1_2); // CDF = 0.5 * erfc(-x / sqrt(2))
+// Cl de cache : paramtres scalaires, courbes puis dividendes cash
+void BlackScholesModel::appendKey(PricingKey& key) const {
+    key.add("BlackScholesModel").add(spot).add(rate).add(volatility).add(dividend);
+    rateCurve.appendKey(key);
+    dividendCurve.appendKey(key);
+    volatilityCurve.appendKey(key);
+    key.add(static_cast<long long>(cashDividends.size()));
+    for (const CashDividend& d : cashDividends) key.add(d.time).add(d.amount);
 }
@@ -2,8 +2,36 @@
 #define BLACK_SCHOLES_MODEL_H
 
 #include <cmath> // Pour std::log, std::sqrt, std::exp
+#include <complex> // Pour la fonction caractristique
+#include <vector> // Pour la liste des dividendes cash
 #include "Option.h" // Inclut la classe abstraite Option
+#include "PathArena.h" // Mmoire de travail des intgrales par pas
+#include "TermStructure.h" // Courbes constantes par morceaux
 
+// Dividende cash vers  une date donne
+struct CashDividend {
+    double time;   // Date de dtachement (en annes)
+    double amount; // Montant
+};
+
+// Intgrales du modle sur chaque pas d'une grille uniforme, calcules une fois par pricing
+// Le pas j avance le spot hors dividendes cash : X_{j+1} = X_j exp(drift[j] + diffusion[j] Z)
+// et le spot vaut S_j = X_j + dividendOffset[j] (modle de dividendes "escrowed")
+struct StepSchedule {
+    double* drift;          // int (r - q) - 1/2 int sigma^2 sur le pas j
+    double* diffusion;      // sqrt(int sigma^2) sur le pas j
+    double* dividendOffset; // Valeur en j des dividendes cash restant  verser avant maturit (steps + 1 dates)
+    double initialSpot;     // X_0 = spot - dividendOffset[0]
+    double discount;        // exp(-int_0^T r)
+    bool hasCashDividends;  // Faux si dividendOffset est identiquement nul
+};
+
+// Modle de Black-Scholes
+// Les paramtres scalaires peuvent tre remplacs par des courbes dterministes constantes par
+// morceaux (rateCurve, dividendCurve, volatilityCurve) et complts par des dividendes cash.
+// Ces courbes sont prises en compte par priceAnalytic, par les moteurs de trajectoires
+// (Monte-Carlo, PathMatrix, AAD) et par les couvertures ; les moteurs EDP, arbres et Fourier
+// n'utilisent que les scalaires et refusent un modle avec courbes (voir hasTermStructure).
 class BlackScholesModel {
 public:
     // Membres publics pour les paramtres du modle
@@ -12,15 +40,47 @@ public:
     double volatility;  // Volatilit du sous-jacent
     double dividend;    // Taux de dividende
 
+    // Structures par terme (vides : paramtres scalaires ci-dessus)
+    TermStructure rateCurve;                // Taux court
+    TermStructure dividendCurve;            // Taux de dividende continu
+    TermStructure volatilityCurve;          // Volatilit instantane
+    std::vector<CashDividend> cashDividends; // Dividendes cash (tris ou non)
+
     // Constructeur
     BlackScholesModel(double spot_, double rate_, double volatility_, double dividend_);
 
     // Mthode pour calculer le prix analytique des options vanilles (Call ou Put)
     double priceAnalytic(const Option *option, bool isCall) const;
 
-private:
-    // Mthode prive pour calculer la fonction CDF de la loi normale standard
-    double normalCDF(double x) const;
+    // Mthode pour calculer le vega analytique (identique pour un call et un put)
+    double vegaAnalytic(const Option *option) const;
+
+    // Delta analytique (drive de priceAnalytic par rapport au spot)
+    double deltaAnalytic(const Option *option, bool isCall) const;
+
+    // Vrai si une courbe ou un dividende cash est dfini (le modle n'est pas dcrit par ses scalaires)
+    bool hasTermStructure() const;
+
+    // Intgrales sur [t0, t1] du taux, du taux de dividende, de la variance et de la volatilit
+    double rateIntegral(double t0, double t1) const;
+    double dividendIntegral(double t0, double t1) const;
+    double varianceIntegral(double t0, double t1) const;
+    double volatilityIntegral(double t0, double t1) const;
+
+    // Valeur en t des dividendes cash dtachs dans ]t, horizon]
+    double cashDividendValue(double t, double horizon) const;
+
+    // Mme modle vu depuis la date t (courbes dcales, dividendes cash restants) ; spot inchang
+    BlackScholesModel rolled(double t) const;
+
+    // Intgrales par pas sur [0, maturity] dcoup en steps pas, alloues dans scratch
+    StepSchedule schedule(double maturity, int steps, PathArena::Scope& scratch) const;
+
+    // Ajoute  une cl de cache tous les paramtres du modle (scalaires, courbes, dividendes cash)
+    void appendKey(PricingKey& key) const;
+
+    // Fonction caractristique de ln(S_T / F_T), value en un argument complexe (pricers de Fourier)
+    std::complex<double> characteristicFunction(std::complex<double> u, double maturity) const;
 };
 
 #endif // BLACK_SCHOLES_MODEL_H
@@ -12,7 +12,13 @@ public:
     double payoff(double spot) const override;
 
     // Rplication base sur Black-Scholes
-    double hedgeCost(const BlackScholesModel& model, int steps) const override;
+    double hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context) const override;
+
+    // Rend visible la rplication sans contexte
+    using Option::hedgeCost;
+
+    // Cl de cache : nom du produit, strike, maturit
+    void appendKey(PricingKey& key) const override;
 };
 
 #endif // CALLOPTION_H
@@ -0,0 +1,20 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic> // Pour std::atomic
+#include <memory> // Pour std::shared_ptr
+
+// Jeton d'annulation cooprative : les copies partagent le mme indicateur ; le demandeur appelle
+// cancel(), le calcul consulte isCancelled() entre deux morceaux de travail
+class CancellationToken {
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool> >(false)) {}
+
+    void cancel() const { flag->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool> > flag;
+};
+
+#endif // CANCELLATION_TOKEN_H
@@ -0,0 +1,82 @@
+#include "Checkpoint.h"
+#include <cstdio>    // Pour std::rename et std::remove
+#include <cstring>   // Pour std::memcmp
+#include <fstream>   // Pour std::ifstream et std::ofstream
+#include <stdexcept> // Pour std::runtime_error
+
+// En-tte du fichier (format et version ; la version 01 contenait aussi un tat de gnrateur)
+static const char MAGIC[8] = {'P', 'R', 'C', 'K', 'P', 'T', '0', '2'};
+
+Checkpoint::Checkpoint(const std::string& path_) : filename(path_) {}
+
+template <typename T>
+static void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static void readValue(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+// Tableau prcd de sa taille
+template <typename T>
+static void writeArray(std::ofstream& file, const T* data, std::uint64_t size) {
+    writeValue(file, size);
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size * sizeof(T)));
+}
+
+template <typename Container>
+static void readArray(std::ifstream& file, Container& data) {
+    std::uint64_t size = 0;
+    readValue(file, size);
+    if (!file || size > (1ull << 32)) throw std::runtime_error("Checkpoint file is corrupted.");
+    data.resize(static_cast<std::size_t>(size));
+    if (size > 0) file.read(reinterpret_cast<char*>(&data[0]), static_cast<std::streamsize>(size * sizeof(data[0])));
+}
+
+bool Checkpoint::load(CheckpointState& state) const {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+    char magic[sizeof(MAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Checkpoint file " + filename + " has an unknown format.");
+    }
+    try {
+        readValue(file, state.key);
+        readArray(file, state.counters);
+        readArray(file, state.values);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Checkpoint file " + filename + " is corrupted.");
+    }
+    if (!file) {
+        throw std::runtime_error("Checkpoint file " + filename + " is truncated.");
+    }
+    return true;
+}
+
+void Checkpoint::save(const CheckpointState& state) const {
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Cannot create checkpoint file " + temporary + ".");
+        }
+        file.write(MAGIC, sizeof(MAGIC));
+        writeValue(file, state.key);
+        writeArray(file, state.counters.data(), state.counters.size());
+        writeArray(file, state.values.data(), state.values.size());
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Cannot write checkpoint file " + temporary + ".");
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace checkpoint file " + filename + ".");
+    }
+}
+
+void Checkpoint::remove() const {
+    std::remove(filename.c_str());
+}
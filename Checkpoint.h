@@ -0,0 +1,41 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint> // Pour std::uint64_t
+#include <string>  // Pour le chemin
+#include <vector>  // Pour les compteurs et les accumulateurs
+
+// tat d'un calcul long au moment d'un point de reprise
+struct CheckpointState {
+    std::uint64_t key;               // Empreinte du calcul (produit, modle, rglages)
+    std::vector<long long> counters; // Compteurs (morceau ou pas suivant, trajectoires...)
+    std::vector<double> values;      // Accumulateurs, enregistrs bit  bit
+};
+
+// Fichier de points de reprise d'un calcul Monte-Carlo ou d'une couverture
+// Le fichier est binaire : les doubles sont recopis tels quels, si bien qu'un calcul repris
+// repart exactement des mmes accumulateurs et donne un rsultat identique bit  bit  celui
+// d'un calcul ininterrompu. Aucun tat de gnrateur n'est sauvegard : un calcul repris tire 
+// nouveau ses nombres alatoires  partir de sa graine. Chaque sauvegarde crit un fichier
+// temporaire puis le renomme : un arrt pendant l'criture laisse le point de reprise prcdent intact.
+class Checkpoint {
+public:
+    explicit Checkpoint(const std::string& path_);
+
+    // Lit le dernier tat sauvegard ; false s'il n'y en a pas
+    // Lve std::runtime_error si le fichier est illisible ou tronqu
+    bool load(CheckpointState& state) const;
+
+    // Sauvegarde l'tat ; lve std::runtime_error en cas d'chec d'criture
+    void save(const CheckpointState& state) const;
+
+    // Supprime le fichier (calcul termin)
+    void remove() const;
+
+    const std::string& path() const { return filename; }
+
+private:
+    std::string filename;
+};
+
+#endif // CHECKPOINT_H
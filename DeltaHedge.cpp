@@ -0,0 +1,159 @@
+#include "DeltaHedge.h"
+#include "Checkpoint.h"   // Points de reprise
+#include "ExoticOption.h" // Crochets du produit
+#include "PathArena.h"    // Intgrales par pas de la trajectoire couverte
+#include "PricingKey.h"   // Empreinte de la couverture sauvegarde
+#include <cmath>          // Pour std::exp et std::sqrt
+#include <limits>         // Pour NaN et l'infini
+#include <random>         // Pour std::mt19937 et std::generate_canonical
+#include <stdexcept>      // Pour std::invalid_argument et std::runtime_error
+
+// Trajectoire couverte et dsactivation  chaque date
+DeltaHedge::DeltaHedge(const ExoticOption& option_, const BlackScholesModel& model_, int steps_,
+                       const PricingContext& context_, int deltaPaths_)
+    : option(option_), model(model_), steps(steps_), context(context_), deltaPaths(deltaPaths_) {
+    if (steps <= 0 || deltaPaths <= 0) {
+        throw std::invalid_argument("DeltaHedge requires positive steps and number of paths.");
+    }
+    dt = option.maturity / steps;
+    epsilon = 0.01 * model.spot;
+
+    PathArena::Scope scratch;
+    const StepSchedule schedule = model.schedule(option.maturity, steps, scratch);
+    std::mt19937 rng = context.generator(); // Gnrateur de la trajectoire couverte
+
+    spots.resize(steps);
+    growth.assign(steps, 1.0);
+    inactive.resize(steps);
+    double x = schedule.initialSpot; // Sous-jacent hors dividendes cash
+    spots[0] = model.spot;
+    inactive[0] = option.hedgeKnockedOut(PathView(spots.data(), 1));
+    for (int i = 1; i < steps; ++i) {
+        // Perturbation uniforme centre, comme les couvertures historiques des options
+        double shock = std::generate_canonical<double, 53>(rng) - 0.5;
+        x *= std::exp(schedule.drift[i - 1] + schedule.diffusion[i - 1] * shock);
+        spots[i] = schedule.hasCashDividends ? x + schedule.dividendOffset[i] : x;
+        growth[i] = std::exp(model.rateIntegral((i - 1) * dt, i * dt));
+        inactive[i] = inactive[i - 1] || option.hedgeKnockedOut(PathView(spots.data(), i + 1));
+    }
+}
+
+// Delta  la date i sous le modle vu depuis cette date
+MonteCarloDelta DeltaHedge::delta(int i) const {
+    if (inactive[i]) return MonteCarloDelta{0.0, 0.0};
+    BlackScholesModel local = model.rolled(i * dt);
+    local.spot = spots[i];
+    std::mt19937 rng = context.derive(static_cast<unsigned>(i)).generator();
+    return MonteCarloEngine::runDelta(option, local, epsilon, deltaPaths, steps - i,
+                                      option.hedgeHorizon(option.maturity - i * dt), rng);
+}
+
+// Rplication : achat du delta initial, rajustements capitaliss, liquidation et payoff
+// Le cot tant linaire en les deltas, un passage inverse sur la rcurrence du cash donne le
+// coefficient de chaque delta calcul, d'o la variance du cot
+HedgeResult DeltaHedge::cost(const std::vector<MonteCarloDelta>& deltas, int count) const {
+    if (count <= 0) {
+        return HedgeResult{std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), 0};
+    }
+
+    // Delta tenu  chaque date et pas dont il provient (-1 : delta nul aprs dsactivation)
+    std::vector<double> held(steps);
+    std::vector<int> source(steps);
+    for (int i = 0; i < steps; ++i) {
+        if (i < count) {
+            held[i] = deltas[i].delta;
+            source[i] = i;
+        } else if (inactive[i]) {
+            held[i] = 0.0;
+            source[i] = -1;
+        } else {
+            held[i] = deltas[count - 1].delta;
+            source[i] = count - 1;
+        }
+    }
+
+    double cash = held[0] * spots[0]; // Portefeuille initial
+    for (int i = 1; i < steps; ++i) {
+        cash += (held[i] - held[i - 1]) * spots[i]; // Ajustement du portefeuille
+        cash *= growth[i];                          // Capitalisation du cash
+    }
+    double total = cash - held[steps - 1] * spots[steps - 1] +
+                   option.hedgePayoff(PathView(spots.data(), steps));
+
+    // Passage inverse : drive du cot par rapport au delta tenu  chaque date
+    std::vector<double> coefficient(steps, 0.0);
+    coefficient[steps - 1] -= spots[steps - 1];
+    double adjoint = 1.0; // Drive du cot par rapport au cash courant
+    for (int i = steps - 1; i >= 1; --i) {
+        adjoint *= growth[i];
+        coefficient[i] += adjoint * spots[i];
+        coefficient[i - 1] -= adjoint * spots[i];
+    }
+    coefficient[0] += adjoint * spots[0];
+
+    // Regroupement par delta calcul (un delta conserv compte  chaque date o il est tenu)
+    std::vector<double> bySource(count, 0.0);
+    for (int i = 0; i < steps; ++i) {
+        if (source[i] >= 0) bySource[source[i]] += coefficient[i];
+    }
+    double variance = 0.0;
+    for (int j = 0; j < count; ++j) {
+        double term = bySource[j] * deltas[j].standardError;
+        variance += term * term;
+    }
+    return HedgeResult{total, std::sqrt(variance), count};
+}
+
+// Deltas dans l'ordre des pas, avec points de reprise et arrt anticip
+HedgeResult DeltaHedge::run(const Checkpoint* checkpoint, int checkpointEvery,
+                            const std::function<bool()>& stop) const {
+    if (checkpointEvery <= 0) {
+        throw std::invalid_argument("DeltaHedge::run requires a positive checkpoint interval.");
+    }
+    PricingKey key;
+    key.add("DeltaHedge");
+    option.appendKey(key);
+    model.appendKey(key);
+    key.add(static_cast<long long>(steps)).add(static_cast<long long>(context.seed()))
+       .add(static_cast<long long>(deltaPaths));
+
+    // Deltas dj calculs : couples (delta, erreur standard)
+    std::vector<MonteCarloDelta> deltas(steps);
+    int next = 0;
+    CheckpointState state;
+    if (checkpoint && checkpoint->load(state)) {
+        if (state.key != key.hash() || state.counters.size() != 1 || state.counters[0] < 0 ||
+            state.counters[0] > steps || state.values.size() != 2 * static_cast<std::size_t>(state.counters[0])) {
+            throw std::runtime_error("Checkpoint file " + checkpoint->path() + " belongs to a different computation.");
+        }
+        next = static_cast<int>(state.counters[0]);
+        for (int i = 0; i < next; ++i) {
+            deltas[i] = MonteCarloDelta{state.values[2 * i], state.values[2 * i + 1]};
+        }
+    }
+
+    // Sauvegarde des deltas des pas [0, count)
+    auto save = [&](int count) {
+        std::vector<double> values;
+        values.reserve(2 * count);
+        for (int i = 0; i < count; ++i) {
+            values.push_back(deltas[i].delta);
+            values.push_back(deltas[i].standardError);
+        }
+        checkpoint->save(CheckpointState{key.hash(), {count}, values});
+    };
+
+    for (; next < steps; ++next) {
+        if (stop && stop()) break;
+        deltas[next] = delta(next);
+        if (checkpoint && (next + 1) % checkpointEvery == 0 && next + 1 < steps) save(next + 1);
+    }
+    if (checkpoint) {
+        if (next == steps) {
+            checkpoint->remove();
+        } else {
+            save(next); // Arrt anticip : la reprise repartira de ce pas
+        }
+    }
+    return cost(deltas, next);
+}
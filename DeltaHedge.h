@@ -0,0 +1,73 @@
+#ifndef DELTA_HEDGE_H
+#define DELTA_HEDGE_H
+
+#include "BlackScholesModel.h"
+#include "MonteCarloEngine.h" // Pour MonteCarloDelta
+#include "PricingContext.h"
+#include <functional>         // Condition d'arrt
+#include <vector>
+
+class Checkpoint;
+class ExoticOption;
+
+// Rsultat d'une couverture en delta
+struct HedgeResult {
+    double cost;          // Cot de rplication (NaN si aucun delta n'a t calcul)
+    double standardError; // Erreur standard due au bruit Monte-Carlo des deltas
+    int deltaSteps;       // Nombre de pas dont le delta a t calcul (steps si la couverture est complte)
+};
+
+// Couverture en delta d'une option exotique le long d'une trajectoire simule
+//
+// La trajectoire couverte (dates 0  steps - 1) est tire une fois,  la construction, par le
+// gnrateur de context, avec les intgrales par pas du modle (courbes et dividendes cash compris) ;
+// le cash est capitalis avec la courbe de taux. Le delta du pas i est une diffrence finie centre
+// de prix Monte-Carlo sous le modle vu depuis la date du pas (BlackScholesModel::rolled), sur des
+// trajectoires communes aux deux spots tires par context.derive(i). Il ne dpend pas des autres
+// deltas : les pas peuvent tre calculs dans n'importe quel ordre, sur n'importe quel thread, ou
+// repris aprs une interruption, avec un rsultat identique bit  bit. Le produit intervient par les
+// crochets de ExoticOption : dsactivation (delta nul), horizon des prix et payoff de la trajectoire.
+class DeltaHedge {
+public:
+    // Lve std::invalid_argument si steps ou deltaPaths n'est pas strictement positif
+    DeltaHedge(const ExoticOption& option_, const BlackScholesModel& model_, int steps_,
+               const PricingContext& context_, int deltaPaths_ = 10000);
+
+    int numSteps() const { return steps; }
+
+    // Trajectoire couverte, dates 0  steps - 1
+    const std::vector<double>& path() const { return spots; }
+
+    // Vrai si le produit est dsactiv  la date i : le delta y est nul, sans calcul
+    bool knockedOut(int i) const { return inactive[i] != 0; }
+
+    // Delta du pas i (0 <= i < steps)
+    MonteCarloDelta delta(int i) const;
+
+    // Cot de rplication  partir des deltas des pas [0, count) ; aux dates suivantes la couverture
+    // n'est plus rajuste (dernier delta conserv, nul aprs dsactivation). L'erreur standard
+    // propage celles des deltas, le cot tant linaire en les deltas
+    HedgeResult cost(const std::vector<MonteCarloDelta>& deltas, int count) const;
+
+    // Calcul des deltas dans l'ordre des pas, puis du cot
+    // checkpoint (facultatif) : les deltas calculs sont sauvegards tous les checkpointEvery pas et 
+    // l'arrt ; un appel avec les mmes arguments reprend au dernier point sauvegard. Le fichier est
+    // supprim une fois tous les pas calculs. Lve std::runtime_error s'il correspond  un autre calcul.
+    // stop (facultatif) : consult avant chaque pas ; s'il rend vrai, le cot porte sur les pas calculs
+    HedgeResult run(const Checkpoint* checkpoint = nullptr, int checkpointEvery = 1,
+                    const std::function<bool()>& stop = std::function<bool()>()) const;
+
+private:
+    const ExoticOption& option;
+    BlackScholesModel model;
+    int steps;
+    PricingContext context;
+    int deltaPaths;
+    double dt;                   // Pas temporel
+    double epsilon;              // Variation du spot pour les diffrences finies
+    std::vector<double> spots;   // Trajectoire couverte
+    std::vector<double> growth;  // Capitalisation du cash sur le pas [i - 1, i] (growth[0] inutilis)
+    std::vector<char> inactive;  // Dsactivation  chaque date
+};
+
+#endif // DELTA_HEDGE_H
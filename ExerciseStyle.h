@@ -0,0 +1,7 @@
+#ifndef EXERCISE_STYLE_H
+#define EXERCISE_STYLE_H
+
+// Style d'exercice d'une option
+enum class ExerciseStyle { European, American };
+
+#endif // EXERCISE_STYLE_H
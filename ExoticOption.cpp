@@ -1,5 +1,102 @@
 #include "ExoticOption.h"
+#include "DeltaHedge.h"       // Couverture en delta commune
+#include "HestonModel.h"
+#include "JumpDiffusionModel.h"
+#include "LocalVolatilityModel.h"
+#include "MonteCarloEngine.h" // Moteur Monte-Carlo commun
+#include "MultiAssetModel.h"
+#include <random>             // Pour std::mt19937
 
 // Constructeur de ExoticOption
 ExoticOption::ExoticOption(double strike_, double maturity_)
     : Option(strike_, maturity_) {}
+
+// Graine tire de std::random_device, comme avant l'introduction des contextes
+double ExoticOption::price(const BlackScholesModel& model, int numPaths, int steps) const {
+    return price(model, numPaths, steps, PricingContext::fromEntropy());
+}
+
+// Pricing Monte-Carlo avec choix de la prcision de simulation
+double ExoticOption::price(const BlackScholesModel& model, int numPaths, int steps, SimulationPrecision precision,
+                           const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, maturity, precision, rng).price;
+}
+
+// Pricing Monte-Carlo sous le modle de Heston
+double ExoticOption::price(const HestonModel& model, int numPaths, int steps, const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, maturity, rng).price;
+}
+
+// Pricing Monte-Carlo sous le modle  volatilit locale
+double ExoticOption::price(const LocalVolatilityModel& model, int numPaths, int steps, const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, maturity, rng).price;
+}
+
+// Pricing Monte-Carlo sous un modle  sauts
+double ExoticOption::price(const JumpDiffusionModel& model, int numPaths, int steps, const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, maturity, rng).price;
+}
+
+// Pricing Monte-Carlo multi-actifs sur la trajectoire agrge
+double ExoticOption::price(const MultiAssetModel& model, BasketType type, const std::vector<double>& weights,
+                           int numPaths, int steps, const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, type, weights, numPaths, steps, maturity, rng).price;
+}
+
+// Prix et sensibilits par diffrentiation automatique adjointe
+MonteCarloGreeks ExoticOption::greeks(const BlackScholesModel& model, int numPaths, int steps,
+                                      const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::runGreeks(*this, model, numPaths, steps, maturity, rng);
+}
+
+// Couverture en delta complte
+double ExoticOption::hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context) const {
+    return DeltaHedge(*this, model, steps, context).run().cost;
+}
+
+// Couverture en delta reprenable
+double ExoticOption::hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context,
+                               const Checkpoint& checkpoint, int checkpointEvery) const {
+    return DeltaHedge(*this, model, steps, context).run(&checkpoint, checkpointEvery).cost;
+}
+
+// Crochets par dfaut : pas de dsactivation, prix  maturit restante, payoff de la trajectoire
+bool ExoticOption::hedgeKnockedOut(const PathView&) const {
+    return false;
+}
+
+double ExoticOption::hedgeHorizon(double remainingMaturity) const {
+    return remainingMaturity;
+}
+
+double ExoticOption::hedgePayoff(const PathView& path) const {
+    return payoff(path);
+}
+
+// Variable d'tat par dfaut : le spot  la dernire date de la vue
+double ExoticOption::pathStatistic(const PathView& path) const {
+    return path.back();
+}
+
+// Moyenne des payoffs sur les trajectoires d'une PathMatrix (accs path-major via les vues)
+double ExoticOption::averagePayoff(const PathMatrix& paths) const {
+    double sumPayoffs = 0.0;
+    for (int i = 0; i < paths.numPaths(); ++i) {
+        sumPayoffs += payoff(paths.path(i));
+    }
+    return sumPayoffs / paths.numPaths();
+}
+
+double ExoticOption::averagePayoff(const PathMatrixF& paths) const {
+    double sumPayoffs = 0.0;
+    for (int i = 0; i < paths.numPaths(); ++i) {
+        sumPayoffs += payoff(paths.path(i));
+    }
+    return sumPayoffs / paths.numPaths();
+}
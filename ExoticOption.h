@@ -3,21 +3,110 @@
 
 #include "Option.h"
 #include "BlackScholesModel.h"
+#include "BasketType.h"
+#include "PathMatrix.h"
+#include "SimulationPrecision.h"
+#include "MonteCarloEngine.h"
+#include "Aad.h"
+#include "Checkpoint.h"
 #include <vector>
 
+class HestonModel;
+class LocalVolatilityModel;
+class JumpDiffusionModel;
+class MultiAssetModel;
+
+// Vue sur une trajectoire enregistre sur la bande AAD
+typedef BasicPathView<ADouble> PathViewAD;
+
+// Graines : toute surcharge sans contexte (price(model, numPaths, steps), la couverture
+// hedgeCost(model, steps) et le prix  maturit ajuste des produits) tire sa graine de
+// std::random_device (PricingContext::fromEntropy) ; les autres surcharges exigent un contexte.
+// Un rsultat reproductible passe donc toujours un contexte explicite.
 class ExoticOption : public Option {
 public:
     ExoticOption(double strike_, double maturity_);
 
     // Mthode virtuelle pour le pricing par Monte-Carlo
-    virtual double price(const BlackScholesModel& model, int numPaths, int steps) const = 0;
+    // Toutes les surcharges tirent leurs trajectoires du gnrateur de context : mme contexte,
+    // mme prix, bit  bit
+    virtual double price(const BlackScholesModel& model, int numPaths, int steps,
+                         const PricingContext& context) const = 0;
+
+    // Pricing Monte-Carlo sans contexte : deux appels donnent des prix diffrents
+    double price(const BlackScholesModel& model, int numPaths, int steps) const;
+
+    // Pricing Monte-Carlo avec choix de la prcision de simulation (accumulation toujours en double)
+    double price(const BlackScholesModel& model, int numPaths, int steps, SimulationPrecision precision,
+                 const PricingContext& context) const;
+
+    // Pricing Monte-Carlo sous le modle de Heston (schma QE, simulation multi-threade)
+    double price(const HestonModel& model, int numPaths, int steps,
+                 const PricingContext& context) const;
+
+    // Pricing Monte-Carlo sous un modle  volatilit locale (prix cohrents avec le smile)
+    double price(const LocalVolatilityModel& model, int numPaths, int steps,
+                 const PricingContext& context) const;
+
+    // Pricing Monte-Carlo sous un modle  sauts (Merton ou Kou)
+    double price(const JumpDiffusionModel& model, int numPaths, int steps,
+                 const PricingContext& context) const;
+
+    // Version panier / spread / worst-of du mme payoff sur plusieurs sous-jacents corrls
+    double price(const MultiAssetModel& model, BasketType type, const std::vector<double>& weights,
+                 int numPaths, int steps, const PricingContext& context) const;
+
+    // Prix et sensibilits (delta, vega, rho, dividende) en une seule simulation par AAD
+    MonteCarloGreeks greeks(const BlackScholesModel& model, int numPaths, int steps,
+                            const PricingContext& context) const;
+
+    // Cot de rplication par couverture en delta (voir DeltaHedge) : trajectoire couverte tire par
+    // le gnrateur de context, deltas du pas i par celui de context.derive(i)
+    double hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context) const override;
 
-    // Mthode gnrique pour calculer le cot de rplication
-    virtual double hedgeCost(const BlackScholesModel& model, int steps) const = 0;
+    // Rend visible la rplication sans contexte
+    using Option::hedgeCost;
+
+    // Mme couverture, reprenable : les deltas calculs sont sauvegards dans checkpoint tous les
+    // checkpointEvery pas ; un appel avec les mmes arguments reprend au dernier point sauvegard et
+    // donne le mme rsultat, bit  bit. Le fichier est supprim  la fin du calcul.
+    // Lve std::runtime_error si le fichier existant correspond  un autre calcul
+    double hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context,
+                     const Checkpoint& checkpoint, int checkpointEvery = 1) const;
+
+    // Crochets de la couverture en delta
+    // Vrai si le produit est dsactiv sur la trajectoire couverte jusqu' sa dernire date (le delta
+    // est alors nul jusqu' maturit) ; par dfaut jamais
+    virtual bool hedgeKnockedOut(const PathView& path) const;
+
+    // Maturit des prix Monte-Carlo dont on tire le delta quand il reste remainingMaturity ;
+    // par dfaut la maturit restante
+    virtual double hedgeHorizon(double remainingMaturity) const;
+
+    // Payoff rgl en fin de couverture sur la trajectoire couverte ; par dfaut payoff(path)
+    virtual double hedgePayoff(const PathView& path) const;
 
     // Mthode virtuelle pure pour calculer le payoff
     virtual double payoff(double spot) const = 0;
 
+    // Mthode virtuelle pure pour le payoff sur une trajectoire complte (prix initial en position 0)
+    virtual double payoff(const PathView& path) const = 0;
+
+    // Mme payoff sur une trajectoire simule en simple prcision
+    virtual double payoff(const PathViewF& path) const = 0;
+
+    // Payoff diffrentiable sur une trajectoire enregistre sur la bande AAD
+    // smoothing est la largeur relative de lissage des indicatrices (barrires)
+    virtual ADouble payoff(const PathViewAD& path, double smoothing) const = 0;
+
+    // Variable d'tat de la trajectoire (moyenne courante, extremum...) utilise avec le spot
+    // comme variable explicative de la rgression de Longstaff-Schwartz ; par dfaut le spot final
+    virtual double pathStatistic(const PathView& path) const;
+
+    // Moyenne (non actualise) des payoffs sur toutes les trajectoires d'une PathMatrix
+    double averagePayoff(const PathMatrix& paths) const;
+    double averagePayoff(const PathMatrixF& paths) const;
+
     // Destructeur virtuel
     virtual ~ExoticOption() = default;
 };
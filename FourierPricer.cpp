@@ -0,0 +1,253 @@
+#include "FourierPricer.h"
+#include "BlackScholesModel.h"
+#include "CallOption.h"
+#include "HestonModel.h"
+#include "JumpDiffusionModel.h"
+#include "PathArena.h" // Mmoire de travail (grilles de frquences, coefficients)
+#include "PutOption.h"
+#include <algorithm>   // Pour std::min, std::max et std::stable_sort
+#include <cmath>       // Pour std::exp, std::log, std::sqrt, std::cos, std::sin, std::floor
+#include <complex>     // Pour std::complex
+#include <numeric>     // Pour std::iota
+#include <stdexcept>   // Pour std::invalid_argument
+#include <utility>     // Pour std::swap
+#include <vector>      // Pour le regroupement par maturit
+
+typedef std::complex<double> Complex;
+
+// FFT itrative radix-2 en place (exposant ngatif), n puissance de 2
+static void fft(Complex* data, int n) {
+    for (int i = 1, j = 0; i < n; ++i) { // Permutation par renversement des bits
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (int length = 2; length <= n; length <<= 1) {
+        Complex root = std::polar(1.0, -2.0 * M_PI / length);
+        for (int start = 0; start < n; start += length) {
+            Complex w(1.0, 0.0);
+            for (int k = 0; k < length / 2; ++k) {
+                Complex even = data[start + k];
+                Complex odd = data[start + k + length / 2] * w;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                w *= root;
+            }
+        }
+    }
+}
+
+// Fonction caractristique du log-rendement ln(S_T / S_0) = (r - q) T + ln(S_T / F_T)
+template <typename Model>
+static Complex returnCharacteristicFunction(const Model& model, Complex u, double maturity) {
+    const Complex i(0.0, 1.0);
+    return std::exp(i * u * ((model.rate - model.dividend) * maturity)) * model.characteristicFunction(u, maturity);
+}
+
+// Les pricers de Fourier n'utilisent que les paramtres scalaires du modle
+static void requireScalarParameters(const BlackScholesModel& model) {
+    if (model.hasTermStructure()) {
+        throw std::invalid_argument("FourierPricer uses scalar parameters only: curves and cash dividends are not supported.");
+    }
+}
+
+template <typename Model>
+static void requireScalarParameters(const Model&) {}
+
+// Constructeur du pricer
+FourierPricer::FourierPricer(int fftSize_, double fftSpacing_, double dampingFactor_, int cosTerms_,
+                             double cosTruncation_)
+    : fftSize(fftSize_), fftSpacing(fftSpacing_), dampingFactor(dampingFactor_), cosTerms(cosTerms_),
+      cosTruncation(cosTruncation_) {
+    // La FFT radix-2 suppose une puissance de 2, l'interpolation cubique au moins 4 points
+    if (fftSize < 4 || (fftSize & (fftSize - 1)) != 0) {
+        throw std::invalid_argument("FourierPricer fftSize must be a power of two >= 4.");
+    }
+    if (!(fftSpacing > 0.0) || !(dampingFactor > 0.0) || cosTerms <= 0 || !(cosTruncation > 0.0)) {
+        throw std::invalid_argument(
+            "FourierPricer requires fftSpacing > 0, dampingFactor > 0, cosTerms > 0 and cosTruncation > 0.");
+    }
+}
+
+// Dcoupe en groupes de cotations conscutives de mme maturit
+template <typename Model>
+void FourierPricer::price(const Model& model, const VolQuote* quotes, double* prices, std::size_t n,
+                          FourierMethod method) const {
+    requireScalarParameters(model);
+    std::size_t begin = 0;
+    while (begin < n) {
+        std::size_t end = begin + 1;
+        while (end < n && quotes[end].maturity == quotes[begin].maturity) ++end;
+        if (method == FourierMethod::CarrMadan) {
+            priceCarrMadan(model, quotes + begin, prices + begin, end - begin);
+        } else {
+            priceCos(model, quotes + begin, prices + begin, end - begin);
+        }
+        begin = end;
+    }
+}
+
+// Chane d'options : conversion en cotations tries par maturit, puis remise dans l'ordre initial
+template <typename Model>
+void FourierPricer::price(const Model& model, const Option* const* options, double* prices, std::size_t n,
+                          FourierMethod method) const {
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return options[a]->maturity < options[b]->maturity;
+    });
+
+    std::vector<VolQuote> quotes(n);
+    for (std::size_t s = 0; s < n; ++s) {
+        const Option* option = options[order[s]];
+        bool isCall = dynamic_cast<const CallOption*>(option) != nullptr;
+        if (!isCall && dynamic_cast<const PutOption*>(option) == nullptr) {
+            throw std::invalid_argument("Only CallOption and PutOption can be priced by FourierPricer.");
+        }
+        quotes[s] = VolQuote{option->strike, option->maturity, 0.0, isCall};
+    }
+
+    std::vector<double> sorted(n);
+    price(model, quotes.data(), sorted.data(), n, method);
+    for (std::size_t s = 0; s < n; ++s) prices[order[s]] = sorted[s];
+}
+
+// Une seule option
+template <typename Model>
+double FourierPricer::price(const Model& model, const Option* option, FourierMethod method) const {
+    double result;
+    price(model, &option, &result, 1, method);
+    return result;
+}
+
+// Carr-Madan : le call amorti e^{alpha k} C(k) est la transforme de Fourier de
+//   psi(v) = e^{-rT} phi_lnS(v - (alpha + 1) i) / (alpha^2 + alpha - v^2 + i (2 alpha + 1) v)
+// Grille en log-strike k_m = ln F - b + lambda m centre sur le forward, rgle de Simpson en v
+template <typename Model>
+void FourierPricer::priceCarrMadan(const Model& model, const VolQuote* quotes, double* prices, std::size_t n) const {
+    const double maturity = quotes[0].maturity;
+    const double discount = std::exp(-model.rate * maturity);
+    const double discountedSpot = model.spot * std::exp(-model.dividend * maturity);
+    const double logForward = std::log(discountedSpot / discount);
+    const int size = fftSize;
+    const double eta = fftSpacing;
+    const double alpha = dampingFactor;
+    const double lambda = 2.0 * M_PI / (size * eta);
+    const double b = 0.5 * size * lambda;
+    const Complex i(0.0, 1.0);
+
+    PathArena::Scope scope;
+    Complex* data = scope.allocateAs<Complex>(size);
+
+    // e^{i u ln F} e^{-i v (ln F - b)} = e^{i v b} e^{(alpha + 1) ln F} pour u = v - (alpha + 1) i
+    const double scale = discount * std::exp((alpha + 1.0) * logForward) * eta / 3.0;
+    for (int j = 0; j < size; ++j) {
+        double v = j * eta;
+        Complex u(v, -(alpha + 1.0));
+        Complex denominator(alpha * alpha + alpha - v * v, (2.0 * alpha + 1.0) * v);
+        double simpson = (j == 0) ? 1.0 : ((j % 2 == 1) ? 4.0 : 2.0);
+        data[j] = std::exp(i * (v * b)) * model.characteristicFunction(u, maturity) / denominator * (scale * simpson);
+    }
+
+    fft(data, size);
+
+    // Prix des calls sur la grille (rutilise la partie relle du tampon)
+    const double kStart = logForward - b;
+    for (int m = 0; m < size; ++m) {
+        double k = kStart + lambda * m;
+        data[m] = Complex(std::exp(-alpha * k) / M_PI * data[m].real(), 0.0);
+    }
+
+    // Interpolation de Lagrange cubique en log-strike, put par parit
+    for (std::size_t q = 0; q < n; ++q) {
+        double strike = quotes[q].strike;
+        double position = (std::log(strike) - kStart) / lambda;
+        int m = std::min(std::max(static_cast<int>(std::floor(position)), 1), size - 3);
+        double t = position - m;
+        double c0 = data[m - 1].real(), c1 = data[m].real(), c2 = data[m + 1].real(), c3 = data[m + 2].real();
+        double call = -t * (t - 1.0) * (t - 2.0) / 6.0 * c0 + (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0 * c1 -
+                      (t + 1.0) * t * (t - 2.0) / 2.0 * c2 + (t + 1.0) * t * (t - 1.0) / 6.0 * c3;
+        prices[q] = quotes[q].isCall ? call : call - discountedSpot + strike * discount;
+    }
+}
+
+// COS : la densit de y = ln(S_T / K) = ln(S_0 / K) + ln(S_T / S_0) est dveloppe en cosinus
+// sur [a, b], intervalle commun  tous les strikes du groupe ; les coefficients du payoff put
+// ( un facteur K prs) et les valeurs de la fonction caractristique sont partags
+template <typename Model>
+void FourierPricer::priceCos(const Model& model, const VolQuote* quotes, double* prices, std::size_t n) const {
+    const double maturity = quotes[0].maturity;
+    const double discount = std::exp(-model.rate * maturity);
+    const double discountedSpot = model.spot * std::exp(-model.dividend * maturity);
+
+    // Cumulants du log-rendement par diffrences finies de ln E[e^{h R}] = ln phi_R(-i h)
+    const double h = 0.05;
+    auto logMoment = [&](double x) { return std::log(returnCharacteristicFunction(model, Complex(0.0, -x), maturity).real()); };
+    double fm2 = logMoment(-2.0 * h), fm1 = logMoment(-h), fp1 = logMoment(h), fp2 = logMoment(2.0 * h);
+    double c1 = (fp1 - fm1) / (2.0 * h);
+    double c2 = (fp1 + fm1) / (h * h);
+    double c4 = (fp2 - 4.0 * fp1 - 4.0 * fm1 + fm2) / (h * h * h * h);
+    double width = cosTruncation * std::sqrt(std::max(c2 + std::sqrt(std::fabs(c4)), 1e-12));
+
+    // Domaine commun : [min ln(S0/K) + c1 - width, max ln(S0/K) + c1 + width]
+    double xMin = std::log(model.spot / quotes[0].strike), xMax = xMin;
+    for (std::size_t q = 1; q < n; ++q) {
+        double x = std::log(model.spot / quotes[q].strike);
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+    }
+    const double a = xMin + c1 - width;
+    const double b = xMax + c1 + width;
+    const double range = b - a;
+
+    PathArena::Scope scope;
+    Complex* coefficients = scope.allocateAs<Complex>(cosTerms);
+
+    // Coefficients du put : U_k = 2 / (b - a) (psi_k(a, d) - chi_k(a, d)) avec d = min(0, b),
+    // pondrs par phi_R(u_k) ; le payoff (1 - e^y)^+ est nul sur tout le domaine si a >= 0
+    const double upper = std::min(0.0, b);
+    for (int k = 0; k < cosTerms; ++k) {
+        double u = k * M_PI / range;
+        double payoffCoefficient = 0.0;
+        if (a < 0.0) {
+            double sinTerm = std::sin(u * (upper - a)); // sin(k pi (d - a) / (b - a))
+            double cosTerm = std::cos(u * (upper - a));
+            double expUpper = std::exp(upper);
+            double chi = (expUpper * (cosTerm + u * sinTerm) - std::exp(a)) / (1.0 + u * u);
+            double psi = (k > 0) ? sinTerm / u : upper - a;
+            payoffCoefficient = 2.0 / range * (psi - chi);
+        }
+        if (k == 0) payoffCoefficient *= 0.5; // Premier terme de la srie divis par deux
+        coefficients[k] = returnCharacteristicFunction(model, Complex(u, 0.0), maturity) * payoffCoefficient;
+    }
+
+    // Somme par strike : rotation e^{i u_k (x - a)} obtenue par multiplications successives
+    for (std::size_t q = 0; q < n; ++q) {
+        double strike = quotes[q].strike;
+        double x = std::log(model.spot / strike);
+        Complex rotation = std::polar(1.0, M_PI * (x - a) / range);
+        Complex phase(1.0, 0.0);
+        double sum = 0.0;
+        for (int k = 0; k < cosTerms; ++k) {
+            sum += (coefficients[k] * phase).real();
+            phase *= rotation;
+        }
+        // Parit call-put, borne par la valeur intrinsque actualise : loin de la monnaie, les
+        // erreurs d'arrondi de la srie et de la parit ne doivent pas rendre le prix ngatif
+        double forwardIntrinsic = discountedSpot - strike * discount;
+        double put = std::max(strike * discount * sum, std::max(-forwardIntrinsic, 0.0));
+        prices[q] = quotes[q].isCall ? put + forwardIntrinsic : put;
+    }
+}
+
+// Instanciations explicites pour les modles disposant d'une fonction caractristique
+template void FourierPricer::price<BlackScholesModel>(const BlackScholesModel&, const VolQuote*, double*, std::size_t, FourierMethod) const;
+template void FourierPricer::price<BlackScholesModel>(const BlackScholesModel&, const Option* const*, double*, std::size_t, FourierMethod) const;
+template double FourierPricer::price<BlackScholesModel>(const BlackScholesModel&, const Option*, FourierMethod) const;
+template void FourierPricer::price<HestonModel>(const HestonModel&, const VolQuote*, double*, std::size_t, FourierMethod) const;
+template void FourierPricer::price<HestonModel>(const HestonModel&, const Option* const*, double*, std::size_t, FourierMethod) const;
+template double FourierPricer::price<HestonModel>(const HestonModel&, const Option*, FourierMethod) const;
+template void FourierPricer::price<JumpDiffusionModel>(const JumpDiffusionModel&, const VolQuote*, double*, std::size_t, FourierMethod) const;
+template void FourierPricer::price<JumpDiffusionModel>(const JumpDiffusionModel&, const Option* const*, double*, std::size_t, FourierMethod) const;
+template double FourierPricer::price<JumpDiffusionModel>(const JumpDiffusionModel&, const Option*, FourierMethod) const;
@@ -0,0 +1,60 @@
+#ifndef FOURIER_PRICER_H
+#define FOURIER_PRICER_H
+
+#include "ImpliedVolatility.h" // Pour VolQuote
+#include "Option.h"
+#include <cstddef>             // Pour std::size_t
+
+// Mthode de Fourier utilise pour une chane de strikes
+enum class FourierMethod { CarrMadan, Cos };
+
+// Pricer de vanilles europennes pour tout modle dfini par sa fonction caractristique
+//
+// Le modle (BlackScholesModel, HestonModel, JumpDiffusionModel) fournit spot, rate, dividend et
+// characteristicFunction(u, T), fonction caractristique de ln(S_T / F_T). Les cotations
+// conscutives de mme maturit sont traites en un seul passage :
+//  - Carr-Madan : une FFT de fftSize points donne le prix du call amorti sur toute une grille
+//    de log-strikes (O(N log N)), interpole ensuite aux strikes demands ;
+//  - COS (Fang-Oosterlee) : cosTerms valuations de la fonction caractristique, communes  tous
+//    les strikes, puis une somme en O(N) par strike (formule des puts, calls par parit).
+// Un BlackScholesModel avec courbes ou dividendes cash (hasTermStructure) lve std::invalid_argument :
+// sa fonction caractristique ne porte que sur les paramtres scalaires.
+class FourierPricer {
+public:
+    int fftSize;          // Nombre de points de la FFT (puissance de 2)
+    double fftSpacing;    // Pas eta de la grille en frquence (le pas en log-strike vaut 2 pi / (N eta))
+    double dampingFactor; // Facteur d'amortissement alpha de Carr-Madan
+    int cosTerms;         // Nombre de termes de la srie COS
+    double cosTruncation; // Demi-largeur L du domaine COS, en carts-types du log-rendement
+
+    // Constructeur ; lve std::invalid_argument si fftSize n'est pas une puissance de 2 au moins gale  4
+    // ou si fftSpacing, dampingFactor, cosTerms ou cosTruncation ne sont pas strictement positifs
+    FourierPricer(int fftSize_ = 4096, double fftSpacing_ = 0.25, double dampingFactor_ = 1.5,
+                  int cosTerms_ = 256, double cosTruncation_ = 12.0);
+
+    // Prix de n cotations (strike, maturit, call/put) ; prices[i] correspond  quotes[i]
+    template <typename Model>
+    void price(const Model& model, const VolQuote* quotes, double* prices, std::size_t n,
+               FourierMethod method = FourierMethod::Cos) const;
+
+    // Prix d'une chane de CallOption/PutOption (regroupes par maturit)
+    // Lve std::invalid_argument pour une option qui n'est ni un call ni un put
+    template <typename Model>
+    void price(const Model& model, const Option* const* options, double* prices, std::size_t n,
+               FourierMethod method = FourierMethod::Cos) const;
+
+    // Prix d'un seul call ou put
+    template <typename Model>
+    double price(const Model& model, const Option* option, FourierMethod method = FourierMethod::Cos) const;
+
+private:
+    // Cotations de mme maturit par Carr-Madan
+    template <typename Model>
+    void priceCarrMadan(const Model& model, const VolQuote* quotes, double* prices, std::size_t n) const;
+
+    // Cotations de mme maturit par la mthode COS
+    template <typename Model>
+    void priceCos(const Model& model, const VolQuote* quotes, double* prices, std::size_t n) const;
+};
+
+#endif // FOURIER_PRICER_H
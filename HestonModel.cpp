@@ -0,0 +1,199 @@
+#include "HestonModel.h"
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "Parallel.h"           // Pour parallelFor
+#include "PathArena.h"          // Mmoire de travail (noeuds de quadrature, tat des trajectoires)
+#include <algorithm>            // Pour std::min et std::max
+#include <cfloat>               // Pour DBL_MIN et DBL_EPSILON
+#include <cmath>                // Pour std::exp, std::log, std::sqrt, std::cos, std::sin, std::fabs
+#include <stdexcept>            // Pour std::invalid_argument
+
+// Quadrature de Gauss-Legendre composite : PANELS panneaux de 8 noeuds sur [0, uMax], de bornes
+// uMax (p / PANELS)^2 pour rsoudre le pic de 1 / (u^2 + 1/4) en 0 sans gaspiller de noeuds dans la queue
+static const int GAUSS_POINTS = 8;
+static const int PANELS = 64;
+static const double GAUSS_NODES[GAUSS_POINTS / 2] = {
+    0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363};
+static const double GAUSS_WEIGHTS[GAUSS_POINTS / 2] = {
+    0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+
+const int HestonModel::BLOCK_PATHS;
+
+// Constructeur
+HestonModel::HestonModel(double spot_, double rate_, double dividend_, double initialVariance_,
+                         double meanReversion_, double longTermVariance_, double volOfVol_, double correlation_)
+    : spot(spot_), rate(rate_), dividend(dividend_), initialVariance(initialVariance_),
+      meanReversion(meanReversion_), longTermVariance(longTermVariance_), volOfVol(volOfVol_),
+      correlation(correlation_) {
+    // Le schma QE et la fonction caractristique divisent par kappa et par xi
+    if (!(initialVariance >= 0.0) || !(longTermVariance >= 0.0) || !(meanReversion > 0.0) || !(volOfVol > 0.0) ||
+        !(std::fabs(correlation) <= 1.0)) {
+        throw std::invalid_argument(
+            "Heston model requires v0 >= 0, theta >= 0, kappa > 0, volOfVol > 0 and |correlation| <= 1.");
+    }
+}
+
+// Fonction caractristique de X = ln(S_T / F_T) : E[exp(i u X)] = exp(C + D v0)
+std::complex<double> HestonModel::characteristicFunction(std::complex<double> u, double maturity) const {
+    const std::complex<double> i(0.0, 1.0);
+    const double xi2 = volOfVol * volOfVol;
+    std::complex<double> beta = meanReversion - correlation * volOfVol * i * u;
+    std::complex<double> d = std::sqrt(beta * beta + xi2 * (i * u + u * u));
+    std::complex<double> g = (beta - d) / (beta + d);
+    std::complex<double> e = std::exp(-d * maturity);
+    std::complex<double> c = meanReversion * longTermVariance / xi2 *
+                             ((beta - d) * maturity - 2.0 * std::log((1.0 - g * e) / (1.0 - g)));
+    std::complex<double> dTerm = (beta - d) / xi2 * (1.0 - e) / (1.0 - g * e);
+    return std::exp(c + dTerm * initialVariance);
+}
+
+// Prix d'une seule option : cas particulier de la version batch
+double HestonModel::priceAnalytic(const Option* option, bool isCall) const {
+    VolQuote quote{option->strike, option->maturity, 0.0, isCall};
+    double price;
+    priceSameMaturity(&quote, &price, 1, 1);
+    return price;
+}
+
+// Dcoupe en groupes de cotations conscutives de mme maturit
+void HestonModel::priceAnalytic(const VolQuote* quotes, double* prices, std::size_t n, unsigned numThreads) const {
+    std::size_t begin = 0;
+    while (begin < n) {
+        std::size_t end = begin + 1;
+        while (end < n && quotes[end].maturity == quotes[begin].maturity) ++end;
+        priceSameMaturity(quotes + begin, prices + begin, end - begin, numThreads);
+        begin = end;
+    }
+}
+
+// Formule de Lewis : C = S e^{-qT} - K e^{-rT} e^{x/2} / pi * int_0^inf Re[e^{iux} phi(u - i/2)] / (u^2 + 1/4) du
+// avec x = ln(F / K). Les poids a_k, b_k ne dpendent que de la maturit ; pour chaque strike
+// l'intgrale vaut sum_k a_k cos(u_k x) - b_k sin(u_k x)
+void HestonModel::priceSameMaturity(const VolQuote* quotes, double* prices, std::size_t n,
+                                    unsigned numThreads) const {
+    const double maturity = quotes[0].maturity;
+    const int numNodes = GAUSS_POINTS * PANELS;
+
+    // Borne d'intgration : dcroissance gaussienne (petits u) et exponentielle (queue de Heston)
+    double kt = meanReversion * maturity;
+    double averageVariance = longTermVariance +
+                             (initialVariance - longTermVariance) * (kt > 1e-8 ? (1.0 - std::exp(-kt)) / kt : 1.0);
+    double gaussianBound = std::sqrt(2.0 * 37.0 / std::max(averageVariance * maturity, 1e-8));
+    double tailBound = 37.0 * volOfVol /
+                       std::max((initialVariance + meanReversion * longTermVariance * maturity) *
+                                    std::sqrt(std::max(1.0 - correlation * correlation, 1e-4)),
+                                1e-8);
+    double uMax = std::min(std::max(gaussianBound, tailBound), 2000.0);
+
+    PathArena::Scope scope;
+    double* nodes = scope.allocate(numNodes);
+    double* cosWeights = scope.allocate(numNodes);
+    double* sinWeights = scope.allocate(numNodes);
+
+    // valuations de la fonction caractristique (partages par tous les strikes)
+    for (int p = 0; p < PANELS; ++p) {
+        double left = uMax * p * p / (PANELS * PANELS);
+        double right = uMax * (p + 1) * (p + 1) / (PANELS * PANELS);
+        double center = 0.5 * (left + right);
+        double halfWidth = 0.5 * (right - left);
+        for (int g = 0; g < GAUSS_POINTS; ++g) {
+            double node = (g < GAUSS_POINTS / 2) ? -GAUSS_NODES[GAUSS_POINTS / 2 - 1 - g]
+                                                 : GAUSS_NODES[g - GAUSS_POINTS / 2];
+            double weight = (g < GAUSS_POINTS / 2) ? GAUSS_WEIGHTS[GAUSS_POINTS / 2 - 1 - g]
+                                                   : GAUSS_WEIGHTS[g - GAUSS_POINTS / 2];
+            int k = p * GAUSS_POINTS + g;
+            double u = center + halfWidth * node;
+            std::complex<double> phi = characteristicFunction(std::complex<double>(u, -0.5), maturity);
+            double w = halfWidth * weight / (u * u + 0.25);
+            nodes[k] = u;
+            cosWeights[k] = w * phi.real();
+            sinWeights[k] = w * phi.imag();
+        }
+    }
+
+    const double discountedSpot = spot * std::exp(-dividend * maturity);
+    const double discount = std::exp(-rate * maturity);
+    const double forward = discountedSpot / discount;
+
+    // Sommes par strike, rparties sur plusieurs threads
+    parallelFor(n, 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t q = begin; q < end; ++q) {
+            double strike = quotes[q].strike;
+            double x = std::log(forward / strike);
+            double integral = 0.0;
+            for (int k = 0; k < numNodes; ++k) {
+                double ux = nodes[k] * x;
+                integral += cosWeights[k] * std::cos(ux) - sinWeights[k] * std::sin(ux);
+            }
+            double call = discountedSpot - strike * discount * std::exp(0.5 * x) * integral / M_PI;
+            prices[q] = quotes[q].isCall ? call : call - discountedSpot + strike * discount; // Parit call-put
+        }
+    }, numThreads);
+}
+
+// Schma QE d'Andersen, appliqu pas par pas  un bloc de trajectoires
+void HestonModel::simulate(int numPaths, int steps, double maturity, std::mt19937& rng,
+                           const PathBlockVisitor& visit, unsigned numThreads) const {
+    const double dt = maturity / steps;
+
+    // Constantes du schma
+    const double decay = std::exp(-meanReversion * dt);
+    const double xi2 = volOfVol * volOfVol;
+    const double varianceCoeff1 = xi2 * decay * (1.0 - decay) / meanReversion;
+    const double varianceCoeff2 = longTermVariance * xi2 * (1.0 - decay) * (1.0 - decay) / (2.0 * meanReversion);
+    const double k0 = -correlation * meanReversion * longTermVariance / volOfVol * dt;
+    const double k1 = 0.5 * dt * (meanReversion * correlation / volOfVol - 0.5) - correlation / volOfVol;
+    const double k2 = 0.5 * dt * (meanReversion * correlation / volOfVol - 0.5) + correlation / volOfVol;
+    const double k3 = 0.5 * dt * (1.0 - correlation * correlation);
+    const double drift = (rate - dividend) * dt;
+    const double logSpot0 = std::log(spot);
+
+    simulateBlocks(numPaths, steps, BLOCK_PATHS, spot, rng,
+                   [&](double* block, std::size_t pitch, int count, std::mt19937& blockRng) {
+        PathArena::Scope scope; // Tampons du bloc, rendus  la fin du bloc
+        double* logSpot = scope.allocate(count);
+        double* variance = scope.allocate(count);
+        double* uniforms = scope.allocate(count);
+        double* varianceNormals = scope.allocate(count);
+        double* spotNormals = scope.allocate(count);
+        std::uniform_real_distribution<> uniform(DBL_MIN, 1.0);
+        std::fill(logSpot, logSpot + count, logSpot0);
+        std::fill(variance, variance + count, initialVariance);
+
+        for (int j = 0; j < steps; ++j) {
+            // Uniforme et normale de la variance (mme tirage), normale indpendante du spot
+            for (int i = 0; i < count; ++i) uniforms[i] = uniform(blockRng);
+            NormalDistribution::inverseCdfFast(uniforms, varianceNormals, count);
+            NormalDistribution::sample(blockRng, spotNormals, count);
+
+            double* next = block + static_cast<std::size_t>(j + 1) * pitch;
+            for (int i = 0; i < count; ++i) {
+                double v = variance[i];
+                double mean = longTermVariance + (v - longTermVariance) * decay;
+                double psi = (v * varianceCoeff1 + varianceCoeff2) / (mean * mean);
+
+                // Branche quadratique (psi <= 1.5)
+                double inversePsi = 2.0 / psi;
+                double b2 = inversePsi - 1.0 + std::sqrt(inversePsi) * std::sqrt(std::max(inversePsi - 1.0, 0.0));
+                double a = mean / (1.0 + b2);
+                double root = std::sqrt(b2) + varianceNormals[i];
+                double quadratic = a * root * root;
+
+                // Branche exponentielle (psi > 1.5) : masse en 0 de probabilit p
+                double p = (psi - 1.0) / (psi + 1.0);
+                double u = std::min(uniforms[i], 1.0 - DBL_EPSILON);
+                double exponential = u <= p ? 0.0 : std::log((1.0 - p) / (1.0 - u)) * mean / (1.0 - p);
+
+                // Moyenne nulle (v = theta = 0) : la variance reste en 0
+                double vNext = !(mean > 0.0) ? 0.0 : psi <= 1.5 ? quadratic : exponential;
+                logSpot[i] += drift + k0 + k1 * v + k2 * vNext + std::sqrt(k3 * (v + vNext)) * spotNormals[i];
+                variance[i] = vNext;
+                next[i] = std::exp(logSpot[i]);
+            }
+        }
+    }, visit, numThreads);
+}
+
+// Recopie des blocs dans la matrice
+void HestonModel::simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads) const {
+    simulate(paths.numPaths(), paths.numSteps(), maturity, rng, copyBlocksTo(paths), numThreads);
+}
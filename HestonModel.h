@@ -0,0 +1,63 @@
+#ifndef HESTON_MODEL_H
+#define HESTON_MODEL_H
+
+#include "ImpliedVolatility.h" // Pour VolQuote
+#include "Option.h"
+#include "PathMatrix.h"
+#include <complex>             // Pour la fonction caractristique
+#include <cstddef>             // Pour std::size_t
+#include <random>              // Pour std::mt19937
+
+// Modle  volatilit stochastique de Heston
+//   dS = (r - q) S dt + sqrt(v) S dW1
+//   dv = kappa (theta - v) dt + xi sqrt(v) dW2,  d<W1, W2> = rho dt
+class HestonModel {
+public:
+    double spot;             // Prix initial de l'actif sous-jacent
+    double rate;             // Taux sans risque
+    double dividend;         // Taux de dividende
+    double initialVariance;  // Variance initiale v0
+    double meanReversion;    // Vitesse de retour  la moyenne kappa
+    double longTermVariance; // Variance de long terme theta
+    double volOfVol;         // Volatilit de la variance xi
+    double correlation;      // Corrlation rho entre le sous-jacent et la variance
+
+    // Constructeur
+    // Lve std::invalid_argument si v0 < 0, theta < 0, kappa <= 0, xi <= 0 ou |rho| > 1
+    HestonModel(double spot_, double rate_, double dividend_, double initialVariance_, double meanReversion_,
+                double longTermVariance_, double volOfVol_, double correlation_);
+
+    // Prix semi-analytique d'un call ou d'un put europen (formule de Lewis, quadrature de Fourier)
+    double priceAnalytic(const Option* option, bool isCall) const;
+
+    // Version batch pour la calibration : prices[i] est le prix modle de la cotation i
+    // La fonction caractristique ne dpend que de la maturit : elle est value une seule fois
+    // par groupe de cotations conscutives de mme maturit, puis chaque strike ne cote qu'une
+    // somme de cosinus/sinus sur les noeuds de quadrature (strikes rpartis sur plusieurs threads)
+    void priceAnalytic(const VolQuote* quotes, double* prices, std::size_t n, unsigned numThreads = 0) const;
+
+    // Fonction caractristique de ln(S_T / F_T) (forme "little trap" d'Albrecher et al.),
+    // value en un argument complexe
+    std::complex<double> characteristicFunction(std::complex<double> u, double maturity) const;
+
+    // Trajectoires par bloc de simulation (un gnrateur par bloc)
+    static const int BLOCK_PATHS = 1024;
+
+    // Simule numPaths trajectoires de steps pas sur [0, maturity] par le schma QE d'Andersen
+    // (variance quadratique-exponentielle, log-spot discrtis avec gamma1 = gamma2 = 1/2).
+    // Les trajectoires sont traites par blocs de BLOCK_PATHS en parallle, chaque bloc avec son
+    // propre gnrateur initialis  partir de rng : le rsultat ne dpend pas du nombre de threads.
+    // Chaque bloc est simul dans la mmoire de travail du thread puis pass  visit : la mmoire
+    // utilise ne dpend pas de numPaths
+    void simulate(int numPaths, int steps, double maturity, std::mt19937& rng, const PathBlockVisitor& visit,
+                  unsigned numThreads = 0) const;
+
+    // Mme simulation, recopie dans paths
+    void simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads = 0) const;
+
+private:
+    // Prix de n cotations de mme maturit
+    void priceSameMaturity(const VolQuote* quotes, double* prices, std::size_t n, unsigned numThreads) const;
+};
+
+#endif // HESTON_MODEL_H
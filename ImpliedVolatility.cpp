@@ -0,0 +1,170 @@
+#include "ImpliedVolatility.h"
+#include "NormalDistribution.h" // Fonctions de la loi normale (versions vectorises)
+#include "Parallel.h"           // Pour parallelFor
+#include <algorithm>            // Pour std::min et std::max
+#include <cmath>                // Pour std::exp, std::log, std::sqrt
+#include <limits>               // Pour std::numeric_limits
+#include <stdexcept>            // Pour std::invalid_argument
+
+// Taille des blocs de cotations traits en parallle de donnes
+static const std::size_t BLOCK_SIZE = 64;
+
+// Estimation initiale de Corrado-Miller (formule ferme, exacte  la monnaie forward)
+// callPrice est le prix du call (un put est converti par parit call-put)
+static inline double initialGuess(double callPrice, double discountedSpot, double discountedStrike,
+                                  double maturity, double volMin, double volMax) {
+    double halfMoneyness = 0.5 * (discountedSpot - discountedStrike);
+    double a = callPrice - halfMoneyness;
+    double disc = a * a - 4.0 * halfMoneyness * halfMoneyness / M_PI;
+    double guess = std::sqrt(2.0 * M_PI / maturity) / (discountedSpot + discountedStrike) *
+                   (a + std::sqrt(std::max(disc, 0.0)));
+    guess = std::isfinite(guess) ? guess : 0.2; // Valeur de repli si la formule dgnre
+    return std::min(std::max(guess, std::max(volMin, 1e-3)), volMax);
+}
+
+// Constructeur du solveur
+ImpliedVolatilitySolver::ImpliedVolatilitySolver(double tolerance_, int maxIterations_,
+                                                 double volMin_, double volMax_)
+    : tolerance(tolerance_), maxIterations(maxIterations_), volMin(volMin_), volMax(volMax_) {}
+
+// Volatilit implicite d'une seule option, construite sur priceAnalytic et vegaAnalytic
+double ImpliedVolatilitySolver::solve(const BlackScholesModel& model, const Option* option,
+                                      bool isCall, double marketPrice) const {
+    double adjustedSpot = model.spot - model.cashDividendValue(0.0, option->maturity);
+    double discountedSpot = adjustedSpot * std::exp(-model.dividendIntegral(0.0, option->maturity));
+    double discountedStrike = option->strike * std::exp(-model.rateIntegral(0.0, option->maturity));
+
+    // Bornes de non-arbitrage
+    double lower = isCall ? std::max(discountedSpot - discountedStrike, 0.0)
+                          : std::max(discountedStrike - discountedSpot, 0.0);
+    double upper = isCall ? discountedSpot : discountedStrike;
+    if (!(marketPrice > lower && marketPrice < upper)) {
+        throw std::invalid_argument("Market price outside no-arbitrage bounds in ImpliedVolatilitySolver::solve.");
+    }
+
+    double callPrice = isCall ? marketPrice : marketPrice + discountedSpot - discountedStrike;
+    double sigma = initialGuess(callPrice, discountedSpot, discountedStrike, option->maturity, volMin, volMax);
+    double lo = volMin;
+    double hi = volMax;
+
+    BlackScholesModel trial = model; // Copie du modle dont on fait varier la volatilit (constante)
+    trial.volatilityCurve = TermStructure();
+    for (int it = 0; it < maxIterations; ++it) {
+        trial.volatility = sigma;
+        double diff = trial.priceAnalytic(option, isCall) - marketPrice;
+        if (std::fabs(diff) < tolerance) {
+            break;
+        }
+
+        // Mise  jour de l'encadrement (le prix est croissant en la volatilit)
+        if (diff > 0.0) {
+            hi = sigma;
+        } else {
+            lo = sigma;
+        }
+
+        // Pas de Newton, remplac par une bissection s'il sort de l'encadrement
+        double next = sigma - diff / trial.vegaAnalytic(option);
+        if (!(next > lo && next < hi)) {
+            next = 0.5 * (lo + hi);
+        }
+        sigma = next;
+    }
+
+    return sigma;
+}
+
+// Version batch : les blocs de cotations sont rpartis sur les threads
+void ImpliedVolatilitySolver::solve(const BlackScholesModel& model, const VolQuote* quotes, double* vols,
+                                    std::size_t n, unsigned numThreads) const {
+    parallelFor(n, 16 * BLOCK_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; b += BLOCK_SIZE) {
+            solveBlock(model, quotes + b, vols + b, std::min(BLOCK_SIZE, end - b));
+        }
+    }, numThreads);
+}
+
+// Itrations de Newton synchronises sur un bloc de cotations (structure de tableaux)
+// Chaque itration value prix et vega des cotations actives avec les noyaux vectoriss
+// de NormalDistribution, puis met  jour l'encadrement et la volatilit sans branchement
+void ImpliedVolatilitySolver::solveBlock(const BlackScholesModel& model, const VolQuote* quotes,
+                                         double* vols, std::size_t n) const {
+    double logMoneyness[BLOCK_SIZE], sqrtT[BLOCK_SIZE], carry[BLOCK_SIZE];
+    double discountedSpot[BLOCK_SIZE], discountedStrike[BLOCK_SIZE], sign[BLOCK_SIZE];
+    double target[BLOCK_SIZE], sigma[BLOCK_SIZE], lo[BLOCK_SIZE], hi[BLOCK_SIZE];
+    double d1[BLOCK_SIZE], d2[BLOCK_SIZE], nd1[BLOCK_SIZE], nd2[BLOCK_SIZE], pd1[BLOCK_SIZE];
+    bool active[BLOCK_SIZE];
+
+    // Prcalculs indpendants de la volatilit
+    for (std::size_t i = 0; i < n; ++i) {
+        const VolQuote& q = quotes[i];
+        double adjustedSpot = model.spot - model.cashDividendValue(0.0, q.maturity); // Hors dividendes cash
+        double rateTerm = model.rateIntegral(0.0, q.maturity);
+        double dividendTerm = model.dividendIntegral(0.0, q.maturity);
+        logMoneyness[i] = std::log(adjustedSpot / q.strike);
+        sqrtT[i] = std::sqrt(q.maturity);
+        carry[i] = rateTerm - dividendTerm;
+        discountedSpot[i] = adjustedSpot * std::exp(-dividendTerm);
+        discountedStrike[i] = q.strike * std::exp(-rateTerm);
+        sign[i] = q.isCall ? 1.0 : -1.0;
+        target[i] = q.price;
+
+        double lower = std::max(sign[i] * (discountedSpot[i] - discountedStrike[i]), 0.0);
+        double upper = q.isCall ? discountedSpot[i] : discountedStrike[i];
+        active[i] = q.price > lower && q.price < upper;
+
+        double callPrice = q.isCall ? q.price : q.price + discountedSpot[i] - discountedStrike[i];
+        sigma[i] = active[i] ? initialGuess(callPrice, discountedSpot[i], discountedStrike[i], q.maturity, volMin, volMax)
+                             : std::numeric_limits<double>::quiet_NaN();
+        lo[i] = volMin;
+        hi[i] = volMax;
+    }
+
+    // Indices des cotations encore actives (compacts  chaque itration pour que
+    // les cotations lentes  converger n'imposent pas leur cot  tout le bloc)
+    std::size_t index[BLOCK_SIZE];
+    std::size_t m = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (active[i]) index[m++] = i;
+    }
+
+    for (int it = 0; it < maxIterations && m > 0; ++it) {
+        // d1 et d2 signs (on value N(+-d) directement pour garder la prcision des puts)
+        for (std::size_t k = 0; k < m; ++k) {
+            std::size_t i = index[k];
+            double volSqrtT = sigma[i] * sqrtT[i];
+            double d = (logMoneyness[i] + carry[i]) / volSqrtT + 0.5 * volSqrtT;
+            d1[k] = sign[i] * d;
+            d2[k] = sign[i] * (d - volSqrtT);
+        }
+        NormalDistribution::cdf(d1, nd1, m);
+        NormalDistribution::cdf(d2, nd2, m);
+        NormalDistribution::pdf(d1, pd1, m);
+
+        // Mise  jour de Newton protge par l'encadrement
+        std::size_t stillActive = 0;
+        for (std::size_t k = 0; k < m; ++k) {
+            std::size_t i = index[k];
+            double price = sign[i] * (discountedSpot[i] * nd1[k] - discountedStrike[i] * nd2[k]);
+            double vega = discountedSpot[i] * pd1[k] * sqrtT[i];
+            double diff = price - target[i];
+            bool done = std::fabs(diff) < tolerance;
+
+            double newHi = (diff > 0.0) ? sigma[i] : hi[i];
+            double newLo = (diff > 0.0) ? lo[i] : sigma[i];
+            double next = sigma[i] - diff / vega;
+            next = (next > newLo && next < newHi) ? next : 0.5 * (newLo + newHi);
+
+            sigma[i] = done ? sigma[i] : next;
+            hi[i] = newHi;
+            lo[i] = newLo;
+            index[stillActive] = i;
+            stillActive += done ? 0 : 1;
+        }
+        m = stillActive;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        vols[i] = sigma[i];
+    }
+}
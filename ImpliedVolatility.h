@@ -0,0 +1,48 @@
+#ifndef IMPLIED_VOLATILITY_H
+#define IMPLIED_VOLATILITY_H
+
+#include "BlackScholesModel.h"
+#include "Option.h"
+#include <cstddef> // Pour std::size_t
+
+// Cotation de march d'une option vanille
+struct VolQuote {
+    double strike;   // Prix d'exercice
+    double maturity; // Maturit (en annes)
+    double price;    // Prix de march observ
+    bool isCall;     // true pour un call, false pour un put
+};
+
+// Solveur de volatilit implicite : retrouve la volatilit Black-Scholes
+// qui reproduit un prix de march donn (inverse de priceAnalytic)
+//
+// Mthode : estimation initiale de Corrado-Miller puis itrations de Newton sur le vega,
+// protges par un encadrement [volMin, volMax] (bissection si le pas de Newton en sort)
+class ImpliedVolatilitySolver {
+public:
+    double tolerance;   // Tolrance sur le prix
+    int maxIterations;  // Nombre maximal d'itrations
+    double volMin;      // Borne infrieure de recherche
+    double volMax;      // Borne suprieure de recherche
+
+    // Constructeur
+    ImpliedVolatilitySolver(double tolerance_ = 1e-10, int maxIterations_ = 100,
+                            double volMin_ = 1e-6, double volMax_ = 10.0);
+
+    // Volatilit implicite d'une option vanille  partir de son prix de march
+    // Les paramtres spot, rate et dividend sont lus dans le modle (sa volatilit est ignore)
+    // Lve std::invalid_argument si le prix viole les bornes de non-arbitrage
+    double solve(const BlackScholesModel& model, const Option* option, bool isCall, double marketPrice) const;
+
+    // Version batch : inverse n cotations sur le mme sous-jacent
+    // Les cotations sont traites par blocs (calcul vectoris en structure de tableaux)
+    // rpartis sur plusieurs threads ; vols[i] vaut NaN si la cotation i est hors bornes
+    void solve(const BlackScholesModel& model, const VolQuote* quotes, double* vols, std::size_t n,
+               unsigned numThreads = 0) const;
+
+private:
+    // Traite un bloc de cotations en parallle de donnes (itrations de Newton synchronises)
+    void solveBlock(const BlackScholesModel& model, const VolQuote* quotes, double* vols, std::size_t n) const;
+};
+
+#endif // IMPLIED_VOLATILITY_H
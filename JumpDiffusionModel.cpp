@@ -0,0 +1,180 @@
+#include "JumpDiffusionModel.h"
+#include "BlackScholesModel.h"  // Termes de la srie de Merton
+#include "FourierPricer.h"      // Prix de Kou par la mthode COS
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "PathArena.h"          // Mmoire de travail (sauts par pas, tat des trajectoires)
+#include <algorithm>            // Pour std::fill et std::min
+#include <cfloat>               // Pour DBL_MIN
+#include <cmath>                // Pour std::exp, std::log, std::lgamma, std::sqrt
+#include <stdexcept>            // Pour std::invalid_argument
+
+const int JumpDiffusionModel::BLOCK_PATHS;
+
+// Troncature de la srie de Merton : poids de Poisson ngligeable de part et d'autre du mode
+static const double SERIES_TOLERANCE = 1e-16;
+
+// Paramtres communs aux deux lois de sauts
+static void validateDiffusion(double volatility, double jumpIntensity) {
+    if (!(volatility > 0.0) || !(jumpIntensity >= 0.0)) {
+        throw std::invalid_argument("Jump-diffusion model requires volatility > 0 and jumpIntensity >= 0.");
+    }
+}
+
+JumpDiffusionModel::JumpDiffusionModel()
+    : spot(0.0), rate(0.0), dividend(0.0), volatility(0.0), jumpIntensity(0.0), jumpType(JumpDistribution::Merton),
+      jumpMean(0.0), jumpStdDev(0.0), upProbability(0.0), upRate(0.0), downRate(0.0) {}
+
+JumpDiffusionModel JumpDiffusionModel::merton(double spot, double rate, double volatility, double dividend,
+                                              double jumpIntensity, double jumpMean, double jumpStdDev) {
+    validateDiffusion(volatility, jumpIntensity);
+    if (!(jumpStdDev >= 0.0) || !std::isfinite(jumpMean)) {
+        throw std::invalid_argument("Merton model requires jumpStdDev >= 0 and a finite jumpMean.");
+    }
+    JumpDiffusionModel model;
+    model.spot = spot;
+    model.rate = rate;
+    model.volatility = volatility;
+    model.dividend = dividend;
+    model.jumpIntensity = jumpIntensity;
+    model.jumpType = JumpDistribution::Merton;
+    model.jumpMean = jumpMean;
+    model.jumpStdDev = jumpStdDev;
+    return model;
+}
+
+JumpDiffusionModel JumpDiffusionModel::kou(double spot, double rate, double volatility, double dividend,
+                                           double jumpIntensity, double upProbability, double upRate, double downRate) {
+    validateDiffusion(volatility, jumpIntensity);
+    if (!(upRate > 1.0) || !(downRate > 0.0) || !(upProbability >= 0.0 && upProbability <= 1.0)) {
+        throw std::invalid_argument("Kou model requires upRate > 1, downRate > 0 and 0 <= upProbability <= 1.");
+    }
+    JumpDiffusionModel model;
+    model.spot = spot;
+    model.rate = rate;
+    model.volatility = volatility;
+    model.dividend = dividend;
+    model.jumpIntensity = jumpIntensity;
+    model.jumpType = JumpDistribution::Kou;
+    model.upProbability = upProbability;
+    model.upRate = upRate;
+    model.downRate = downRate;
+    return model;
+}
+
+double JumpDiffusionModel::jumpCompensator() const {
+    if (jumpType == JumpDistribution::Merton) {
+        return std::exp(jumpMean + 0.5 * jumpStdDev * jumpStdDev) - 1.0;
+    }
+    return upProbability * upRate / (upRate - 1.0) + (1.0 - upProbability) * downRate / (downRate + 1.0) - 1.0;
+}
+
+// ln phi(u) = T [-i u (sigma^2 / 2 + lambda kappa) - sigma^2 u^2 / 2 + lambda (phi_J(u) - 1)]
+std::complex<double> JumpDiffusionModel::characteristicFunction(std::complex<double> u, double maturity) const {
+    const std::complex<double> i(0.0, 1.0);
+    std::complex<double> jumpTransform;
+    if (jumpType == JumpDistribution::Merton) {
+        jumpTransform = std::exp(i * u * jumpMean - 0.5 * jumpStdDev * jumpStdDev * u * u);
+    } else {
+        jumpTransform = upProbability * upRate / (upRate - i * u) + (1.0 - upProbability) * downRate / (downRate + i * u);
+    }
+    double variance = volatility * volatility;
+    return std::exp(maturity * (-i * u * (0.5 * variance + jumpIntensity * jumpCompensator()) -
+                                0.5 * variance * u * u + jumpIntensity * (jumpTransform - 1.0)));
+}
+
+// Merton : C = sum_n e^{-lambda' T} (lambda' T)^n / n! BS(r_n, sigma_n), avec lambda' = lambda (1 + kappa),
+// r_n = r - lambda kappa + n ln(1 + kappa) / T et sigma_n^2 = sigma^2 + n delta^2 / T
+// La somme part du mode de la loi de Poisson, dont le poids est calcul en logarithme (e^{-lambda' T}
+// seul est nul ds lambda' T > 745), et s'tend des deux cts jusqu' des poids ngligeables
+double JumpDiffusionModel::priceAnalytic(const Option* option, bool isCall) const {
+    const double maturity = option->maturity;
+    if (jumpType == JumpDistribution::Kou) {
+        VolQuote quote{option->strike, maturity, 0.0, isCall};
+        double price;
+        FourierPricer().price(*this, &quote, &price, 1, FourierMethod::Cos);
+        return price;
+    }
+
+    const double kappa = jumpCompensator();
+    const double intensity = jumpIntensity * (1.0 + kappa) * maturity;
+    const double logJump = jumpMean + 0.5 * jumpStdDev * jumpStdDev; // ln(1 + kappa)
+    auto term = [&](double n) {
+        double termRate = rate - jumpIntensity * kappa + n * logJump / maturity;
+        double termVol = std::sqrt(volatility * volatility + n * jumpStdDev * jumpStdDev / maturity);
+        return BlackScholesModel(spot, termRate, termVol, dividend).priceAnalytic(option, isCall);
+    };
+
+    const double mode = std::floor(intensity);
+    const double modeWeight = mode == 0.0 ? std::exp(-intensity)
+                                          : std::exp(-intensity + mode * std::log(intensity) - std::lgamma(mode + 1.0));
+    double price = modeWeight * term(mode);
+    double weight = modeWeight;
+    for (double n = mode + 1.0; weight >= SERIES_TOLERANCE; n += 1.0) { // Au-dessus du mode
+        weight *= intensity / n;
+        price += weight * term(n);
+    }
+    weight = modeWeight;
+    for (double n = mode - 1.0; n >= 0.0 && weight >= SERIES_TOLERANCE; n -= 1.0) { // En dessous du mode
+        weight *= (n + 1.0) / intensity;
+        price += weight * term(n);
+    }
+    return price;
+}
+
+double JumpDiffusionModel::sampleJump(std::mt19937& rng) const {
+    if (jumpType == JumpDistribution::Merton) {
+        double z;
+        NormalDistribution::sample(rng, &z, 1);
+        return jumpMean + jumpStdDev * z;
+    }
+    std::uniform_real_distribution<> uniform(DBL_MIN, 1.0);
+    double direction = uniform(rng);
+    double magnitude = -std::log(uniform(rng));
+    return direction < upProbability ? magnitude / upRate : -magnitude / downRate;
+}
+
+// Log-spot : x += (r - q - lambda kappa - sigma^2 / 2) dt + sigma sqrt(dt) Z + (somme des sauts du pas)
+void JumpDiffusionModel::simulate(int numPaths, int steps, double maturity, std::mt19937& rng,
+                                  const PathBlockVisitor& visit, unsigned numThreads) const {
+    const double dt = maturity / steps;
+    const double drift = (rate - dividend - jumpIntensity * jumpCompensator() - 0.5 * volatility * volatility) * dt;
+    const double diffusion = volatility * std::sqrt(dt);
+    const double logSpot0 = std::log(spot);
+
+    simulateBlocks(numPaths, steps, BLOCK_PATHS, spot, rng,
+                   [&](double* block, std::size_t pitch, int count, std::mt19937& blockRng) {
+        PathArena::Scope scope; // Tampons du bloc, rendus  la fin du bloc
+        double* logSpot = scope.allocate(count);
+        double* normals = scope.allocate(count);
+        double* jumps = scope.allocate(static_cast<std::size_t>(steps) * count); // Somme des sauts par pas
+        std::exponential_distribution<> waiting(jumpIntensity > 0.0 ? jumpIntensity : 1.0);
+        std::fill(logSpot, logSpot + count, logSpot0);
+
+        // Dates de saut exactes (en moyenne lambda T par trajectoire), ranges dans leur pas
+        std::fill(jumps, jumps + static_cast<std::size_t>(steps) * count, 0.0);
+        if (jumpIntensity > 0.0) {
+            for (int i = 0; i < count; ++i) {
+                for (double t = waiting(blockRng); t < maturity; t += waiting(blockRng)) {
+                    int j = std::min(static_cast<int>(t / dt), steps - 1);
+                    jumps[static_cast<std::size_t>(j) * count + i] += sampleJump(blockRng);
+                }
+            }
+        }
+
+        // Avance des trajectoires pas par pas, sans branchement par trajectoire
+        for (int j = 0; j < steps; ++j) {
+            NormalDistribution::sample(blockRng, normals, count);
+            const double* stepJumps = jumps + static_cast<std::size_t>(j) * count;
+            double* next = block + static_cast<std::size_t>(j + 1) * pitch;
+            for (int i = 0; i < count; ++i) {
+                logSpot[i] += drift + diffusion * normals[i] + stepJumps[i];
+                next[i] = std::exp(logSpot[i]);
+            }
+        }
+    }, visit, numThreads);
+}
+
+// Recopie des blocs dans la matrice
+void JumpDiffusionModel::simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads) const {
+    simulate(paths.numPaths(), paths.numSteps(), maturity, rng, copyBlocksTo(paths), numThreads);
+}
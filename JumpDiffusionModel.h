@@ -0,0 +1,74 @@
+#ifndef JUMP_DIFFUSION_MODEL_H
+#define JUMP_DIFFUSION_MODEL_H
+
+#include "Option.h"
+#include "PathMatrix.h"
+#include <complex> // Pour la fonction caractristique
+#include <random>  // Pour std::mt19937
+
+// Loi des sauts du log-spot
+enum class JumpDistribution { Merton, Kou };
+
+// Modle de diffusion  sauts
+//   dS / S- = (r - q - lambda kappa) dt + sigma dW + (e^J - 1) dN,  N de Poisson d'intensit lambda
+// Merton : J ~ N(jumpMean, jumpStdDev^2)
+// Kou    : J ~ Exp(upRate) avec probabilit upProbability, -Exp(downRate) sinon
+// kappa = E[e^J] - 1 compense la drive pour que S actualis soit une martingale
+class JumpDiffusionModel {
+public:
+    double spot;           // Prix initial de l'actif sous-jacent
+    double rate;           // Taux sans risque
+    double dividend;       // Taux de dividende
+    double volatility;     // Volatilit de la partie diffusive
+    double jumpIntensity;  // Nombre moyen de sauts par an (lambda)
+    JumpDistribution jumpType;
+    double jumpMean;       // Merton : moyenne du log-saut
+    double jumpStdDev;     // Merton : cart-type du log-saut
+    double upProbability;  // Kou : probabilit d'un saut  la hausse
+    double upRate;         // Kou : paramtre eta1 (> 1) des sauts  la hausse
+    double downRate;       // Kou : paramtre eta2 (> 0) des sauts  la baisse
+
+    // Modle de Merton (sauts lognormaux)
+    // Lve std::invalid_argument si volatility <= 0, jumpIntensity < 0 ou jumpStdDev < 0
+    static JumpDiffusionModel merton(double spot, double rate, double volatility, double dividend,
+                                     double jumpIntensity, double jumpMean, double jumpStdDev);
+
+    // Modle de Kou (sauts double-exponentiels)
+    // Lve std::invalid_argument si volatility <= 0, jumpIntensity < 0, upRate <= 1 (E[e^J] infini),
+    // downRate <= 0 ou upProbability hors de [0, 1]
+    static JumpDiffusionModel kou(double spot, double rate, double volatility, double dividend,
+                                  double jumpIntensity, double upProbability, double upRate, double downRate);
+
+    // Compensateur kappa = E[e^J] - 1
+    double jumpCompensator() const;
+
+    // Prix d'un call ou d'un put europen
+    // Merton : srie de prix de Black-Scholes conditionns au nombre de sauts (forme ferme)
+    // Kou    : mthode COS sur la fonction caractristique (forme ferme en Fourier)
+    double priceAnalytic(const Option* option, bool isCall) const;
+
+    // Fonction caractristique de ln(S_T / F_T), value en un argument complexe (pricers de Fourier)
+    std::complex<double> characteristicFunction(std::complex<double> u, double maturity) const;
+
+    // Trajectoires par bloc de simulation (un gnrateur et un tableau de sauts par bloc)
+    static const int BLOCK_PATHS = 256;
+
+    // Simule numPaths trajectoires de steps pas sur [0, maturity]. Pour chaque trajectoire, les dates
+    // de saut exactes sont tires (intervalles exponentiels) et leurs tailles cumules par pas ;
+    // l'avance d'un pas est ensuite la mme boucle sans branchement pour toutes les trajectoires du
+    // bloc. Blocs de trajectoires en parallle, un gnrateur par bloc initialis  partir de rng ;
+    // chaque bloc est pass  visit depuis la mmoire de travail du thread
+    void simulate(int numPaths, int steps, double maturity, std::mt19937& rng, const PathBlockVisitor& visit,
+                  unsigned numThreads = 0) const;
+
+    // Mme simulation, recopie dans paths
+    void simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads = 0) const;
+
+private:
+    JumpDiffusionModel();
+
+    // Taille d'un saut du log-spot
+    double sampleJump(std::mt19937& rng) const;
+};
+
+#endif // JUMP_DIFFUSION_MODEL_H
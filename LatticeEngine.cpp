@@ -0,0 +1,208 @@
+#include "LatticeEngine.h"
+#include "CallOption.h"
+#include "PathArena.h" // Tableau glissant de l'induction arrire
+#include "PutOption.h"
+#include <algorithm>   // Pour std::max
+#include <cmath>       // Pour std::exp, std::log, std::sqrt, std::pow, std::copysign
+#include <stdexcept>   // Pour std::invalid_argument
+
+// Inversion de Peizer-Pratt (mthode 2) : probabilit binomiale associe  z pour n pas
+static double peizerPratt(double z, int n) {
+    double t = z / (n + 1.0 / 3.0 + 0.1 / (n + 1.0));
+    return 0.5 + std::copysign(0.5 * std::sqrt(1.0 - std::exp(-t * t * (n + 1.0 / 6.0))), z);
+}
+
+// Combinaison de Richardson de deux estimations  fine et coarse pas (erreur en 1 / pas^order)
+static double extrapolate(double fineValue, int fine, double coarseValue, int coarse, int order) {
+    double wf = std::pow(static_cast<double>(fine), order);
+    double wc = std::pow(static_cast<double>(coarse), order);
+    return (wf * fineValue - wc * coarseValue) / (wf - wc);
+}
+
+// Constructeur du moteur
+LatticeEngine::LatticeEngine(LatticeType type_, int steps_, bool richardson_)
+    : type(type_), steps(steps_), richardson(richardson_) {}
+
+// Call europen ou amricain
+LatticeResult LatticeEngine::price(const BlackScholesModel& model, const CallOption& option, ExerciseStyle style) const {
+    return solve(model, option.strike, option.maturity, OptionType::Call, style);
+}
+
+// Put europen ou amricain
+LatticeResult LatticeEngine::price(const BlackScholesModel& model, const PutOption& option, ExerciseStyle style) const {
+    return solve(model, option.strike, option.maturity, OptionType::Put, style);
+}
+
+// Arbre  steps pas, puis extrapolation de Richardson avec l'arbre  environ steps / 2 pas
+LatticeResult LatticeEngine::solve(const BlackScholesModel& model, double strike, double maturity,
+                                   OptionType optionType, ExerciseStyle style) const {
+    if (maturity <= 0.0 || model.volatility <= 0.0 || model.spot <= 0.0) {
+        throw std::invalid_argument("Maturity, volatility and spot must be positive in LatticeEngine::solve.");
+    }
+    if (model.hasTermStructure()) {
+        throw std::invalid_argument("LatticeEngine uses scalar parameters only: curves and cash dividends are not supported.");
+    }
+    if (steps < 4) {
+        throw std::invalid_argument("At least 4 steps are required in LatticeEngine::solve.");
+    }
+
+    // Leisen-Reimer n'est dfini que pour un nombre impair de pas ; l'erreur de CRR oscille
+    // avec la parit du nombre de pas, les deux arbres extrapols ont donc un nombre de pas pair
+    bool leisenReimer = (type == LatticeType::LeisenReimer);
+    int fine, coarse;
+    if (leisenReimer) {
+        fine = steps | 1;
+        coarse = (fine / 2) | 1;
+    } else if (type == LatticeType::CoxRossRubinstein) {
+        fine = (steps + 3) / 4 * 4;
+        coarse = fine / 2;
+    } else {
+        fine = steps;
+        coarse = fine / 2;
+    }
+
+    auto run = [&](int n) {
+        return (type == LatticeType::Trinomial) ? trinomial(model, strike, maturity, optionType, style, n)
+                                                : binomial(model, strike, maturity, optionType, style, n);
+    };
+
+    LatticeResult fineResult = run(fine);
+    if (!richardson) return fineResult;
+
+    LatticeResult coarseResult = run(coarse);
+    int order = leisenReimer ? 2 : 1;
+    return LatticeResult{extrapolate(fineResult.price, fine, coarseResult.price, coarse, order),
+                         extrapolate(fineResult.delta, fine, coarseResult.delta, coarse, order),
+                         extrapolate(fineResult.gamma, fine, coarseResult.gamma, coarse, order)};
+}
+
+// Arbre binomial recombinant : le noeud (i, j) vaut spot * u^j * d^(i - j)
+LatticeResult LatticeEngine::binomial(const BlackScholesModel& model, double strike, double maturity,
+                                      OptionType optionType, ExerciseStyle style, int n) const {
+    const double dt = maturity / n;
+    const double growth = std::exp((model.rate - model.dividend) * dt);
+    const double discount = std::exp(-model.rate * dt);
+    const double spot = model.spot;
+
+    // Facteurs de hausse/baisse et probabilit risque-neutre
+    double up, down, p;
+    if (type == LatticeType::CoxRossRubinstein) {
+        up = std::exp(model.volatility * std::sqrt(dt));
+        down = 1.0 / up;
+        p = (growth - down) / (up - down);
+    } else {
+        double stdDev = model.volatility * std::sqrt(maturity);
+        double d1 = (std::log(spot / strike) + (model.rate - model.dividend) * maturity) / stdDev + 0.5 * stdDev;
+        double d2 = d1 - stdDev;
+        p = peizerPratt(d2, n);
+        up = growth * peizerPratt(d1, n) / p;
+        down = (growth - p * up) / (1.0 - p);
+    }
+    // Pour CRR, p sort de [0, 1] ds que sigma sqrt(dt) < |r - q| dt (arbre trop grossier) ; pour
+    // Leisen-Reimer, p arrondi  1 rend le facteur de baisse indfini
+    if (!(p >= 0.0 && p <= 1.0) || !(down > 0.0 && up > down)) {
+        throw std::invalid_argument("LatticeEngine binomial probabilities leave [0, 1]: increase steps or volatility.");
+    }
+    const double pUp = discount * p;
+    const double pDown = discount * (1.0 - p);
+    const double ratio = up / down;
+    const double inverseDown = 1.0 / down;
+    const double sign = (optionType == OptionType::Call) ? 1.0 : -1.0;
+    const bool american = (style == ExerciseStyle::American);
+
+    PathArena::Scope scope;
+    double* values = scope.allocate(n + 1);
+
+    // Payoff  maturit
+    double base = spot * std::pow(down, n); // Noeud le plus bas du pas courant
+    double s = base;
+    for (int j = 0; j <= n; ++j) {
+        values[j] = std::max(sign * (s - strike), 0.0);
+        s *= ratio;
+    }
+
+    // Induction arrire dans le tableau glissant (values[j] lit values[j] et values[j + 1])
+    double step1[2], step2[3];
+    for (int i = n - 1; i >= 0; --i) {
+        base *= inverseDown;
+        if (american) {
+            s = base;
+            for (int j = 0; j <= i; ++j) {
+                values[j] = std::max(pUp * values[j + 1] + pDown * values[j], sign * (s - strike));
+                s *= ratio;
+            }
+        } else {
+            for (int j = 0; j <= i; ++j) values[j] = pUp * values[j + 1] + pDown * values[j];
+        }
+        if (i == 2) std::copy(values, values + 3, step2);
+        if (i == 1) std::copy(values, values + 2, step1);
+    }
+
+    // Delta au pas 1, gamma au pas 2
+    double delta = (step1[1] - step1[0]) / (spot * (up - down));
+    double sdd = spot * down * down, sud = spot * up * down, suu = spot * up * up;
+    double gamma = ((step2[2] - step2[1]) / (suu - sud) - (step2[1] - step2[0]) / (sud - sdd)) / (0.5 * (suu - sdd));
+    return LatticeResult{values[0], delta, gamma};
+}
+
+// Arbre trinomial (Boyle) : le noeud (i, m) vaut spot * u^(m - i), m = 0..2i
+LatticeResult LatticeEngine::trinomial(const BlackScholesModel& model, double strike, double maturity,
+                                       OptionType optionType, ExerciseStyle style, int n) const {
+    const double dt = maturity / n;
+    const double discount = std::exp(-model.rate * dt);
+    const double spot = model.spot;
+
+    // Probabilits obtenues en composant deux demi-pas binomiaux
+    const double up = std::exp(model.volatility * std::sqrt(2.0 * dt));
+    const double halfGrowth = std::exp(0.5 * (model.rate - model.dividend) * dt);
+    const double halfUp = std::exp(model.volatility * std::sqrt(0.5 * dt));
+    const double halfDown = 1.0 / halfUp;
+    const double qUp = (halfGrowth - halfDown) / (halfUp - halfDown);
+    const double qDown = (halfUp - halfGrowth) / (halfUp - halfDown);
+    if (!(qUp >= 0.0 && qDown >= 0.0)) {
+        throw std::invalid_argument("LatticeEngine trinomial probabilities leave [0, 1]: increase steps or volatility.");
+    }
+    const double pUp = discount * qUp * qUp;
+    const double pDown = discount * qDown * qDown;
+    const double pMiddle = discount * (1.0 - qUp * qUp - qDown * qDown);
+    const double inverseUp = 1.0 / up;
+    const double sign = (optionType == OptionType::Call) ? 1.0 : -1.0;
+    const bool american = (style == ExerciseStyle::American);
+
+    PathArena::Scope scope;
+    double* values = scope.allocate(2 * n + 1);
+
+    // Payoff  maturit
+    double base = spot * std::pow(inverseUp, n);
+    double s = base;
+    for (int m = 0; m <= 2 * n; ++m) {
+        values[m] = std::max(sign * (s - strike), 0.0);
+        s *= up;
+    }
+
+    // Induction arrire (values[m] lit values[m], values[m + 1] et values[m + 2])
+    for (int i = n - 1; i >= 1; --i) {
+        base *= up;
+        if (american) {
+            s = base;
+            for (int m = 0; m <= 2 * i; ++m) {
+                double continuation = pDown * values[m] + pMiddle * values[m + 1] + pUp * values[m + 2];
+                values[m] = std::max(continuation, sign * (s - strike));
+                s *= up;
+            }
+        } else {
+            for (int m = 0; m <= 2 * i; ++m) {
+                values[m] = pDown * values[m] + pMiddle * values[m + 1] + pUp * values[m + 2];
+            }
+        }
+    }
+
+    // Pas 1 : trois noeuds pour delta et gamma, puis dernier pas vers la racine
+    double sDown = spot * inverseUp, sUp = spot * up;
+    double delta = (values[2] - values[0]) / (sUp - sDown);
+    double gamma = ((values[2] - values[1]) / (sUp - spot) - (values[1] - values[0]) / (spot - sDown)) /
+                   (0.5 * (sUp - sDown));
+    double root = pDown * values[0] + pMiddle * values[1] + pUp * values[2];
+    if (american) root = std::max(root, sign * (spot - strike));
+    return LatticeResult{root, delta, gamma};
+}
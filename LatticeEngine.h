@@ -0,0 +1,62 @@
+#ifndef LATTICE_ENGINE_H
+#define LATTICE_ENGINE_H
+
+#include "BlackScholesModel.h"
+#include "ExerciseStyle.h"
+#include "OptionType.h"
+
+class CallOption;
+class PutOption;
+
+// Type d'arbre
+enum class LatticeType { CoxRossRubinstein, LeisenReimer, Trinomial };
+
+// Rsultat d'un pricing par arbre
+struct LatticeResult {
+    double price; // Prix actualis
+    double delta; // Drive premire par rapport au spot (noeuds des premiers pas)
+    double gamma; // Drive seconde par rapport au spot (noeuds des premiers pas)
+};
+
+// Moteur d'arbres (binomial CRR ou Leisen-Reimer, trinomial) pour les vanilles
+// europennes et amricaines
+//
+// L'induction arrire se fait dans un seul tableau glissant de steps + 1 valeurs (2 steps + 1
+// pour le trinomial) : quelques milliers de pas tiennent dans le cache L1. Les probabilits
+// actualises et les facteurs de hausse/baisse sont calculs une fois ; le spot d'un noeud
+// s'obtient par multiplications successives, sans appel  pow ni tableau de prix.
+// L'extrapolation de Richardson combine les arbres  steps et environ steps / 2 pas
+// (ordre 2 pour Leisen-Reimer, ordre 1 pour CRR et le trinomial).
+// Seuls les paramtres scalaires du modle sont utiliss : un modle avec courbes ou dividendes
+// cash (BlackScholesModel::hasTermStructure) lve std::invalid_argument.
+class LatticeEngine {
+public:
+    LatticeType type; // Type d'arbre
+    int steps;        // Nombre de pas (arrondi au nombre impair suprieur pour Leisen-Reimer,
+                      // au multiple de 4 suprieur pour CRR)
+    bool richardson;  // Extrapolation de Richardson
+
+    // Constructeur
+    LatticeEngine(LatticeType type_ = LatticeType::LeisenReimer, int steps_ = 201, bool richardson_ = true);
+
+    // Prix, delta et gamma d'un call ou d'un put europen ou amricain
+    // Lve std::invalid_argument si une probabilit de l'arbre ( steps ou, avec Richardson,  environ
+    // steps / 2 pas) sort de [0, 1], c'est--dire pour CRR et le trinomial si sigma sqrt(dt) < |r - q| dt
+    LatticeResult price(const BlackScholesModel& model, const CallOption& option, ExerciseStyle style) const;
+    LatticeResult price(const BlackScholesModel& model, const PutOption& option, ExerciseStyle style) const;
+
+private:
+    // Prix avec extrapolation ventuelle
+    LatticeResult solve(const BlackScholesModel& model, double strike, double maturity,
+                        OptionType optionType, ExerciseStyle style) const;
+
+    // Arbre binomial (CRR ou Leisen-Reimer)  n pas
+    LatticeResult binomial(const BlackScholesModel& model, double strike, double maturity,
+                           OptionType optionType, ExerciseStyle style, int n) const;
+
+    // Arbre trinomial  n pas
+    LatticeResult trinomial(const BlackScholesModel& model, double strike, double maturity,
+                            OptionType optionType, ExerciseStyle style, int n) const;
+};
+
+#endif // LATTICE_ENGINE_H
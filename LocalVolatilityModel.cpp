@@ -0,0 +1,204 @@
+#include "LocalVolatilityModel.h"
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "PathArena.h"          // Mmoire de travail (lignes par pas, tat des trajectoires)
+#include <algorithm>            // Pour std::min, std::max et std::upper_bound
+#include <cmath>                // Pour std::exp, std::log, std::sqrt
+#include <stdexcept>            // Pour std::invalid_argument
+
+// Bornes de la variance locale (une nappe avec arbitrage peut donner un dnominateur ngatif)
+static const double MIN_VARIANCE = 1e-4; // Volatilit locale de 1 %
+static const double MAX_VARIANCE = 4.0;  // Volatilit locale de 200 %
+
+const int LocalVolatilityModel::BLOCK_PATHS;
+
+// Drives secondes d'une spline cubique naturelle passant par (x[k], y[k])
+static void splineSecondDerivatives(const double* x, const double* y, int n, double* y2) {
+    std::vector<double> u(n, 0.0);
+    y2[0] = 0.0;
+    for (int k = 1; k < n - 1; ++k) {
+        double ratio = (x[k] - x[k - 1]) / (x[k + 1] - x[k - 1]);
+        double p = ratio * y2[k - 1] + 2.0;
+        y2[k] = (ratio - 1.0) / p;
+        double slope = (y[k + 1] - y[k]) / (x[k + 1] - x[k]) - (y[k] - y[k - 1]) / (x[k] - x[k - 1]);
+        u[k] = (6.0 * slope / (x[k + 1] - x[k - 1]) - ratio * u[k - 1]) / p;
+    }
+    y2[n - 1] = 0.0;
+    for (int k = n - 2; k >= 0; --k) y2[k] = y2[k] * y2[k + 1] + u[k];
+}
+
+// Valeur de la spline en xv, constante au-del des extrmits
+static double splineValue(const double* x, const double* y, const double* y2, int n, double xv) {
+    if (n == 1 || xv <= x[0]) return y[0];
+    if (xv >= x[n - 1]) return y[n - 1];
+    int k = static_cast<int>(std::upper_bound(x, x + n, xv) - x) - 1;
+    double h = x[k + 1] - x[k];
+    double a = (x[k + 1] - xv) / h;
+    double b = (xv - x[k]) / h;
+    return a * y[k] + b * y[k + 1] + ((a * a * a - a) * y2[k] + (b * b * b - b) * y2[k + 1]) * h * h / 6.0;
+}
+
+// Nappe de variance totale w(y, T) : spline en y pour chaque maturit, linaire en T entre deux
+// maturits, volatilit implicite constante avant la premire et aprs la dernire
+struct TotalVarianceSurface {
+    std::vector<double> maturities;
+    std::vector<std::vector<double> > logMoneyness, variance, secondDerivatives;
+
+    double row(int m, double y) const {
+        const int n = static_cast<int>(logMoneyness[m].size());
+        return splineValue(logMoneyness[m].data(), variance[m].data(), secondDerivatives[m].data(), n, y);
+    }
+
+    double operator()(double y, double t) const {
+        const int last = static_cast<int>(maturities.size()) - 1;
+        if (t <= maturities[0]) return row(0, y) * t / maturities[0];
+        if (t >= maturities[last]) return row(last, y) * t / maturities[last];
+        int m = static_cast<int>(std::upper_bound(maturities.begin(), maturities.end(), t) - maturities.begin()) - 1;
+        double weight = (t - maturities[m]) / (maturities[m + 1] - maturities[m]);
+        return (1.0 - weight) * row(m, y) + weight * row(m + 1, y);
+    }
+};
+
+// Construction de la grille de volatilits locales
+LocalVolatilityModel::LocalVolatilityModel(double spot_, double rate_, double dividend_,
+                                           const std::vector<double>& strikes, const std::vector<double>& maturities,
+                                           const std::vector<double>& impliedVols, int spaceNodes_, int timeNodes_,
+                                           double numStdDevs)
+    : spot(spot_), rate(rate_), dividend(dividend_), spaceNodes(spaceNodes_), timeNodes(timeNodes_) {
+    const std::size_t numStrikes = strikes.size();
+    const std::size_t numMaturities = maturities.size();
+    if (numStrikes == 0 || numMaturities == 0 || impliedVols.size() != numStrikes * numMaturities) {
+        throw std::invalid_argument("LocalVolatilityModel requires one implied volatility per strike and maturity.");
+    }
+    for (std::size_t k = 0; k < numStrikes; ++k) {
+        if (!(strikes[k] > (k == 0 ? 0.0 : strikes[k - 1]))) {
+            throw std::invalid_argument("LocalVolatilityModel strikes must be positive and strictly increasing.");
+        }
+    }
+    for (std::size_t m = 0; m < numMaturities; ++m) {
+        if (!(maturities[m] > (m == 0 ? 0.0 : maturities[m - 1]))) {
+            throw std::invalid_argument("LocalVolatilityModel maturities must be positive and strictly increasing.");
+        }
+    }
+    if (spaceNodes < 2 || timeNodes < 2) {
+        throw std::invalid_argument("LocalVolatilityModel grid needs at least two nodes per dimension.");
+    }
+
+    // Variance totale par maturit en fonction du log-moneyness forward
+    TotalVarianceSurface surface;
+    surface.maturities = maturities;
+    double maxVol = 0.0;
+    for (std::size_t m = 0; m < numMaturities; ++m) {
+        double logForward = std::log(spot) + (rate - dividend) * maturities[m];
+        std::vector<double> ys(numStrikes), ws(numStrikes), w2(numStrikes);
+        for (std::size_t k = 0; k < numStrikes; ++k) {
+            double vol = impliedVols[m * numStrikes + k];
+            if (!(vol > 0.0)) {
+                throw std::invalid_argument("LocalVolatilityModel implied volatilities must be positive.");
+            }
+            maxVol = std::max(maxVol, vol);
+            ys[k] = std::log(strikes[k]) - logForward;
+            ws[k] = vol * vol * maturities[m];
+        }
+        splineSecondDerivatives(ys.data(), ws.data(), static_cast<int>(numStrikes), w2.data());
+        surface.logMoneyness.push_back(ys);
+        surface.variance.push_back(ws);
+        surface.secondDerivatives.push_back(w2);
+    }
+
+    // Grille uniforme en (t, ln S)
+    const double horizon = maturities.back();
+    const double halfWidth = numStdDevs * maxVol * std::sqrt(horizon);
+    logSpotMin = std::log(spot) - halfWidth;
+    logSpotStep = 2.0 * halfWidth / (spaceNodes - 1);
+    timeStep = horizon / (timeNodes - 1);
+    volatility.resize(static_cast<std::size_t>(spaceNodes) * timeNodes);
+
+    // Formule de Dupire en variance totale (Gatheral), drives par diffrences centres :
+    // sigma^2 = w_T / (1 - y w_y / w + (-1/4 - 1/w + y^2 / w^2) w_y^2 / 4 + w_yy / 2)
+    const double hy = 1e-3;
+    for (int n = 0; n < timeNodes; ++n) {
+        double t = std::max(n * timeStep, 0.25 * timeStep); // Limite t -> 0 approche
+        double ht = std::min(1e-3, 0.5 * t);
+        double logForward = std::log(spot) + (rate - dividend) * t;
+        double* row = volatility.data() + static_cast<std::size_t>(n) * spaceNodes;
+        for (int i = 0; i < spaceNodes; ++i) {
+            double y = logSpotMin + i * logSpotStep - logForward;
+            double w = surface(y, t);
+            double wUp = surface(y + hy, t), wDown = surface(y - hy, t);
+            double wT = (surface(y, t + ht) - surface(y, t - ht)) / (2.0 * ht);
+            double wY = (wUp - wDown) / (2.0 * hy);
+            double wYY = (wUp - 2.0 * w + wDown) / (hy * hy);
+            double denominator = 1.0 - y * wY / w + 0.25 * (-0.25 - 1.0 / w + y * y / (w * w)) * wY * wY + 0.5 * wYY;
+            double localVariance = (denominator > 0.0 && wT > 0.0) ? wT / denominator : MIN_VARIANCE;
+            row[i] = std::sqrt(std::min(std::max(localVariance, MIN_VARIANCE), MAX_VARIANCE));
+        }
+    }
+}
+
+// Ligne interpole linairement entre les deux dates de grille encadrant t
+void LocalVolatilityModel::rowAt(double t, double* row) const {
+    double position = std::min(std::max(t / timeStep, 0.0), static_cast<double>(timeNodes - 1));
+    int n = std::min(static_cast<int>(position), timeNodes - 2);
+    double weight = position - n;
+    const double* before = volatility.data() + static_cast<std::size_t>(n) * spaceNodes;
+    const double* after = before + spaceNodes;
+    for (int i = 0; i < spaceNodes; ++i) row[i] = before[i] + weight * (after[i] - before[i]);
+}
+
+// Interpolation bilinaire : indices obtenus directement  partir des pas uniformes
+double LocalVolatilityModel::localVolatility(double t, double s) const {
+    double position = std::min(std::max(t / timeStep, 0.0), static_cast<double>(timeNodes - 1));
+    int n = std::min(static_cast<int>(position), timeNodes - 2);
+    double tWeight = position - n;
+    double u = std::min(std::max((std::log(s) - logSpotMin) / logSpotStep, 0.0), static_cast<double>(spaceNodes - 1));
+    int i = std::min(static_cast<int>(u), spaceNodes - 2);
+    double xWeight = u - i;
+    const double* before = volatility.data() + static_cast<std::size_t>(n) * spaceNodes + i;
+    const double* after = before + spaceNodes;
+    double v0 = before[0] + xWeight * (before[1] - before[0]);
+    double v1 = after[0] + xWeight * (after[1] - after[0]);
+    return v0 + tWeight * (v1 - v0);
+}
+
+// Schma d'Euler en log-spot : x += (r - q - sigma^2 / 2) dt + sigma sqrt(dt) Z, sigma = sigma(t_j, S_j)
+void LocalVolatilityModel::simulate(int numPaths, int steps, double maturity, std::mt19937& rng,
+                                    const PathBlockVisitor& visit, unsigned numThreads) const {
+    const double dt = maturity / steps;
+    const double sqrtDt = std::sqrt(dt);
+    const double carry = (rate - dividend) * dt;
+    const double inverseStep = 1.0 / logSpotStep;
+    const double maxPosition = static_cast<double>(spaceNodes - 1);
+    const double logSpot0 = std::log(spot);
+
+    // Lignes de la surface aux dates de simulation, calcules une fois pour toutes les trajectoires
+    PathArena::Scope scope;
+    double* stepRows = scope.allocate(static_cast<std::size_t>(steps) * spaceNodes);
+    for (int j = 0; j < steps; ++j) rowAt(j * dt, stepRows + static_cast<std::size_t>(j) * spaceNodes);
+
+    simulateBlocks(numPaths, steps, BLOCK_PATHS, spot, rng,
+                   [&](double* block, std::size_t pitch, int count, std::mt19937& blockRng) {
+        PathArena::Scope local; // Tampons du bloc, rendus  la fin du bloc
+        double* logSpot = local.allocate(count);
+        double* normals = local.allocate(count);
+        std::fill(logSpot, logSpot + count, logSpot0);
+
+        for (int j = 0; j < steps; ++j) {
+            NormalDistribution::sample(blockRng, normals, count);
+            const double* row = stepRows + static_cast<std::size_t>(j) * spaceNodes;
+            double* next = block + static_cast<std::size_t>(j + 1) * pitch;
+            for (int i = 0; i < count; ++i) {
+                // Indice et poids en ln S sans branchement (bornes par min/max)
+                double u = std::min(std::max((logSpot[i] - logSpotMin) * inverseStep, 0.0), maxPosition);
+                int k = std::min(static_cast<int>(u), spaceNodes - 2);
+                double sigma = row[k] + (u - k) * (row[k + 1] - row[k]);
+                logSpot[i] += carry - 0.5 * sigma * sigma * dt + sigma * sqrtDt * normals[i];
+                next[i] = std::exp(logSpot[i]);
+            }
+        }
+    }, visit, numThreads);
+}
+
+// Recopie des blocs dans la matrice
+void LocalVolatilityModel::simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads) const {
+    simulate(paths.numPaths(), paths.numSteps(), maturity, rng, copyBlocksTo(paths), numThreads);
+}
@@ -0,0 +1,58 @@
+#ifndef LOCAL_VOLATILITY_MODEL_H
+#define LOCAL_VOLATILITY_MODEL_H
+
+#include "PathMatrix.h"
+#include <random> // Pour std::mt19937
+#include <vector> // Pour la grille de volatilits locales
+
+// Modle  volatilit locale de Dupire
+//   dS = (r - q) S dt + sigma(t, S) S dW
+// La surface sigma(t, S) est calcule une seule fois,  la construction,  partir d'une nappe de
+// volatilits implicites (formule de Dupire en variance totale w(y, T) = sigma_imp^2 T,
+// y = ln(K / F_T)), puis stocke sur une grille uniforme en (t, ln S) : une ligne contigu par
+// date. Une recherche se rduit  deux indices calculs (pas de recherche dichotomique) et  une
+// interpolation bilinaire.
+class LocalVolatilityModel {
+public:
+    double spot;     // Prix initial de l'actif sous-jacent
+    double rate;     // Taux sans risque
+    double dividend; // Taux de dividende
+
+    // Construction de la surface  partir de volatilits implicites
+    // impliedVols[m * strikes.size() + k] est la volatilit implicite du strike k  la maturit m.
+    // La grille couvre [0, dernire maturit] en timeNodes dates et ln(spot) +- numStdDevs carts-types
+    // en spaceNodes points. Lve std::invalid_argument pour une nappe mal forme.
+    LocalVolatilityModel(double spot_, double rate_, double dividend_, const std::vector<double>& strikes,
+                         const std::vector<double>& maturities, const std::vector<double>& impliedVols,
+                         int spaceNodes_ = 201, int timeNodes_ = 101, double numStdDevs = 5.0);
+
+    // Volatilit locale en (t, S) par interpolation bilinaire (valeurs du bord hors de la grille)
+    double localVolatility(double t, double s) const;
+
+    // Trajectoires par bloc de simulation (un gnrateur par bloc)
+    static const int BLOCK_PATHS = 1024;
+
+    // Simule numPaths trajectoires de steps pas sur [0, maturity] par un schma d'Euler en log-spot.
+    // Les lignes de la grille sont d'abord interpoles aux dates de simulation : chaque pas ne
+    // cote plus qu'une interpolation linaire en ln S. Blocs de trajectoires en parallle, un
+    // gnrateur par bloc initialis  partir de rng (rsultat indpendant du nombre de threads) ;
+    // chaque bloc est pass  visit depuis la mmoire de travail du thread
+    void simulate(int numPaths, int steps, double maturity, std::mt19937& rng, const PathBlockVisitor& visit,
+                  unsigned numThreads = 0) const;
+
+    // Mme simulation, recopie dans paths
+    void simulate(PathMatrix& paths, double maturity, std::mt19937& rng, unsigned numThreads = 0) const;
+
+private:
+    // Ligne de volatilits locales interpole linairement en temps  la date t
+    void rowAt(double t, double* row) const;
+
+    int spaceNodes;                 // Nombre de points en ln S
+    int timeNodes;                  // Nombre de dates
+    double logSpotMin;              // Premier point en ln S
+    double logSpotStep;             // Pas en ln S
+    double timeStep;                // Pas en temps
+    std::vector<double> volatility; // timeNodes lignes de spaceNodes volatilits locales
+};
+
+#endif // LOCAL_VOLATILITY_MODEL_H
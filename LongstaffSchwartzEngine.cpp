@@ -0,0 +1,203 @@
+#include "LongstaffSchwartzEngine.h"
+#include "BlackScholesModel.h"
+#include "ExoticOption.h"
+#include "Parallel.h"   // Pour parallelFor
+#include "PathArena.h"  // Mmoire de travail (valeurs, variables explicatives, tuiles)
+#include "PathMatrix.h" // Trajectoires simules une seule fois
+#include <algorithm>    // Pour std::fill et std::min
+#include <cmath>        // Pour std::exp et std::sqrt
+#include <stdexcept>    // Pour std::invalid_argument
+
+// Nombre de trajectoires par tuile de la matrice de base (tuile de BLOCK_SIZE x basisSize doubles)
+static const int BLOCK_SIZE = 256;
+
+// Seuil relatif de pivot en de duquel une fonction de base est juge redondante
+static const double PIVOT_TOLERANCE = 1e-12;
+
+// Constructeur du moteur
+LongstaffSchwartzEngine::LongstaffSchwartzEngine(int exerciseDates_, int spotDegree_, int statisticDegree_,
+                                                 bool crossTerm_, unsigned numThreads_)
+    : exerciseDates(exerciseDates_), spotDegree(spotDegree_), statisticDegree(statisticDegree_),
+      crossTerm(crossTerm_), numThreads(numThreads_) {}
+
+// Constante, puissances de x, puissances de y, terme crois
+int LongstaffSchwartzEngine::basisSize() const {
+    return 1 + spotDegree + statisticDegree + (crossTerm ? 1 : 0);
+}
+
+void LongstaffSchwartzEngine::basis(double x, double y, double* out) const {
+    int k = 0;
+    out[k++] = 1.0;
+    double power = 1.0;
+    for (int d = 0; d < spotDegree; ++d) out[k++] = (power *= x);
+    power = 1.0;
+    for (int d = 0; d < statisticDegree; ++d) out[k++] = (power *= y);
+    if (crossTerm) out[k++] = x * y;
+}
+
+// Rgression par quations normales (A^T A) beta = A^T v
+void LongstaffSchwartzEngine::regress(const double* xs, const double* ys, const double* values,
+                                      const int* selected, int count, double* beta) const {
+    const int K = basisSize();
+    const int stride = K * K + K; // Matrice de Gram puis second membre d'un bloc
+    const int numBlocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    PathArena::Scope scope;
+    double* partials = scope.allocate(static_cast<std::size_t>(numBlocks) * stride);
+
+    // Accumulation par blocs : la base d'un bloc est crite colonne par colonne dans une tuile,
+    // puis chaque produit scalaire de colonnes parcourt la tuile avec des accs unitaires
+    parallelFor(numBlocks, 1, [&](std::size_t beginBlock, std::size_t endBlock) {
+        PathArena::Scope local; // Arne du thread de travail
+        double* tile = local.allocate(static_cast<std::size_t>(BLOCK_SIZE) * K);
+        double* target = local.allocate(BLOCK_SIZE);
+        double* row = local.allocate(K);
+
+        for (std::size_t b = beginBlock; b < endBlock; ++b) {
+            int first = static_cast<int>(b) * BLOCK_SIZE;
+            int rows = std::min(BLOCK_SIZE, count - first);
+            for (int r = 0; r < rows; ++r) {
+                int i = selected[first + r];
+                basis(xs[i], ys[i], row);
+                for (int k = 0; k < K; ++k) tile[k * BLOCK_SIZE + r] = row[k];
+                target[r] = values[i];
+            }
+
+            double* gram = partials + b * stride;
+            double* rhs = gram + K * K;
+            for (int k = 0; k < K; ++k) {
+                const double* ck = tile + k * BLOCK_SIZE;
+                for (int l = 0; l <= k; ++l) {
+                    const double* cl = tile + l * BLOCK_SIZE;
+                    double sum = 0.0;
+                    for (int r = 0; r < rows; ++r) sum += ck[r] * cl[r];
+                    gram[k * K + l] = sum;
+                }
+                double sum = 0.0;
+                for (int r = 0; r < rows; ++r) sum += ck[r] * target[r];
+                rhs[k] = sum;
+            }
+        }
+    }, numThreads);
+
+    // Rduction dans l'ordre des blocs (rsultat indpendant du nombre de threads)
+    double* gram = scope.allocate(K * K);
+    double* rhs = scope.allocate(K);
+    std::fill(gram, gram + K * K, 0.0);
+    std::fill(rhs, rhs + K, 0.0);
+    for (int b = 0; b < numBlocks; ++b) {
+        const double* partial = partials + static_cast<std::size_t>(b) * stride;
+        for (int k = 0; k < K; ++k) {
+            for (int l = 0; l <= k; ++l) gram[k * K + l] += partial[k * K + l];
+            rhs[k] += partial[K * K + k];
+        }
+    }
+
+    // Cholesky (triangle infrieur) ; une colonne de pivot ngligeable est carte (coefficient nul)
+    double* lower = scope.allocate(K * K);
+    std::fill(lower, lower + K * K, 0.0);
+    for (int k = 0; k < K; ++k) {
+        double pivot = gram[k * K + k];
+        for (int m = 0; m < k; ++m) pivot -= lower[k * K + m] * lower[k * K + m];
+        if (!(pivot > PIVOT_TOLERANCE * gram[k * K + k])) continue; // Colonne redondante
+        double diagonal = std::sqrt(pivot);
+        lower[k * K + k] = diagonal;
+        for (int i = k + 1; i < K; ++i) {
+            double sum = gram[i * K + k];
+            for (int m = 0; m < k; ++m) sum -= lower[i * K + m] * lower[k * K + m];
+            lower[i * K + k] = sum / diagonal;
+        }
+    }
+
+    // Descente puis remonte
+    for (int k = 0; k < K; ++k) {
+        if (lower[k * K + k] == 0.0) { beta[k] = 0.0; continue; }
+        double sum = rhs[k];
+        for (int m = 0; m < k; ++m) sum -= lower[k * K + m] * beta[m];
+        beta[k] = sum / lower[k * K + k];
+    }
+    for (int k = K - 1; k >= 0; --k) {
+        if (lower[k * K + k] == 0.0) { beta[k] = 0.0; continue; }
+        double sum = beta[k];
+        for (int i = k + 1; i < K; ++i) sum -= lower[i * K + k] * beta[i];
+        beta[k] = sum / lower[k * K + k];
+    }
+}
+
+// Induction arrire de Longstaff-Schwartz
+MonteCarloResult LongstaffSchwartzEngine::price(const ExoticOption& option, const BlackScholesModel& model,
+                                                int numPaths, int steps, std::mt19937& rng) const {
+    if (numPaths <= 0 || steps <= 0) {
+        throw std::invalid_argument("numPaths and steps must be positive in LongstaffSchwartzEngine::price.");
+    }
+
+    // Trajectoires simules une fois, conserves pour toute l'induction
+    PathMatrix paths(numPaths, steps);
+    paths.simulate(model, option.maturity, rng);
+
+    const double dt = option.maturity / steps;
+    const double scale = 1.0 / option.strike;
+    const int K = basisSize();
+    const int dates = (exerciseDates <= 0 || exerciseDates > steps) ? steps : exerciseDates;
+
+    PathArena::Scope scope;
+    double* values = scope.allocate(numPaths);   // Flux de chaque trajectoire, actualis  la date courante
+    double* exercise = scope.allocate(numPaths); // Valeur d'exercice  la date courante
+    double* xs = scope.allocate(numPaths);
+    double* ys = scope.allocate(numPaths);
+    int* selected = scope.allocateAs<int>(numPaths);
+    double* beta = scope.allocate(K);
+    double* row = scope.allocate(K);
+
+    // Flux  maturit
+    parallelFor(numPaths, BLOCK_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) values[i] = option.payoff(paths.path(static_cast<int>(i)));
+    }, numThreads);
+
+    // Dates d'exercice k = dates - 1, ..., 1 (pas j = k * steps / dates), de la plus tardive  la plus proche
+    int nextStep = steps;
+    for (int k = dates - 1; k >= 1; --k) {
+        int step = static_cast<int>(static_cast<long long>(k) * steps / dates);
+        double discount = std::exp(-model.rateIntegral(step * dt, nextStep * dt));
+        nextStep = step;
+
+        // Valeurs d'exercice et variables explicatives
+        parallelFor(numPaths, BLOCK_SIZE, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                PathView path = paths.path(static_cast<int>(i), step);
+                values[i] *= discount;
+                exercise[i] = option.payoff(path);
+                xs[i] = path.back() * scale;
+                ys[i] = option.pathStatistic(path) * scale;
+            }
+        }, numThreads);
+
+        // Rgression sur les seules trajectoires dans la monnaie
+        int count = 0;
+        for (int i = 0; i < numPaths; ++i) {
+            if (exercise[i] > 0.0) selected[count++] = i;
+        }
+        if (count < K) continue; // Pas assez de points pour estimer la continuation
+
+        regress(xs, ys, values, selected, count, beta);
+
+        // Exercice si la valeur immdiate dpasse la continuation estime
+        for (int s = 0; s < count; ++s) {
+            int i = selected[s];
+            basis(xs[i], ys[i], row);
+            double continuation = 0.0;
+            for (int m = 0; m < K; ++m) continuation += beta[m] * row[m];
+            if (exercise[i] > continuation) values[i] = exercise[i];
+        }
+    }
+
+    // Actualisation jusqu' la date 0, moyenne et erreur standard (estimateur sans biais des
+    // autres moteurs Monte-Carlo)
+    double discount = std::exp(-model.rateIntegral(0.0, nextStep * dt));
+    PayoffSums sums{0.0, 0.0, numPaths, discount};
+    for (int i = 0; i < numPaths; ++i) {
+        sums.sum += values[i];
+        sums.sumSquares += values[i] * values[i];
+    }
+    return sums.result();
+}
@@ -0,0 +1,52 @@
+#ifndef LONGSTAFF_SCHWARTZ_ENGINE_H
+#define LONGSTAFF_SCHWARTZ_ENGINE_H
+
+#include "MonteCarloEngine.h" // Pour MonteCarloResult
+#include <random>             // Pour std::mt19937
+
+class ExoticOption;
+class BlackScholesModel;
+
+// Moteur Monte-Carlo de Longstaff-Schwartz (moindres carrs) pour l'exercice anticip des exotiques
+//
+// Les trajectoires sont simules une seule fois dans une PathMatrix. Aux dates d'exercice, de
+// la dernire  la premire, la valeur de continuation des trajectoires dans la monnaie est
+// rgresse sur une base polynomiale en x = S / K et y = statistique / K (pathStatistic de
+// l'option : moyenne courante, extremum...), avec ventuellement le terme crois x * y.
+// La valeur d'exercice  la date j est le payoff de l'option sur la trajectoire tronque  j
+// (moyenne ou extremum courant, tat de la barrire  cette date).
+//
+// Les quations normales sont accumules par blocs de trajectoires (tuiles de la base tenant
+// en cache) en parallle, puis rduites dans l'ordre des blocs : le rsultat ne dpend pas du
+// nombre de threads. Le systme est rsolu par Cholesky ; les fonctions de base redondantes
+// (statistique gale au spot, par exemple pour une barrire) sont cartes.
+class LongstaffSchwartzEngine {
+public:
+    int exerciseDates;   // Nombre de dates d'exercice quirparties (0 : chaque pas, exercice amricain)
+    int spotDegree;      // Degr des polynmes en x
+    int statisticDegree; // Degr des polynmes en y
+    bool crossTerm;      // Ajoute le terme crois x * y
+    unsigned numThreads; // Nombre de threads (0 : nombre de coeurs)
+
+    // Constructeur
+    LongstaffSchwartzEngine(int exerciseDates_ = 0, int spotDegree_ = 3, int statisticDegree_ = 3,
+                            bool crossTerm_ = true, unsigned numThreads_ = 0);
+
+    // Prix de la variante bermudenne/amricaine de l'option sur numPaths trajectoires de steps pas
+    // L'exercice n'est pas autoris  la date 0
+    MonteCarloResult price(const ExoticOption& option, const BlackScholesModel& model,
+                           int numPaths, int steps, std::mt19937& rng) const;
+
+    // Nombre de fonctions de base
+    int basisSize() const;
+
+private:
+    // value les fonctions de base en (x, y)
+    void basis(double x, double y, double* out) const;
+
+    // Rgression de values sur la base aux trajectoires slectionnes (coefficients dans beta)
+    void regress(const double* xs, const double* ys, const double* values, const int* selected,
+                 int count, double* beta) const;
+};
+
+#endif // LONGSTAFF_SCHWARTZ_ENGINE_H
@@ -1,7 +1,9 @@
 #include "LookbackOption.h"
-#include <algorithm>    // Pour std::max_element et std::min_element
+#include "MonteCarloEngine.h" // Moteur Monte-Carlo commun (simulation des trajectoires)
+#include "PricingKey.h" // Cl de cache
+#include <algorithm>    // Pour std::max et std::min
 #include <cmath>        // Pour std::exp
-#include <random>       // Pour std::mt19937 et std::normal_distribution
+#include <random>       // Pour std::mt19937
 #include <stdexcept>    // Pour std::logic_error
 
 // Constructeur de la classe LookbackOption
@@ -13,15 +15,53 @@ LookbackOption::LookbackOption(double strike_, double maturity_, OptionType opti
 // Pour une option call, le payoff dpend du prix maximum atteint pendant la priode
 // Pour une option put, il dpend du prix minimum atteint
 double LookbackOption::payoff(const std::vector<double>& path) const {
+    return payoff(PathView(path.data(), static_cast<int>(path.size())));
+}
+
+// Payoff sur une vue de trajectoire (prix initial inclus dans l'extremum), en double ou en float
+template <typename T>
+double LookbackOption::pathPayoff(const BasicPathView<T>& path) const {
     if (optionType == OptionType::Call) {
-        double maxPrice = *std::max_element(path.begin(), path.end()); // Trouve le prix maximum
+        T maxPrice = path[0];
+        for (int j = 1; j < path.size(); ++j) maxPrice = std::max(maxPrice, path[j]); // Trouve le prix maximum
         return std::max(maxPrice - strike, 0.0); // Payoff d'un call
     } else { // OptionType::Put
-        double minPrice = *std::min_element(path.begin(), path.end()); // Trouve le prix minimum
+        T minPrice = path[0];
+        for (int j = 1; j < path.size(); ++j) minPrice = std::min(minPrice, path[j]); // Trouve le prix minimum
         return std::max(strike - minPrice, 0.0); // Payoff d'un put
     }
 }
 
+double LookbackOption::payoff(const PathView& path) const {
+    return pathPayoff(path);
+}
+
+double LookbackOption::payoff(const PathViewF& path) const {
+    return pathPayoff(path);
+}
+
+// Extremum courant de la vue (maximum pour un call, minimum pour un put), variable de rgression
+double LookbackOption::pathStatistic(const PathView& path) const {
+    double extremum = path[0];
+    for (int j = 1; j < path.size(); ++j) {
+        extremum = (optionType == OptionType::Call) ? std::max(extremum, path[j]) : std::min(extremum, path[j]);
+    }
+    return extremum;
+}
+
+// Payoff diffrentiable (AAD) : la drive suit la date o l'extremum est atteint
+ADouble LookbackOption::payoff(const PathViewAD& path, double) const {
+    if (optionType == OptionType::Call) {
+        ADouble maxPrice = path[0];
+        for (int j = 1; j < path.size(); ++j) maxPrice = max(maxPrice, path[j]); // Trouve le prix maximum
+        return max(maxPrice - strike, 0.0); // Payoff d'un call
+    } else { // OptionType::Put
+        ADouble minPrice = path[0];
+        for (int j = 1; j < path.size(); ++j) minPrice = min(minPrice, path[j]); // Trouve le prix minimum
+        return max(strike - minPrice, 0.0); // Payoff d'un put
+    }
+}
+
 // Implmentation d'une mthode inutilise
 // Cette mthode n'est pas applicable pour une option lookback, car le payoff dpend d'une trajectoire
 double LookbackOption::payoff(double spot) const {
@@ -29,91 +69,25 @@ double LookbackOption::payoff(double spot) const {
 }
 
 // Calcul du prix via Monte-Carlo avec la maturit par dfaut
-double LookbackOption::price(const BlackScholesModel& model, int numPaths, int steps) const {
-    return this->price(model, numPaths, steps, maturity); // Appelle la mthode avec la maturit par dfaut
+double LookbackOption::price(const BlackScholesModel& model, int numPaths, int steps, const PricingContext& context) const {
+    return this->price(model, numPaths, steps, maturity, context); // Appelle la mthode avec la maturit par dfaut
 }
 
 // Calcul du prix via Monte-Carlo avec une maturit ajuste
-double LookbackOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity) const {
-    double sumPayoffs = 0.0; // Somme des payoffs simuls
-    double dt = adjustedMaturity / steps; // Pas temporel
-
-    std::mt19937 rng(std::random_device{}()); // Gnrateur alatoire avec graine dynamique
-    std::normal_distribution<> dist(0.0, 1.0); // Distribution normale standard
-
-    for (int i = 0; i < numPaths; ++i) {
-        std::vector<double> path; // Stocke la trajectoire simule
-        path.reserve(steps + 1); // Prallocation pour les tapes simules
-
-        double spot = model.spot; // Prix initial du sous-jacent
-        path.push_back(spot); // Ajoute le prix initial  la trajectoire
-
-        // Simulation de la trajectoire du sous-jacent
-        for (int j = 0; j < steps; ++j) {
-            double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-            double diffusion = model.volatility * std::sqrt(dt) * dist(rng);
-            spot *= std::exp(drift + diffusion); // Mise  jour du prix simul
-            path.push_back(spot); // Ajoute le prix simul  la trajectoire
-        }
-
-        sumPayoffs += payoff(path); // Calcule le payoff pour la trajectoire et l'ajoute  la somme
-    }
-
-    // Retourne le prix moyen actualis
-    return std::exp(-model.rate * adjustedMaturity) * (sumPayoffs / numPaths);
+double LookbackOption::price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity,
+                  const PricingContext& context) const {
+    std::mt19937 rng = context.generator(); // Gnrateur du contexte
+    return MonteCarloEngine::run(*this, model, numPaths, steps, adjustedMaturity, SimulationPrecision::Double, rng).price;
 }
 
-// Calcul du cot de rplication bas sur la stratgie de delta hedging
-double LookbackOption::hedgeCost(const BlackScholesModel& model, int steps) const {
-    int numPaths = 10000; // Nombre de trajectoires pour le calcul Monte-Carlo
-    double epsilon = 0.01 * model.spot; // Variation pour les diffrences finies
-
-    // Initialisation du delta
-    BlackScholesModel modelUp = model;
-    modelUp.spot += epsilon; // Spot augment
-    BlackScholesModel modelDown = model;
-    modelDown.spot -= epsilon; // Spot diminu
-
-    double priceUp = this->price(modelUp, numPaths, steps); // Prix pour le spot augment
-    double priceDown = this->price(modelDown, numPaths, steps); // Prix pour le spot diminu
-    double previousDelta = 0;
-    double delta = (priceUp - priceDown) / (2 * epsilon); // Delta initial
-
-    // Rplication dynamique
-    double dt = maturity / steps; // Pas temporel
-    double spot = model.spot; // Prix initial
-    double cash = delta * spot; // Montant initial en cash
-
-    std::vector<double> path; // Stocke la trajectoire simule
-    path.push_back(spot); // Ajoute le prix initial
-
-    for (int i = 1; i < steps; ++i) {
-        // Ajuste la maturit
-        double adjustedMaturity = maturity - i * dt;
-
-        // Simulation du prix du sous-jacent
-        double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-        double diffusion = model.volatility * std::sqrt(dt) * ((double)rand() / RAND_MAX - 0.5);
-        spot *= std::exp(drift + diffusion); // Mise  jour du prix simul
-
-        path.push_back(spot); // Ajoute le prix simul  la trajectoire
-
-        // Mise  jour du delta
-        double previousDelta = delta;
-
-        modelUp.spot = spot + epsilon;
-        modelDown.spot = spot - epsilon;
-
-        priceUp = this->price(modelUp, numPaths, steps - i);
-        priceDown = this->price(modelDown, numPaths, steps - i);
-
-        delta = (priceUp - priceDown) / (2 * epsilon); // Nouveau delta
-
-        // Ajustement du portefeuille
-        cash += (delta - previousDelta) * spot; // Ajustement pour le delta
-        cash *= std::exp(model.rate * dt); // Actualisation du cash
-    }
+// Delta de couverture tir de l'option de maturit complte
+double LookbackOption::hedgeHorizon(double) const {
+    return maturity;
+}
 
-    // Retourne le cot total de rplication ajust par le payoff final
-    return cash - delta * spot + payoff(path);
+// Cl de cache du produit
+void LookbackOption::appendKey(PricingKey& key) const {
+    key.add("LookbackOption");
+    Option::appendKey(key);
+    key.add(static_cast<long long>(optionType));
 }
@@ -15,17 +15,44 @@ public:
     // Mthode pour le payoff bas sur une trajectoire complte
     double payoff(const std::vector<double>& path) const;
 
+    // Payoff sur une vue de trajectoire (prix initial en position 0), en double ou en float
+    double payoff(const PathView& path) const override;
+    double payoff(const PathViewF& path) const override;
+
+    // Payoff diffrentiable (AAD) ; aucun lissage n'est ncessaire pour ce produit
+    ADouble payoff(const PathViewAD& path, double smoothing) const override;
+
     // Implmentation de la mthode virtuelle pour le payoff (par dfaut inutilise)
     double payoff(double spot) const override;
 
     // Mthode de pricing Monte-Carlo que l'on va utiliser en cas de maturit constante
-    double price(const BlackScholesModel& model, int numPaths, int steps) const override;
+    double price(const BlackScholesModel& model, int numPaths, int steps,
+                 const PricingContext& context) const override;
 
     // Surcharge de la mthode ci-dessus permettant de prendre en argument la maturit (utile pour calculer le delta)
-    double price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity) const;
+    double price(const BlackScholesModel& model, int numPaths, int steps, double adjustedMaturity,
+                 const PricingContext& context = PricingContext::fromEntropy()) const;
+
+
+    // Cl de cache : nom du produit, strike, maturit, type
+    void appendKey(PricingKey& key) const override;
+
+    // Rend visibles les surcharges de ExoticOption (sans contexte, choix de la prcision, autres modles)
+    using ExoticOption::price;
+
+    // Rend visibles les couvertures de ExoticOption (sans contexte, reprenable)
+    using ExoticOption::hedgeCost;
+
+    // Couverture : delta de l'option de maturit complte (l'extremum dj atteint n'est pas conditionn)
+    double hedgeHorizon(double remainingMaturity) const override;
+
+    // Variable d'tat pour la rgression de Longstaff-Schwartz : extremum courant
+    double pathStatistic(const PathView& path) const override;
 
-    // Cot de rplication bas sur la stratgie de couverture dynamique
-    double hedgeCost(const BlackScholesModel& model, int steps) const override;
+private:
+    // Implmentation commune des payoffs sur vues double et float
+    template <typename T>
+    double pathPayoff(const BasicPathView<T>& path) const;
 };
 
 #endif // LOOKBACK_OPTION_H
@@ -0,0 +1,389 @@
+#include "MonteCarloEngine.h"
+#include "ExoticOption.h"       // Payoffs sur vues de trajectoires
+#include "BlackScholesModel.h"  // Paramtres du modle
+#include "HestonModel.h"        // Modle  volatilit stochastique (schma QE)
+#include "LocalVolatilityModel.h" // Modle  volatilit locale de Dupire
+#include "JumpDiffusionModel.h" // Modles  sauts de Merton et Kou
+#include "MultiAssetModel.h"    // Sous-jacents corrls (paniers, spreads, worst-of)
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "PathArena.h"          // Mmoire de travail des trajectoires
+#include "Parallel.h"           // Pour parallelFor
+#include "Aad.h"                // Diffrentiation automatique adjointe
+#include "Checkpoint.h"         // Points de reprise des calculs longs
+#include "PricingKey.h"         // Empreinte du calcul sauvegard
+#include <algorithm>            // Pour std::max et std::min
+#include <chrono>               // Pour la mesure des temps de calcul
+#include <cmath>                // Pour std::exp, std::sqrt, std::fabs
+#include <stdexcept>            // Pour std::invalid_argument et std::runtime_error
+
+// Combinaison de deux lots de trajectoires
+void PayoffSums::add(const PayoffSums& other) {
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+    numPaths += other.numPaths;
+}
+
+// Moyenne actualise et erreur standard (variance sans biais)
+MonteCarloResult PayoffSums::result() const {
+    double mean = sum / numPaths;
+    double variance = numPaths > 1 ? (sumSquares / numPaths - mean * mean) * numPaths / (numPaths - 1) : 0.0;
+
+    MonteCarloResult result;
+    result.price = discount * mean;
+    result.standardError = discount * std::sqrt(std::max(variance, 0.0) / numPaths);
+    result.numPaths = static_cast<int>(numPaths);
+    return result;
+}
+
+// Boucle Monte-Carlo gnrique en prcision T (double ou float)
+// Pour chaque trajectoire : tirage des normales en bloc, facteurs de croissance exp(...)
+// calculs en une boucle vectorisable  partir des intgrales par pas du modle, puis produit
+// cumul ; les dividendes cash (modle squestr) sont rajouts  la fin ; les payoffs sont ajouts
+// aux sommes de sums, qui restent en double
+template <typename T>
+static void simulate(const ExoticOption& option, const BlackScholesModel& model,
+                     int numPaths, int steps, double maturity, std::mt19937& rng, PayoffSums& sums) {
+    PathArena::Scope scratch; // Mmoire de travail rutilise d'une trajectoire  l'autre
+    const StepSchedule schedule = model.schedule(maturity, steps, scratch);
+    T* drift = scratch.allocateAs<T>(steps);     // Intgrales par pas converties une fois en T
+    T* diffusion = scratch.allocateAs<T>(steps);
+    T* offset = scratch.allocateAs<T>(steps + 1);
+    for (int j = 0; j < steps; ++j) {
+        drift[j] = T(schedule.drift[j]);
+        diffusion[j] = T(schedule.diffusion[j]);
+    }
+    for (int j = 0; j <= steps; ++j) offset[j] = T(schedule.dividendOffset[j]);
+    const T spot0 = T(schedule.initialSpot);
+
+    T* path = scratch.allocateAs<T>(steps + 1); // Trajectoire (prix initial inclus)
+    T* growth = scratch.allocateAs<T>(steps);   // Normales puis facteurs de croissance
+
+    double sumPayoffs = sums.sum;               // Somme des payoffs
+    double sumSquaredPayoffs = sums.sumSquares; // Somme des carrs (erreur standard)
+
+    for (int i = 0; i < numPaths; ++i) {
+        NormalDistribution::sample(rng, growth, steps);
+        for (int j = 0; j < steps; ++j) {
+            growth[j] = std::exp(drift[j] + diffusion[j] * growth[j]);
+        }
+
+        path[0] = spot0;
+        for (int j = 0; j < steps; ++j) {
+            path[j + 1] = path[j] * growth[j];
+        }
+        if (schedule.hasCashDividends) {
+            for (int j = 0; j <= steps; ++j) path[j] += offset[j];
+        }
+
+        double p = option.payoff(BasicPathView<T>(path, steps + 1));
+        sumPayoffs += p;
+        sumSquaredPayoffs += p * p;
+    }
+
+    sums = PayoffSums{sumPayoffs, sumSquaredPayoffs, sums.numPaths + numPaths, schedule.discount};
+}
+
+// Sommes des payoffs dans la prcision demande
+PayoffSums MonteCarloEngine::accumulate(const ExoticOption& option, const BlackScholesModel& model,
+                                        int numPaths, int steps, double maturity,
+                                        SimulationPrecision precision, std::mt19937& rng) {
+    PayoffSums sums{0.0, 0.0, 0, 1.0};
+    accumulate(option, model, numPaths, steps, maturity, precision, rng, sums);
+    return sums;
+}
+
+// Suite des sommes existantes dans la prcision demande
+void MonteCarloEngine::accumulate(const ExoticOption& option, const BlackScholesModel& model,
+                                  int numPaths, int steps, double maturity,
+                                  SimulationPrecision precision, std::mt19937& rng, PayoffSums& sums) {
+    if (precision == SimulationPrecision::Single) {
+        simulate<float>(option, model, numPaths, steps, maturity, rng, sums);
+    } else {
+        simulate<double>(option, model, numPaths, steps, maturity, rng, sums);
+    }
+}
+
+// Prix actualis dans la prcision demande
+MonteCarloResult MonteCarloEngine::run(const ExoticOption& option, const BlackScholesModel& model,
+                                       int numPaths, int steps, double maturity,
+                                       SimulationPrecision precision, std::mt19937& rng) {
+    return accumulate(option, model, numPaths, steps, maturity, precision, rng).result();
+}
+
+// Morceaux successifs ; sommes et indice du morceau suivant sauvegards tous les checkpointEvery morceaux
+MonteCarloResult MonteCarloEngine::runCheckpointed(const ExoticOption& option, const BlackScholesModel& model,
+                                                   int numPaths, int steps, unsigned seed,
+                                                   const Checkpoint& checkpoint, int checkpointEvery, int chunkPaths) {
+    if (numPaths <= 0 || chunkPaths <= 0 || checkpointEvery <= 0) {
+        throw std::invalid_argument("MonteCarloEngine::runCheckpointed requires positive path, chunk and interval sizes.");
+    }
+    PricingKey key;
+    key.add("MonteCarloEngine::runCheckpointed");
+    option.appendKey(key);
+    model.appendKey(key);
+    key.add(static_cast<long long>(numPaths)).add(static_cast<long long>(steps))
+        .add(static_cast<long long>(seed)).add(static_cast<long long>(chunkPaths));
+
+    PayoffSums sums{0.0, 0.0, 0, 1.0};
+    long long nextChunk = 0;
+    CheckpointState state;
+    if (checkpoint.load(state)) {
+        if (state.key != key.hash() || state.counters.size() != 2 || state.values.size() != 3) {
+            throw std::runtime_error("Checkpoint file " + checkpoint.path() + " belongs to a different computation.");
+        }
+        nextChunk = state.counters[0];
+        sums = PayoffSums{state.values[0], state.values[1], state.counters[1], state.values[2]};
+    }
+
+    const long long numChunks = (numPaths + chunkPaths - 1) / chunkPaths;
+    for (long long k = nextChunk; k < numChunks; ++k) {
+        std::seed_seq sequence{seed, static_cast<unsigned>(k)};
+        std::mt19937 rng(sequence);
+        const int count = static_cast<int>(std::min<long long>(chunkPaths, numPaths - k * chunkPaths));
+        PayoffSums part = accumulate(option, model, count, steps, option.maturity, SimulationPrecision::Double, rng);
+        sums.discount = part.discount;
+        sums.add(part);
+
+        if ((k + 1) % checkpointEvery == 0 && k + 1 < numChunks) {
+            checkpoint.save(CheckpointState{key.hash(), {k + 1, sums.numPaths},
+                                            {sums.sum, sums.sumSquares, sums.discount}});
+        }
+    }
+    checkpoint.remove();
+    return sums.result();
+}
+
+// Sommes des payoffs par bloc de trajectoires : chaque bloc est valu ds sa simulation (dans la
+// mmoire de travail du thread qui l'a simul) ; les sommes sont rduites dans l'ordre des blocs
+// (rsultat indpendant du nombre de threads, mmoire indpendante du nombre de trajectoires)
+class BlockPayoffs {
+public:
+    BlockPayoffs(const ExoticOption& option_, int numPaths_, int blockPaths)
+        : option(option_), numPaths(numPaths_), partialSums(2 * ((numPaths_ + blockPaths - 1) / blockPaths), 0.0) {}
+
+    // Visiteur pass  la simulation par blocs du modle
+    PathBlockVisitor visitor() {
+        return [this](const PathBlock& block) {
+            double sum = 0.0, sumSquares = 0.0;
+            for (int i = 0; i < block.count; ++i) {
+                double p = option.payoff(block.path(i));
+                sum += p;
+                sumSquares += p * p;
+            }
+            partialSums[2 * block.index] = sum;
+            partialSums[2 * block.index + 1] = sumSquares;
+        };
+    }
+
+    // Prix actualis et erreur standard
+    MonteCarloResult result(double discount) const {
+        PayoffSums sums{0.0, 0.0, numPaths, discount};
+        for (std::size_t b = 0; b < partialSums.size(); b += 2) {
+            sums.sum += partialSums[b];
+            sums.sumSquares += partialSums[b + 1];
+        }
+        return sums.result();
+    }
+
+private:
+    const ExoticOption& option;
+    int numPaths;
+    std::vector<double> partialSums; // Somme et somme des carrs par bloc
+};
+
+// Heston : payoffs valus bloc par bloc pendant la simulation
+MonteCarloResult MonteCarloEngine::run(const ExoticOption& option, const HestonModel& model,
+                                       int numPaths, int steps, double maturity, std::mt19937& rng,
+                                       unsigned numThreads) {
+    BlockPayoffs payoffs(option, numPaths, HestonModel::BLOCK_PATHS);
+    model.simulate(numPaths, steps, maturity, rng, payoffs.visitor(), numThreads);
+    return payoffs.result(std::exp(-model.rate * maturity));
+}
+
+// Volatilit locale : mme structure que Heston
+MonteCarloResult MonteCarloEngine::run(const ExoticOption& option, const LocalVolatilityModel& model,
+                                       int numPaths, int steps, double maturity, std::mt19937& rng,
+                                       unsigned numThreads) {
+    BlockPayoffs payoffs(option, numPaths, LocalVolatilityModel::BLOCK_PATHS);
+    model.simulate(numPaths, steps, maturity, rng, payoffs.visitor(), numThreads);
+    return payoffs.result(std::exp(-model.rate * maturity));
+}
+
+// Diffusion  sauts : mme structure que Heston
+MonteCarloResult MonteCarloEngine::run(const ExoticOption& option, const JumpDiffusionModel& model,
+                                       int numPaths, int steps, double maturity, std::mt19937& rng,
+                                       unsigned numThreads) {
+    BlockPayoffs payoffs(option, numPaths, JumpDiffusionModel::BLOCK_PATHS);
+    model.simulate(numPaths, steps, maturity, rng, payoffs.visitor(), numThreads);
+    return payoffs.result(std::exp(-model.rate * maturity));
+}
+
+// Multi-actifs : le payoff mono-sous-jacent est valu sur la trajectoire agrge
+MonteCarloResult MonteCarloEngine::run(const ExoticOption& option, const MultiAssetModel& model, BasketType type,
+                                       const std::vector<double>& weights, int numPaths, int steps, double maturity,
+                                       std::mt19937& rng, unsigned numThreads) {
+    BlockPayoffs payoffs(option, numPaths, MultiAssetModel::BLOCK_PATHS);
+    model.simulate(numPaths, steps, type, weights, maturity, rng, payoffs.visitor(), numThreads);
+    return payoffs.result(std::exp(-model.rate * maturity));
+}
+
+// Delta appari : mmes facteurs de croissance pour les deux spots, carts de payoff accumuls
+MonteCarloDelta MonteCarloEngine::runDelta(const ExoticOption& option, const BlackScholesModel& model, double epsilon,
+                                           int numPaths, int steps, double maturity, std::mt19937& rng) {
+    PathArena::Scope scratch; // Mmoire de travail rutilise d'une trajectoire  l'autre
+    const StepSchedule schedule = model.schedule(maturity, steps, scratch);
+    double* growth = scratch.allocate(steps); // Normales puis facteurs de croissance
+    double* pathUp = scratch.allocate(steps + 1);
+    double* pathDown = scratch.allocate(steps + 1);
+
+    double sum = 0.0, sumSquares = 0.0;
+    for (int i = 0; i < numPaths; ++i) {
+        NormalDistribution::sample(rng, growth, steps);
+        for (int j = 0; j < steps; ++j) {
+            growth[j] = std::exp(schedule.drift[j] + schedule.diffusion[j] * growth[j]);
+        }
+
+        pathUp[0] = schedule.initialSpot + epsilon;
+        pathDown[0] = schedule.initialSpot - epsilon;
+        for (int j = 0; j < steps; ++j) {
+            pathUp[j + 1] = pathUp[j] * growth[j];
+            pathDown[j + 1] = pathDown[j] * growth[j];
+        }
+        if (schedule.hasCashDividends) {
+            for (int j = 0; j <= steps; ++j) {
+                pathUp[j] += schedule.dividendOffset[j];
+                pathDown[j] += schedule.dividendOffset[j];
+            }
+        }
+
+        double d = option.payoff(PathView(pathUp, steps + 1)) - option.payoff(PathView(pathDown, steps + 1));
+        sum += d;
+        sumSquares += d * d;
+    }
+
+    // carts actualiss et diviss par 2 epsilon
+    MonteCarloResult estimate = PayoffSums{sum, sumSquares, numPaths, schedule.discount / (2.0 * epsilon)}.result();
+    return MonteCarloDelta{estimate.price, estimate.standardError};
+}
+
+// Sensibilits trajectorielles par AAD : la bande est vide (sans libration)  chaque trajectoire
+// Les entres diffrencies sont des dplacements parallles des courbes (taux, dividende,
+// volatilit) autour de zro : avec des paramtres constants, ce sont les drives usuelles
+MonteCarloGreeks MonteCarloEngine::runGreeks(const ExoticOption& option, const BlackScholesModel& model,
+                                             int numPaths, int steps, double maturity, std::mt19937& rng,
+                                             double barrierSmoothing) {
+    double dt = maturity / steps; // Pas temporel
+    Tape& tape = Tape::local();
+
+    PathArena::Scope scratch; // Mmoire de travail rutilise d'une trajectoire  l'autre
+    const StepSchedule schedule = model.schedule(maturity, steps, scratch);
+    double* volatilityStep = scratch.allocate(steps);  // S_j = int sigma sur le pas
+    double* volatilityScale = scratch.allocate(steps); // S_j / sqrt(int sigma^2)
+    for (int j = 0; j < steps; ++j) {
+        double t1 = (j + 1 == steps) ? maturity : (j + 1) * dt;
+        volatilityStep[j] = model.volatilityIntegral(j * dt, t1);
+        volatilityScale[j] = schedule.diffusion[j] > 0.0 ? volatilityStep[j] / schedule.diffusion[j] : std::sqrt(t1 - j * dt);
+    }
+    const double rateTerm = model.rateIntegral(0.0, maturity);
+
+    // Drive de la valeur actualise des dividendes cash restants par rapport au dplacement du taux
+    double* offsetRateDerivative = scratch.allocate(steps + 1);
+    for (int j = 0; j <= steps; ++j) {
+        double t = j * dt;
+        offsetRateDerivative[j] = 0.0;
+        for (const CashDividend& d : model.cashDividends) {
+            if (d.time > t && d.time <= maturity) {
+                offsetRateDerivative[j] -= (d.time - t) * d.amount * std::exp(-model.rateIntegral(t, d.time));
+            }
+        }
+    }
+
+    ADouble* path = scratch.allocateAs<ADouble>(steps + 1); // Trajectoire enregistre sur la bande
+    double* normals = scratch.allocate(steps);               // Tirages normaux de la trajectoire
+
+    double sumPrice = 0.0, sumSquaredPrice = 0.0;
+    double sumDelta = 0.0, sumVega = 0.0, sumRho = 0.0, sumDividendRho = 0.0;
+
+    for (int i = 0; i < numPaths; ++i) {
+        NormalDistribution::sample(rng, normals, steps);
+        tape.clear();
+
+        // Entres du modle (feuilles de la bande)
+        ADouble spot = ADouble::variable(model.spot);
+        ADouble volatilityShift = ADouble::variable(0.0);
+        ADouble rateShift = ADouble::variable(0.0);
+        ADouble dividendShift = ADouble::variable(0.0);
+        ADouble carryShift = rateShift - dividendShift;
+
+        // Passage direct : simulation enregistre ; l'exposant de chaque pas est un seul noeud,
+        // de drives dt (portage) et S_j z / sqrt(int sigma^2) - S_j (volatilit)
+        path[0] = spot - unaryNode(rateShift, schedule.dividendOffset[0], offsetRateDerivative[0]);
+        for (int j = 0; j < steps; ++j) {
+            double exponent = schedule.drift[j] + schedule.diffusion[j] * normals[j];
+            double volatilityDerivative = volatilityScale[j] * normals[j] - volatilityStep[j];
+            path[j + 1] = path[j] * exp(binaryNode(carryShift, volatilityShift, exponent, dt, volatilityDerivative));
+        }
+        if (schedule.hasCashDividends) {
+            for (int j = 0; j <= steps; ++j) {
+                path[j] = path[j] + unaryNode(rateShift, schedule.dividendOffset[j], offsetRateDerivative[j]);
+            }
+        }
+        ADouble value = option.payoff(PathViewAD(path, steps + 1), barrierSmoothing) *
+                        exp(-(rateTerm + rateShift * maturity));
+
+        // Passage inverse : toutes les drives en un balayage
+        tape.propagate(value.index);
+
+        sumPrice += value.value;
+        sumSquaredPrice += value.value * value.value;
+        sumDelta += tape.adjoint(spot.index);
+        sumVega += tape.adjoint(volatilityShift.index);
+        sumRho += tape.adjoint(rateShift.index);
+        sumDividendRho += tape.adjoint(dividendShift.index);
+    }
+
+    double mean = sumPrice / numPaths;
+    double variance = numPaths > 1 ? (sumSquaredPrice / numPaths - mean * mean) * numPaths / (numPaths - 1) : 0.0;
+
+    MonteCarloGreeks greeks;
+    greeks.price = mean;
+    greeks.standardError = std::sqrt(std::max(variance, 0.0) / numPaths);
+    greeks.delta = sumDelta / numPaths;
+    greeks.vega = sumVega / numPaths;
+    greeks.rho = sumRho / numPaths;
+    greeks.dividendRho = sumDividendRho / numPaths;
+    return greeks;
+}
+
+// Validation : mmes uniformes en float et en double, l'cart mesure l'effet de l'arrondi seul
+PrecisionReport MonteCarloEngine::comparePrecision(const ExoticOption& option, const BlackScholesModel& model,
+                                                   int numPaths, int steps, unsigned seed) {
+    PrecisionReport report;
+
+    std::mt19937 rngDouble(seed);
+    auto start = std::chrono::steady_clock::now();
+    report.doubleResult = run(option, model, numPaths, steps, option.maturity, SimulationPrecision::Double, rngDouble);
+    auto middle = std::chrono::steady_clock::now();
+
+    std::mt19937 rngSingle(seed);
+    report.singleResult = run(option, model, numPaths, steps, option.maturity, SimulationPrecision::Single, rngSingle);
+    auto end = std::chrono::steady_clock::now();
+
+    report.difference = report.singleResult.price - report.doubleResult.price;
+    report.differenceInStdErrors = report.doubleResult.standardError > 0.0
+        ? std::fabs(report.difference) / report.doubleResult.standardError : 0.0;
+    report.doubleSeconds = std::chrono::duration<double>(middle - start).count();
+    report.singleSeconds = std::chrono::duration<double>(end - middle).count();
+    return report;
+}
+
+// Affichage du rapport de validation
+void MonteCarloEngine::printReport(const PrecisionReport& report, std::ostream& out) {
+    out << "--- Validation simple prcision (" << report.doubleResult.numPaths << " trajectoires) ---\n";
+    out << "Prix double : " << report.doubleResult.price
+        << " (erreur standard " << report.doubleResult.standardError << ", " << report.doubleSeconds << " s)\n";
+    out << "Prix float  : " << report.singleResult.price
+        << " (erreur standard " << report.singleResult.standardError << ", " << report.singleSeconds << " s)\n";
+    out << "cart : " << report.difference << " soit " << report.differenceInStdErrors
+        << " erreur(s) standard\n";
+}
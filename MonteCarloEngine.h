@@ -0,0 +1,146 @@
+#ifndef MONTE_CARLO_ENGINE_H
+#define MONTE_CARLO_ENGINE_H
+
+#include "BasketType.h"
+#include "SimulationPrecision.h"
+#include <ostream> // Pour l'affichage du rapport
+#include <random>  // Pour std::mt19937
+#include <vector>  // Pour les pondrations des paniers
+
+class Checkpoint;
+class ExoticOption;
+class BlackScholesModel;
+class HestonModel;
+class LocalVolatilityModel;
+class JumpDiffusionModel;
+class MultiAssetModel;
+
+// Rsultat d'un pricing Monte-Carlo
+struct MonteCarloResult {
+    double price;         // Prix actualis estim
+    double standardError; // Erreur standard de l'estimateur
+    int numPaths;         // Nombre de trajectoires simules
+};
+
+// Sommes des payoffs d'un lot de trajectoires : des lots simuls sparment (morceaux de travail,
+// reprise aprs interruption) se combinent par add() avant le calcul du prix et de l'erreur standard
+struct PayoffSums {
+    double sum;         // Somme des payoffs (non actualiss)
+    double sumSquares;  // Somme des carrs
+    long long numPaths; // Nombre de trajectoires
+    double discount;    // Facteur d'actualisation du payoff
+
+    // Ajoute les sommes d'un autre lot (mme produit, mme modle)
+    void add(const PayoffSums& other);
+
+    // Prix actualis et erreur standard
+    MonteCarloResult result() const;
+};
+
+// Delta par diffrences finies centres
+struct MonteCarloDelta {
+    double delta;         // (prix(spot + epsilon) - prix(spot - epsilon)) / (2 epsilon)
+    double standardError; // Erreur standard de l'estimateur (trajectoires communes aux deux spots)
+};
+
+// Prix et sensibilits obtenus par AAD
+struct MonteCarloGreeks {
+    double price;         // Prix actualis estim (payoff liss pour les barrires)
+    double standardError; // Erreur standard du prix
+    double delta;         // Drive par rapport au spot
+    double vega;          // Drive par rapport  la volatilit (dplacement parallle de la courbe)
+    double rho;           // Drive par rapport au taux sans risque (dplacement parallle)
+    double dividendRho;   // Drive par rapport au taux de dividende (dplacement parallle)
+};
+
+// Rapport de validation de la simulation en simple prcision
+struct PrecisionReport {
+    MonteCarloResult doubleResult; // Simulation en double
+    MonteCarloResult singleResult; // Simulation en float, mmes nombres alatoires
+    double difference;             // Prix float - prix double
+    double differenceInStdErrors;  // |difference| rapporte  l'erreur standard en double
+    double doubleSeconds;          // Temps de calcul en double
+    double singleSeconds;          // Temps de calcul en float
+};
+
+// Moteur Monte-Carlo commun aux options exotiques
+// Simule les trajectoires Black-Scholes dans la mmoire de travail de PathArena
+// (en double ou en float selon la prcision demande) et accumule les payoffs en double
+class MonteCarloEngine {
+public:
+    // Prix actualis sur [0, maturity] avec numPaths trajectoires de steps pas
+    static MonteCarloResult run(const ExoticOption& option, const BlackScholesModel& model,
+                                int numPaths, int steps, double maturity,
+                                SimulationPrecision precision, std::mt19937& rng);
+
+    // Sommes des payoffs de numPaths trajectoires Black-Scholes (mme simulation que run)
+    static PayoffSums accumulate(const ExoticOption& option, const BlackScholesModel& model,
+                                 int numPaths, int steps, double maturity,
+                                 SimulationPrecision precision, std::mt19937& rng);
+
+    // Mme simulation, payoffs ajouts un  un aux sommes existantes : des appels successifs sur le
+    // mme gnrateur donnent les sommes, bit  bit, d'un seul appel sur le nombre total de trajectoires
+    static void accumulate(const ExoticOption& option, const BlackScholesModel& model,
+                           int numPaths, int steps, double maturity,
+                           SimulationPrecision precision, std::mt19937& rng, PayoffSums& sums);
+
+    // Prix actualis sur [0, option.maturity] avec reprise possible aprs une interruption
+    // Les trajectoires sont simules par morceaux de chunkPaths (le morceau k avec un gnrateur
+    // initialis par (seed, k)) ; tous les checkpointEvery morceaux, les sommes des payoffs et
+    // l'indice du morceau suivant sont sauvegards dans checkpoint. Un appel avec les mmes
+    // arguments reprend au dernier point sauvegard et donne le mme rsultat, bit  bit, qu'un
+    // calcul ininterrompu. Le fichier est supprim  la fin du calcul.
+    // Lve std::runtime_error si le fichier existant correspond  un autre calcul
+    static MonteCarloResult runCheckpointed(const ExoticOption& option, const BlackScholesModel& model,
+                                            int numPaths, int steps, unsigned seed, const Checkpoint& checkpoint,
+                                            int checkpointEvery = 16, int chunkPaths = 8192);
+
+    // Prix actualis sous le modle de Heston : trajectoires simules par blocs (schma QE, en
+    // parallle), payoffs valus sur chaque bloc ds sa simulation et rduits dans l'ordre des blocs ;
+    // aucune matrice numPaths x steps n'est construite
+    static MonteCarloResult run(const ExoticOption& option, const HestonModel& model,
+                                int numPaths, int steps, double maturity, std::mt19937& rng,
+                                unsigned numThreads = 0);
+
+    // Prix actualis sous un modle  volatilit locale : trajectoires simules par blocs (schma
+    // d'Euler en log-spot sur la surface en cache), payoffs valus et rduits comme pour Heston
+    static MonteCarloResult run(const ExoticOption& option, const LocalVolatilityModel& model,
+                                int numPaths, int steps, double maturity, std::mt19937& rng,
+                                unsigned numThreads = 0);
+
+    // Prix actualis sous un modle  sauts (Merton ou Kou) : dates de saut exactes par trajectoire,
+    // cumules par pas, puis mme avance vectorise que la partie diffusive ; rduction comme pour Heston
+    static MonteCarloResult run(const ExoticOption& option, const JumpDiffusionModel& model,
+                                int numPaths, int steps, double maturity, std::mt19937& rng,
+                                unsigned numThreads = 0);
+
+    // Prix actualis d'une option sur panier, spread ou worst-of : le payoff de l'option (asiatique,
+    // barrire, lookback) est appliqu  la trajectoire agrge sum / diffrence / min des w_a S_a
+    static MonteCarloResult run(const ExoticOption& option, const MultiAssetModel& model, BasketType type,
+                                const std::vector<double>& weights, int numPaths, int steps, double maturity,
+                                std::mt19937& rng, unsigned numThreads = 0);
+
+    // Delta par diffrences finies centres sur [0, maturity] : chaque tirage donne deux trajectoires,
+    // issues de spot + epsilon et de spot - epsilon, et le delta est la moyenne actualise des carts
+    // de payoff diviss par 2 epsilon. Les exponentielles sont calcules une fois pour les deux spots ;
+    // l'erreur standard est celle des carts apparis
+    static MonteCarloDelta runDelta(const ExoticOption& option, const BlackScholesModel& model, double epsilon,
+                                    int numPaths, int steps, double maturity, std::mt19937& rng);
+
+    // Prix et sensibilits au premier ordre en un seul passage direct + inverse (AAD)
+    // Chaque trajectoire est enregistre sur la bande, puis un balayage arrire donne
+    // les drives par rapport  spot, volatility, rate et dividend simultanment.
+    // barrierSmoothing est la largeur de lissage des indicatrices, relative  la barrire
+    static MonteCarloGreeks runGreeks(const ExoticOption& option, const BlackScholesModel& model,
+                                      int numPaths, int steps, double maturity, std::mt19937& rng,
+                                      double barrierSmoothing = 0.01);
+
+    // Compare les simulations float et double sur les mmes nombres alatoires
+    static PrecisionReport comparePrecision(const ExoticOption& option, const BlackScholesModel& model,
+                                            int numPaths, int steps, unsigned seed);
+
+    // Affiche le rapport de validation
+    static void printReport(const PrecisionReport& report, std::ostream& out);
+};
+
+#endif // MONTE_CARLO_ENGINE_H
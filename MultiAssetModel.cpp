@@ -0,0 +1,137 @@
+#include "MultiAssetModel.h"
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "PathArena.h"          // Mmoire de travail (normales, log-spots par bloc)
+#include <algorithm>            // Pour std::fill et std::min
+#include <cmath>                // Pour std::exp, std::log, std::sqrt, std::fabs
+#include <stdexcept>            // Pour std::invalid_argument
+
+// Nombre de trajectoires par bloc de simulation (n lignes de BLOCK_PATHS doubles restent en cache)
+const int MultiAssetModel::BLOCK_PATHS;
+
+// Constructeur : vrifications et factorisation de Cholesky de la corrlation
+MultiAssetModel::MultiAssetModel(const std::vector<double>& spots_, const std::vector<double>& volatilities_,
+                                 const std::vector<double>& dividends_, double rate_,
+                                 const std::vector<double>& correlation_)
+    : spots(spots_), volatilities(volatilities_), dividends(dividends_), rate(rate_), correlation(correlation_) {
+    const std::size_t n = spots.size();
+    if (n == 0 || volatilities.size() != n || dividends.size() != n || correlation.size() != n * n) {
+        throw std::invalid_argument("MultiAssetModel requires one spot, volatility and dividend per asset and an n x n correlation.");
+    }
+
+    cholesky.assign(n * n, 0.0);
+    for (std::size_t a = 0; a < n; ++a) {
+        if (std::fabs(correlation[a * n + a] - 1.0) > 1e-12) {
+            throw std::invalid_argument("MultiAssetModel correlation matrix must have a unit diagonal.");
+        }
+        for (std::size_t b = 0; b <= a; ++b) {
+            if (std::fabs(correlation[a * n + b] - correlation[b * n + a]) > 1e-12) {
+                throw std::invalid_argument("MultiAssetModel correlation matrix must be symmetric.");
+            }
+            double sum = correlation[a * n + b];
+            for (std::size_t k = 0; k < b; ++k) sum -= cholesky[a * n + k] * cholesky[b * n + k];
+            if (a == b) {
+                if (!(sum > 0.0)) {
+                    throw std::invalid_argument("MultiAssetModel correlation matrix must be positive definite.");
+                }
+                cholesky[a * n + a] = std::sqrt(sum);
+            } else {
+                cholesky[a * n + b] = sum / cholesky[b * n + b];
+            }
+        }
+    }
+}
+
+// Trajectoire agrge  une date : spots[a * count + i] est le spot de l'actif a sur la trajectoire i
+static void aggregate(BasketType type, const std::vector<double>& weights, const double* spots, int numAssets,
+                      int count, double* out) {
+    switch (type) {
+    case BasketType::Basket:
+        for (int i = 0; i < count; ++i) out[i] = weights[0] * spots[i];
+        for (int a = 1; a < numAssets; ++a) {
+            const double* s = spots + a * count;
+            for (int i = 0; i < count; ++i) out[i] += weights[a] * s[i];
+        }
+        break;
+    case BasketType::Spread:
+        for (int i = 0; i < count; ++i) out[i] = weights[0] * spots[i] - weights[1] * spots[count + i];
+        break;
+    case BasketType::WorstOf:
+        for (int i = 0; i < count; ++i) out[i] = weights[0] * spots[i];
+        for (int a = 1; a < numAssets; ++a) {
+            const double* s = spots + a * count;
+            for (int i = 0; i < count; ++i) out[i] = std::min(out[i], weights[a] * s[i]);
+        }
+        break;
+    }
+}
+
+// Simulation par blocs : normales indpendantes, produit L Z, avance des log-spots, agrgation
+void MultiAssetModel::simulate(int numPaths, int steps, BasketType type, const std::vector<double>& weights,
+                               double maturity, std::mt19937& rng, const PathBlockVisitor& visit,
+                               unsigned numThreads) const {
+    const int n = numAssets();
+    if (static_cast<int>(weights.size()) != n) {
+        throw std::invalid_argument("MultiAssetModel::simulate requires one weight per asset.");
+    }
+    if (type == BasketType::Spread && n != 2) {
+        throw std::invalid_argument("A spread requires exactly two assets.");
+    }
+
+    const double dt = maturity / steps;
+
+    // Drive et diffusion par actif
+    std::vector<double> drift(n), diffusion(n), logSpot0(n);
+    for (int a = 0; a < n; ++a) {
+        drift[a] = (rate - dividends[a] - 0.5 * volatilities[a] * volatilities[a]) * dt;
+        diffusion[a] = volatilities[a] * std::sqrt(dt);
+        logSpot0[a] = std::log(spots[a]);
+    }
+
+    // Date 0 : mme valeur agrge pour toutes les trajectoires
+    double initial;
+    aggregate(type, weights, spots.data(), n, 1, &initial);
+    simulateBlocks(numPaths, steps, BLOCK_PATHS, initial, rng,
+                   [&](double* block, std::size_t pitch, int count, std::mt19937& blockRng) {
+        PathArena::Scope scope; // Tampons du bloc, rendus  la fin du bloc
+        double* normals = scope.allocate(static_cast<std::size_t>(n) * count);    // Z
+        double* correlated = scope.allocate(static_cast<std::size_t>(n) * count); // L Z
+        double* logSpot = scope.allocate(static_cast<std::size_t>(n) * count);
+        double* spot = scope.allocate(static_cast<std::size_t>(n) * count);
+        for (int a = 0; a < n; ++a) std::fill(logSpot + a * count, logSpot + (a + 1) * count, logSpot0[a]);
+
+        for (int j = 0; j < steps; ++j) {
+            NormalDistribution::sample(blockRng, normals, static_cast<std::size_t>(n) * count);
+
+            // Produit L Z : la ligne a de L Z est une combinaison des lignes 0..a de Z
+            for (int a = 0; a < n; ++a) {
+                double* row = correlated + a * count;
+                const double l0 = cholesky[a * n];
+                for (int i = 0; i < count; ++i) row[i] = l0 * normals[i];
+                for (int k = 1; k <= a; ++k) {
+                    const double lk = cholesky[a * n + k];
+                    const double* z = normals + k * count;
+                    for (int i = 0; i < count; ++i) row[i] += lk * z[i];
+                }
+            }
+
+            // Avance des log-spots de tous les actifs
+            for (int a = 0; a < n; ++a) {
+                double* x = logSpot + a * count;
+                double* s = spot + a * count;
+                const double* w = correlated + a * count;
+                for (int i = 0; i < count; ++i) {
+                    x[i] += drift[a] + diffusion[a] * w[i];
+                    s[i] = std::exp(x[i]);
+                }
+            }
+
+            aggregate(type, weights, spot, n, count, block + static_cast<std::size_t>(j + 1) * pitch);
+        }
+    }, visit, numThreads);
+}
+
+// Recopie des blocs dans la matrice
+void MultiAssetModel::simulate(PathMatrix& paths, BasketType type, const std::vector<double>& weights,
+                               double maturity, std::mt19937& rng, unsigned numThreads) const {
+    simulate(paths.numPaths(), paths.numSteps(), type, weights, maturity, rng, copyBlocksTo(paths), numThreads);
+}
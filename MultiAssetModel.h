@@ -0,0 +1,57 @@
+#ifndef MULTI_ASSET_MODEL_H
+#define MULTI_ASSET_MODEL_H
+
+#include "BasketType.h"
+#include "PathMatrix.h"
+#include <random> // Pour std::mt19937
+#include <vector> // Pour les paramtres par actif et la matrice de corrlation
+
+// Modle de Black-Scholes  plusieurs sous-jacents corrls
+//   dS_a / S_a = (r - q_a) dt + sigma_a dW_a,  d<W_a, W_b> = rho_ab dt
+// Le facteur de Cholesky L de la matrice de corrlation est calcul une fois  la construction ;
+// la corrlation n'est donc accessible qu'en lecture (un autre jeu de corrlations : nouveau modle).
+class MultiAssetModel {
+public:
+    std::vector<double> spots;        // Prix initiaux
+    std::vector<double> volatilities; // Volatilits
+    std::vector<double> dividends;    // Taux de dividende
+    double rate;                      // Taux sans risque commun
+
+    // Constructeur
+    // Lve std::invalid_argument si les tailles sont incohrentes ou si la matrice de corrlation
+    // n'est pas symtrique dfinie positive de diagonale unit
+    MultiAssetModel(const std::vector<double>& spots_, const std::vector<double>& volatilities_,
+                    const std::vector<double>& dividends_, double rate_, const std::vector<double>& correlation_);
+
+    // Nombre de sous-jacents
+    int numAssets() const { return static_cast<int>(spots.size()); }
+
+    // Matrice de corrlation n x n (ligne par ligne)
+    const std::vector<double>& correlationMatrix() const { return correlation; }
+
+    // Facteur de Cholesky (triangle infrieur, n x n ligne par ligne)
+    const std::vector<double>& choleskyFactor() const { return cholesky; }
+
+    // Trajectoires par bloc de simulation
+    static const int BLOCK_PATHS = 256;
+
+    // Simule les n actifs sur [0, maturity] (numPaths trajectoires de steps pas) et passe  visit,
+    // bloc par bloc, la trajectoire agrge (type, weights).
+    // Pour chaque bloc de trajectoires et chaque pas, les normales indpendantes Z (n x bloc) sont
+    // corrles par le produit matriciel L Z, calcul ligne par ligne comme combinaisons de lignes
+    // contigus de Z (boucles vectorises sur les trajectoires) plutt que trajectoire par trajectoire.
+    // Seule la trajectoire agrge est conserve. Blocs en parallle, une graine par bloc tire de rng.
+    // Lve std::invalid_argument si weights n'a pas une valeur par actif (ou si Spread n'a pas deux actifs)
+    void simulate(int numPaths, int steps, BasketType type, const std::vector<double>& weights, double maturity,
+                  std::mt19937& rng, const PathBlockVisitor& visit, unsigned numThreads = 0) const;
+
+    // Mme simulation, recopie dans paths
+    void simulate(PathMatrix& paths, BasketType type, const std::vector<double>& weights, double maturity,
+                  std::mt19937& rng, unsigned numThreads = 0) const;
+
+private:
+    std::vector<double> correlation; // Matrice de corrlation, factorise dans cholesky
+    std::vector<double> cholesky;    // Facteur L de la matrice de corrlation
+};
+
+#endif // MULTI_ASSET_MODEL_H
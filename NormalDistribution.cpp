@@ -0,0 +1,191 @@
+#include "NormalDistribution.h"
+#include <cmath>   // Pour std::exp, std::log, std::sqrt, std::fabs
+#include <algorithm> // Pour std::min et std::max
+#include <limits>  // Pour std::numeric_limits
+
+// Constantes usuelles
+static const double SQRT_2PI = 2.50662827463100050242; // sqrt(2 * pi)
+static const double INV_SQRT_2PI = 0.39894228040143267794; // 1 / sqrt(2 * pi)
+
+// Coefficients de l'algorithme 5666 de Hart pour la fonction de rpartition
+static const double HART_P[7] = {
+    3.52624965998911e-02, 0.700383064443688, 6.37396220353165, 33.912866078383,
+    112.079291497871, 221.213596169931, 220.206867912376
+};
+static const double HART_Q[8] = {
+    8.83883476483184e-02, 1.75566716318264, 16.064177579207, 86.7807322029461,
+    296.564248779674, 637.333633378831, 793.826512519948, 440.413735824752
+};
+
+// Coefficients de l'algorithme d'Acklam pour l'inverse de la fonction de rpartition
+static const double ACKLAM_A[6] = {
+    -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+    1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00
+};
+static const double ACKLAM_B[5] = {
+    -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+    6.680131188771972e+01, -1.328068155288572e+01
+};
+static const double ACKLAM_C[6] = {
+    -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+    -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00
+};
+static const double ACKLAM_D[4] = {
+    7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+    3.754408661907416e+00
+};
+static const double ACKLAM_P_LOW = 0.02425; // Frontire entre la rgion centrale et les queues
+
+// Noyau de la densit (sans branchement)
+static inline double pdfKernel(double x) {
+    return INV_SQRT_2PI * std::exp(-0.5 * x * x);
+}
+
+// Noyau de la fonction de rpartition (sans branchement)
+// Les deux rgions de Hart (fraction rationnelle et fraction continue) sont values
+// puis la bonne valeur est slectionne, ce qui permet la vectorisation de la boucle
+static inline double cdfKernel(double x) {
+    double xAbs = std::fabs(x);
+    double e = std::exp(-0.5 * xAbs * xAbs);
+
+    // Rgion |x| < 7.07 : fraction rationnelle
+    double num = HART_P[0];
+    for (int k = 1; k < 7; ++k) num = num * xAbs + HART_P[k];
+    double den = HART_Q[0];
+    for (int k = 1; k < 8; ++k) den = den * xAbs + HART_Q[k];
+    double central = e * num / den;
+
+    // Rgion |x| >= 7.07 : fraction continue
+    double cf = xAbs + 0.65;
+    cf = xAbs + 4.0 / cf;
+    cf = xAbs + 3.0 / cf;
+    cf = xAbs + 2.0 / cf;
+    cf = xAbs + 1.0 / cf;
+    double tail = e / cf / SQRT_2PI;
+
+    double lower = (xAbs < 7.07106781186547) ? central : tail;
+    lower = (xAbs > 37.0) ? 0.0 : lower;
+    return (x > 0.0) ? 1.0 - lower : lower;
+}
+
+// Noyau de l'inverse d'Acklam (sans branchement)
+// crit pour T = double ou float : en simple prcision la largeur SIMD est double
+template <typename T>
+static inline T inverseCdfKernel(T p) {
+    const T half = T(0.5);
+    const T one = T(1.0);
+
+    // Rgion centrale
+    T q = p - half;
+    T r = q * q;
+    T num = T(ACKLAM_A[0]);
+    for (int k = 1; k < 6; ++k) num = num * r + T(ACKLAM_A[k]);
+    T den = T(ACKLAM_B[0]);
+    for (int k = 1; k < 5; ++k) den = den * r + T(ACKLAM_B[k]);
+    den = den * r + one;
+    T central = num * q / den;
+
+    // Queues (on travaille sur la plus petite des probabilits p et 1 - p)
+    T pTail = (p < half) ? p : one - p;
+    T t = std::sqrt(T(-2.0) * std::log(pTail));
+    T numTail = T(ACKLAM_C[0]);
+    for (int k = 1; k < 6; ++k) numTail = numTail * t + T(ACKLAM_C[k]);
+    T denTail = T(ACKLAM_D[0]);
+    for (int k = 1; k < 4; ++k) denTail = denTail * t + T(ACKLAM_D[k]);
+    denTail = denTail * t + one;
+    T tail = numTail / denTail; // Valeur ngative (queue gauche)
+    tail = (p < half) ? tail : -tail;
+
+    T x = (pTail < T(ACKLAM_P_LOW)) ? tail : central;
+
+    // Bornes : p <= 0 ou p >= 1
+    x = (p <= T(0.0)) ? -std::numeric_limits<T>::infinity() : x;
+    x = (p >= one) ? std::numeric_limits<T>::infinity() : x;
+    return x;
+}
+
+// Inverse raffin par une itration de Halley sur cdf
+// Le raffinement est fait dans la moiti gauche (p < 0.5) o cdf est prcise en relatif,
+// puis le rsultat est symtris (1 - p est exact pour p >= 0.5)
+static inline double refinedInverseKernel(double p) {
+    double pLow = (p < 0.5) ? p : 1.0 - p;
+    double x = inverseCdfKernel(pLow);
+    double e = cdfKernel(x) - pLow;
+    double u = e * SQRT_2PI * std::exp(0.5 * x * x);
+    double refined = x - u / (1.0 + 0.5 * x * u);
+    refined = std::isfinite(x) ? refined : x; // Pas de raffinement aux bornes
+    return (p < 0.5) ? refined : -refined;
+}
+
+// Densit de la loi normale standard
+double NormalDistribution::pdf(double x) {
+    return pdfKernel(x);
+}
+
+// Fonction de rpartition de la loi normale standard
+double NormalDistribution::cdf(double x) {
+    return cdfKernel(x);
+}
+
+// Inverse de la fonction de rpartition avec raffinement de Halley
+double NormalDistribution::inverseCdf(double p) {
+    return refinedInverseKernel(p);
+}
+
+// Inverse de la fonction de rpartition d'Acklam, sans raffinement
+double NormalDistribution::inverseCdfFast(double p) {
+    return inverseCdfKernel(p);
+}
+
+// Versions vectorises (boucles sans dpendance ni branchement)
+void NormalDistribution::pdf(const double* x, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = pdfKernel(x[i]);
+    }
+}
+
+void NormalDistribution::cdf(const double* x, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = cdfKernel(x[i]);
+    }
+}
+
+void NormalDistribution::inverseCdf(const double* p, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = refinedInverseKernel(p[i]);
+    }
+}
+
+void NormalDistribution::inverseCdfFast(const double* p, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = inverseCdfKernel(p[i]);
+    }
+}
+
+void NormalDistribution::inverseCdfFast(const float* p, float* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = inverseCdfKernel(p[i]);
+    }
+}
+
+// Tirages normaux en double : uniformes sur ]0, 1[ puis inversion en bloc
+void NormalDistribution::sample(std::mt19937& rng, double* out, std::size_t n) {
+    std::uniform_real_distribution<> uniform(std::numeric_limits<double>::min(), 1.0); // Uniforme sur ]0, 1[
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = uniform(rng);
+    }
+    inverseCdfFast(out, out, n);
+}
+
+// Tirages normaux en float : mmes uniformes que la version double (mmes appels  rng),
+// arrondis en float et ramens dans ]0, 1[ ; seule l'inversion change de prcision
+void NormalDistribution::sample(std::mt19937& rng, float* out, std::size_t n) {
+    std::uniform_real_distribution<> uniform(std::numeric_limits<double>::min(), 1.0); // Uniforme sur ]0, 1[
+    const float lowest = std::numeric_limits<float>::min();
+    const float highest = 1.0f - std::numeric_limits<float>::epsilon() * 0.5f; // Plus grand float < 1
+    for (std::size_t i = 0; i < n; ++i) {
+        float u = static_cast<float>(uniform(rng));
+        out[i] = std::min(std::max(u, lowest), highest);
+    }
+    inverseCdfFast(out, out, n);
+}
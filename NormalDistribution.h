@@ -0,0 +1,50 @@
+#ifndef NORMAL_DISTRIBUTION_H
+#define NORMAL_DISTRIBUTION_H
+
+#include <cstddef> // Pour std::size_t
+#include <random>  // Pour std::mt19937
+
+// Fonctions de la loi normale standard partages par tous les pricers
+// (formule analytique, couverture, simulation Monte-Carlo et inversion quasi-Monte-Carlo)
+//
+// Prcision :
+// - cdf : algorithme 5666 de Hart (1968), erreur absolue < 1e-14 sur tout R
+// - inverseCdfFast : algorithme d'Acklam, erreur relative < 1.15e-9 sur ]0, 1[
+// - inverseCdf : Acklam suivi d'une itration de Halley sur cdf, erreur relative < 1e-10
+//   pour p dans [1e-10, 1 - 1e-10] (limite au-del par la prcision relative de cdf)
+//
+// Les versions sur tableaux sont crites sans branchement (calcul des deux rgions
+// puis slection) afin que le compilateur puisse les vectoriser (SIMD).
+// L'inversion est sans rejet : un uniforme donne exactement un tirage normal,
+// ce qui est indispensable pour la vectorisation et pour les suites quasi-alatoires.
+class NormalDistribution {
+public:
+    // Densit de la loi normale standard
+    static double pdf(double x);
+
+    // Fonction de rpartition de la loi normale standard
+    static double cdf(double x);
+
+    // Inverse de la fonction de rpartition (quantile), prcision machine
+    static double inverseCdf(double p);
+
+    // Inverse de la fonction de rpartition sans raffinement (pour la simulation)
+    static double inverseCdfFast(double p);
+
+    // Versions vectorises : out[i] = f(in[i]) pour i dans [0, n)
+    static void pdf(const double* x, double* out, std::size_t n);
+    static void cdf(const double* x, double* out, std::size_t n);
+    static void inverseCdf(const double* p, double* out, std::size_t n);
+    static void inverseCdfFast(const double* p, double* out, std::size_t n);
+
+    // Version simple prcision de l'inversion (simulation Monte-Carlo en float)
+    static void inverseCdfFast(const float* p, float* out, std::size_t n);
+
+    // Tire n normales standard par inversion d'uniformes de ]0, 1[ (sans rejet)
+    // Les deux versions consomment rng de la mme faon (nombres alatoires communs) ;
+    // en float la queue droite est tronque  environ 5.3 carts-types
+    static void sample(std::mt19937& rng, double* out, std::size_t n);
+    static void sample(std::mt19937& rng, float* out, std::size_t n);
+};
+
+#endif // NORMAL_DISTRIBUTION_H
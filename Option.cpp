@@ -1,6 +1,17 @@
 #include "Option.h"
+#include "PricingKey.h"
 
 Option::Option(double strike_, double maturity_)
     : strike(strike_), maturity(maturity_) {}
 
+// Contexte par dfaut transmis  la version virtuelle
+double Option::hedgeCost(const BlackScholesModel& model, int steps) const {
+    return hedgeCost(model, steps, PricingContext::fromEntropy());
+}
+
+// Champs communs  toutes les options
+void Option::appendKey(PricingKey& key) const {
+    key.add(strike).add(maturity);
+}
+
 Option::~Option() {}
@@ -1,8 +1,11 @@
 #ifndef OPTION_H
 #define OPTION_H
 
+#include "PricingContext.h" // Graine des nombres alatoires
+
 // Dclaration forward de la classe BlackScholesModel
 class BlackScholesModel;
+class PricingKey;
 
 // Classe abstraite Option
 class Option {
@@ -17,7 +20,17 @@ public:
     virtual double payoff(double spot) const = 0;
 
     // Mthode virtuelle pure pour la rplication (base sur Black-Scholes)
-    virtual double hedgeCost(const BlackScholesModel& model, int steps) const = 0;
+    // La trajectoire couverte (et les prix Monte-Carlo des deltas) sont tirs  partir de context :
+    // mme contexte, mme cot, bit  bit
+    virtual double hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context) const = 0;
+
+    // Rplication sans contexte : graine tire de std::random_device (PricingContext::fromEntropy),
+    // comme pour les prix Monte-Carlo ; passer un contexte pour un rsultat reproductible
+    double hedgeCost(const BlackScholesModel& model, int steps) const;
+
+    // Ajoute  la cl de cache le nom du produit puis tous les champs qui dterminent son prix
+    // (par dfaut strike et maturit ; chaque produit ajoute son nom et ses propres champs)
+    virtual void appendKey(PricingKey& key) const;
 
     // Destructeur virtuel
     virtual ~Option();
@@ -0,0 +1,92 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "ThreadPool.h"         // Threads persistants partags
+#include <algorithm>            // Pour std::min et std::max
+#include <atomic>               // Attribution des blocs
+#include <condition_variable>   // Attente de la fin des blocs
+#include <cstddef>              // Pour std::size_t
+#include <exception>            // Pour std::exception_ptr
+#include <memory>               // Pour std::shared_ptr
+#include <mutex>                // Pour std::mutex
+#include <thread>               // Pour std::thread::hardware_concurrency
+
+// Nombre de threads utiliss par dfaut (nombre de coeurs disponibles)
+inline unsigned defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// tat partag entre l'appelant de parallelFor et les tches d'aide du ThreadPool
+// Une tche d'aide excute aprs la fin de la boucle ne trouve plus de bloc  prendre et ne
+// touche pas func : l'tat lui survit grce au std::shared_ptr.
+template <typename Func>
+struct ParallelForState {
+    Func* func;
+    std::size_t n;
+    std::size_t chunkSize;
+    std::size_t chunks;
+    std::atomic<std::size_t> next;   // Prochain bloc  attribuer
+    std::size_t remaining;           // Blocs non termins (protg par mutex)
+    std::exception_ptr failure;      // Premire exception leve par un bloc
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    // Traite des blocs tant qu'il en reste  attribuer
+    void work() {
+        for (std::size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            std::exception_ptr error;
+            try {
+                (*func)(c * chunkSize, std::min(n, (c + 1) * chunkSize));
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error && !failure) failure = error;
+            if (--remaining == 0) finished.notify_all();
+        }
+    }
+};
+
+// Dcoupe l'intervalle [0, n) en blocs contigus et les traite en parallle
+// func(begin, end) est appele une fois par bloc ; grain est la taille minimale d'un bloc
+// Les blocs sont excuts par le thread appelant et par les threads persistants de
+// ThreadPool::shared() : aucun thread n'est cr par appel, et les PathArena de ces threads restent
+// chauffes d'un appel  l'autre. L'appelant prend lui-mme des blocs jusqu' puisement et n'attend
+// que ceux dj commencs par d'autres threads : un appel depuis un thread du groupe (AsyncPricer,
+// PortfolioPricer) ne peut pas se bloquer et n'ajoute pas de threads. La premire exception leve
+// par un bloc est relance dans l'appelant, une fois tous les blocs commencs termins.
+template <typename Func>
+void parallelFor(std::size_t n, std::size_t grain, Func func, unsigned numThreads = 0) {
+    if (n == 0) return;
+    if (numThreads == 0) numThreads = defaultThreadCount();
+    grain = std::max<std::size_t>(grain, 1);
+
+    std::size_t maxChunks = (n + grain - 1) / grain;
+    std::size_t chunks = std::min<std::size_t>(numThreads, maxChunks);
+    if (chunks <= 1) {
+        func(std::size_t(0), n); // Pas de paralllisme utile
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState<Func> >();
+    state->func = &func;
+    state->n = n;
+    state->chunkSize = (n + chunks - 1) / chunks;
+    state->chunks = (n + state->chunkSize - 1) / state->chunkSize;
+    state->next = 0;
+    state->remaining = state->chunks;
+
+    ThreadPool& pool = ThreadPool::shared();
+    std::size_t helpers = std::min<std::size_t>(state->chunks - 1, pool.size());
+    for (std::size_t h = 0; h < helpers; ++h) {
+        pool.post([state]() { state->work(); });
+    }
+    state->work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() { return state->remaining == 0; });
+    if (state->failure) std::rethrow_exception(state->failure);
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,75 @@
+#include "PathArena.h"
+#include <algorithm> // Pour std::max
+#include <atomic>    // Pour le compteur global d'allocations
+#include <new>       // Pour operator new align
+
+// Taille minimale d'un bloc (en doubles, soit 512 Ko)
+static const std::size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+// Compteur global des allocations systme
+static std::atomic<std::size_t> systemAllocations(0);
+
+// Arne propre au thread appelant
+PathArena& PathArena::local() {
+    thread_local PathArena arena;
+    return arena;
+}
+
+// Nombre total d'allocations systme effectues
+std::size_t PathArena::allocationCount() {
+    return systemAllocations.load(std::memory_order_relaxed);
+}
+
+// Constructeur : arne vide, les blocs sont crs  la demande
+PathArena::PathArena() : currentBlock(0), offset(0) {}
+
+// Destructeur : rend tous les blocs au systme
+PathArena::~PathArena() {
+    for (Block& block : blocks) {
+        ::operator delete(block.data, std::align_val_t(ALIGNMENT));
+    }
+}
+
+// Rserve n doubles aligns
+double* PathArena::allocate(std::size_t n) {
+    // Arrondi au multiple de l'alignement pour que le tampon suivant reste align
+    const std::size_t perLine = ALIGNMENT / sizeof(double);
+    n = std::max<std::size_t>((n + perLine - 1) / perLine * perLine, perLine);
+
+    // Recherche d'un bloc assez grand  partir du bloc courant
+    while (currentBlock < blocks.size() && offset + n > blocks[currentBlock].capacity) {
+        ++currentBlock;
+        offset = 0;
+    }
+
+    // Aucun bloc disponible : allocation d'un nouveau bloc (seul appel au systme)
+    if (currentBlock == blocks.size()) {
+        std::size_t capacity = std::max(n, MIN_BLOCK_SIZE);
+        double* data = static_cast<double*>(::operator new(capacity * sizeof(double), std::align_val_t(ALIGNMENT)));
+        blocks.push_back(Block{data, capacity});
+        systemAllocations.fetch_add(1, std::memory_order_relaxed);
+        offset = 0;
+    }
+
+    double* result = blocks[currentBlock].data + offset;
+    offset += n;
+    return result;
+}
+
+// Porte sur l'arne du thread courant
+PathArena::Scope::Scope() : Scope(PathArena::local()) {}
+
+// Porte sur une arne donne : mmorise la position courante
+PathArena::Scope::Scope(PathArena& arena_)
+    : arena(arena_), savedBlock(arena_.currentBlock), savedOffset(arena_.offset) {}
+
+// Restaure la position mmorise (libration en pile)
+PathArena::Scope::~Scope() {
+    arena.currentBlock = savedBlock;
+    arena.offset = savedOffset;
+}
+
+// Raccourci vers PathArena::allocate
+double* PathArena::Scope::allocate(std::size_t n) {
+    return arena.allocate(n);
+}
@@ -0,0 +1,74 @@
+#ifndef PATH_ARENA_H
+#define PATH_ARENA_H
+
+#include <cstddef> // Pour std::size_t
+#include <vector>  // Pour la liste des blocs
+
+// Arne mmoire par thread pour les tampons de travail des trajectoires Monte-Carlo
+//
+// Les allocations se font par simple incrment d'un pointeur dans des blocs aligns
+// qui ne sont jamais rendus au systme : une fois l'arne chauffe, simuler une trajectoire
+// (ou un prix imbriqu dans hedgeCost) ne fait plus aucun malloc/free.
+// La libration se fait en pile via PathArena::Scope, ce qui autorise les appels imbriqus.
+class PathArena {
+public:
+    // Alignement des tampons (une ligne de cache, compatible AVX-512)
+    static const std::size_t ALIGNMENT = 64;
+
+    // Arne propre au thread appelant
+    static PathArena& local();
+
+    // Nombre total d'allocations systme effectues par toutes les arnes
+    // (permet de vrifier que la boucle chaude ne fait plus d'allocation)
+    static std::size_t allocationCount();
+
+    // Rserve n doubles aligns, valides jusqu' la fin de la porte courante
+    double* allocate(std::size_t n);
+
+    // Rserve n lments de type T (double ou float), aligns
+    template <typename T>
+    T* allocateAs(std::size_t n) {
+        return reinterpret_cast<T*>(allocate((n * sizeof(T) + sizeof(double) - 1) / sizeof(double)));
+    }
+
+    // Porte RAII : tout ce qui est allou pendant sa dure de vie est rendu  sa destruction
+    class Scope {
+    public:
+        Scope();
+        explicit Scope(PathArena& arena_);
+        ~Scope();
+
+        // Raccourci vers PathArena::allocate
+        double* allocate(std::size_t n);
+
+        // Raccourci vers PathArena::allocateAs
+        template <typename T>
+        T* allocateAs(std::size_t n) { return arena.allocateAs<T>(n); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PathArena& arena;
+        std::size_t savedBlock;
+        std::size_t savedOffset;
+    };
+
+    PathArena();
+    ~PathArena();
+    PathArena(const PathArena&) = delete;
+    PathArena& operator=(const PathArena&) = delete;
+
+private:
+    // Bloc de mmoire contigu
+    struct Block {
+        double* data;
+        std::size_t capacity; // En nombre de doubles
+    };
+
+    std::vector<Block> blocks; // Blocs allous (jamais librs avant la fin du thread)
+    std::size_t currentBlock;  // Indice du bloc en cours d'utilisation
+    std::size_t offset;        // Position dans le bloc courant
+};
+
+#endif // PATH_ARENA_H
@@ -0,0 +1,129 @@
+#include "PathMatrix.h"
+#include "BlackScholesModel.h"  // Paramtres du modle pour la simulation
+#include "NormalDistribution.h" // Tirages normaux vectoriss
+#include "Parallel.h"           // Pour parallelFor
+#include "PathArena.h"          // Intgrales par pas du modle, blocs de trajectoires
+#include <algorithm>            // Pour std::copy, std::fill et std::min
+#include <cmath>                // Pour std::exp et std::sqrt
+#include <new>                  // Pour operator new align
+#include <utility>              // Pour std::swap
+#include <vector>               // Pour les graines des blocs
+
+// Allocation d'un tableau align
+template <typename T>
+static T* allocateAligned(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(BasicPathMatrix<T>::ALIGNMENT)));
+}
+
+// Constructeur : alloue (numSteps + 1) lignes de pitch lments
+template <typename T>
+BasicPathMatrix<T>::BasicPathMatrix(int numPaths_, int numSteps_)
+    : paths(numPaths_), steps(numSteps_) {
+    const std::size_t perLine = ALIGNMENT / sizeof(T);
+    rowPitch = (static_cast<std::size_t>(paths) + perLine - 1) / perLine * perLine;
+    std::size_t total = rowPitch * (steps + 1);
+    data = allocateAligned<T>(total);
+    std::fill(data, data + total, T(0));
+}
+
+// Destructeur
+template <typename T>
+BasicPathMatrix<T>::~BasicPathMatrix() {
+    ::operator delete(data, std::align_val_t(ALIGNMENT));
+}
+
+// Constructeur de copie
+template <typename T>
+BasicPathMatrix<T>::BasicPathMatrix(const BasicPathMatrix& other)
+    : paths(other.paths), steps(other.steps), rowPitch(other.rowPitch) {
+    std::size_t total = rowPitch * (steps + 1);
+    data = allocateAligned<T>(total);
+    std::copy(other.data, other.data + total, data);
+}
+
+// Oprateur d'affectation
+template <typename T>
+BasicPathMatrix<T>& BasicPathMatrix<T>::operator=(const BasicPathMatrix& other) {
+    if (this != &other) {
+        BasicPathMatrix copy(other);
+        std::swap(paths, copy.paths);
+        std::swap(steps, copy.steps);
+        std::swap(rowPitch, copy.rowPitch);
+        std::swap(data, copy.data);
+    }
+    return *this;
+}
+
+// Simulation Black-Scholes de toutes les trajectoires, pas par pas
+template <typename T>
+void BasicPathMatrix<T>::simulate(const BlackScholesModel& model, double maturity, std::mt19937& rng) {
+    PathArena::Scope scratch; // Intgrales par pas du modle
+    const StepSchedule schedule = model.schedule(maturity, steps, scratch);
+
+    // Date 0 : prix initial (hors dividendes cash) pour toutes les trajectoires
+    std::fill(step(0), step(0) + paths, T(schedule.initialSpot));
+
+    for (int j = 0; j < steps; ++j) {
+        const T* current = step(j);
+        T* next = step(j + 1);
+        const T drift = T(schedule.drift[j]);
+        const T diffusion = T(schedule.diffusion[j]);
+
+        // Tirage des normales de la ligne suivante en bloc (inversion sans rejet)
+        NormalDistribution::sample(rng, next, paths);
+
+        // Avance d'un pas de toutes les trajectoires (accs unitaires)
+        for (int i = 0; i < paths; ++i) {
+            next[i] = current[i] * std::exp(drift + diffusion * next[i]);
+        }
+    }
+
+    // Dividendes cash : valeur actualise des dividendes restants rajoute ligne par ligne
+    if (schedule.hasCashDividends) {
+        for (int j = 0; j <= steps; ++j) {
+            const T offset = T(schedule.dividendOffset[j]);
+            T* row = step(j);
+            for (int i = 0; i < paths; ++i) row[i] += offset;
+        }
+    }
+}
+
+// Recopie ligne par ligne dans la matrice complte
+void PathBlock::copyTo(PathMatrix& paths) const {
+    for (int j = 0; j <= steps; ++j) {
+        const double* row = data + j * pitch;
+        std::copy(row, row + count, paths.step(j) + first);
+    }
+}
+
+// Une graine par bloc, tire dans l'ordre des blocs ; chaque thread simule ses blocs dans son arne
+void simulateBlocks(int numPaths, int steps, int blockPaths, double initial, std::mt19937& rng,
+                    const PathBlockKernel& kernel, const PathBlockVisitor& visit, unsigned numThreads) {
+    const int numBlocks = (numPaths + blockPaths - 1) / blockPaths;
+    std::vector<std::mt19937::result_type> seeds(numBlocks);
+    for (int b = 0; b < numBlocks; ++b) seeds[b] = rng();
+
+    const std::size_t pitch = static_cast<std::size_t>(blockPaths);
+    parallelFor(numBlocks, 1, [&](std::size_t beginBlock, std::size_t endBlock) {
+        PathArena::Scope scope; // Arne du thread de travail
+        double* block = scope.allocate(static_cast<std::size_t>(steps + 1) * pitch);
+
+        for (std::size_t b = beginBlock; b < endBlock; ++b) {
+            std::mt19937 blockRng(seeds[b]);
+            const int first = static_cast<int>(b) * blockPaths;
+            const int count = std::min(blockPaths, numPaths - first);
+            std::fill(block, block + count, initial);
+            kernel(block, pitch, count, blockRng);
+            visit(PathBlock{block, pitch, static_cast<int>(b), first, count, steps});
+        }
+    }, numThreads);
+}
+
+// Recopie des blocs dans la matrice
+PathBlockVisitor copyBlocksTo(PathMatrix& paths) {
+    return [&paths](const PathBlock& block) { block.copyTo(paths); };
+}
+
+// Instanciations explicites (double et simple prcision)
+template class BasicPathMatrix<double>;
+template class BasicPathMatrix<float>;
@@ -0,0 +1,134 @@
+#ifndef PATH_MATRIX_H
+#define PATH_MATRIX_H
+
+#include <cstddef>    // Pour std::size_t et std::ptrdiff_t
+#include <functional> // Pour std::function
+#include <random>     // Pour std::mt19937
+
+class BlackScholesModel;
+
+// Vue en lecture sur une trajectoire (prix initial en position 0)
+// Le pas (stride) permet de parcourir une colonne d'une PathMatrix comme un tableau contigu
+// T vaut double ou float (simulation en simple prcision)
+template <typename T>
+class BasicPathView {
+public:
+    // Constructeur sur un tampon de size prix espacs de stride lments
+    BasicPathView(const T* data_, int size_, std::ptrdiff_t stride_ = 1)
+        : data(data_), length(size_), stride(stride_) {}
+
+    // Accs au prix  la date i
+    T operator[](int i) const { return data[i * stride]; }
+
+    // Nombre de dates (prix initial inclus)
+    int size() const { return length; }
+
+    // Dernier prix de la trajectoire
+    T back() const { return data[(length - 1) * stride]; }
+
+private:
+    const T* data;
+    int length;
+    std::ptrdiff_t stride;
+};
+
+typedef BasicPathView<double> PathView;
+typedef BasicPathView<float> PathViewF;
+
+// Matrice de trajectoires contigu et aligne, stocke par pas de temps (time-major) :
+// la ligne j contient le prix de toutes les trajectoires  la date j, ce qui permet
+// de faire avancer un pas sur toutes les trajectoires avec des accs unitaires (SIMD).
+// La ligne 0 contient le prix initial ; les payoffs lisent une trajectoire via path(i).
+// La version float (PathMatrixF) double la largeur SIMD et divise par deux la bande passante.
+template <typename T>
+class BasicPathMatrix {
+public:
+    // Alignement des lignes (une ligne de cache)
+    static const std::size_t ALIGNMENT = 64;
+
+    // Constructeur : numPaths trajectoires de numSteps pas (numSteps + 1 dates)
+    BasicPathMatrix(int numPaths_, int numSteps_);
+    ~BasicPathMatrix();
+
+    BasicPathMatrix(const BasicPathMatrix& other);
+    BasicPathMatrix& operator=(const BasicPathMatrix& other);
+
+    // Dimensions
+    int numPaths() const { return paths; }
+    int numSteps() const { return steps; }
+
+    // cart (en lments) entre deux lignes conscutives, multiple de l'alignement
+    std::size_t pitch() const { return rowPitch; }
+
+    // Ligne j (toutes les trajectoires  la date j), aligne
+    T* step(int j) { return data + j * rowPitch; }
+    const T* step(int j) const { return data + j * rowPitch; }
+
+    // Accs lmentaire (date j, trajectoire i)
+    T& operator()(int j, int i) { return data[j * rowPitch + i]; }
+    T operator()(int j, int i) const { return data[j * rowPitch + i]; }
+
+    // Vue sur la trajectoire i pour les payoffs (accs path-major)
+    BasicPathView<T> path(int i) const {
+        return BasicPathView<T>(data + i, steps + 1, static_cast<std::ptrdiff_t>(rowPitch));
+    }
+
+    // Vue sur la trajectoire i tronque  la date lastStep incluse (exercice anticip)
+    BasicPathView<T> path(int i, int lastStep) const {
+        return BasicPathView<T>(data + i, lastStep + 1, static_cast<std::ptrdiff_t>(rowPitch));
+    }
+
+    // Simule toutes les trajectoires sous Black-Scholes sur [0, maturity]
+    // Chaque pas tire les normales de la ligne en bloc puis avance toutes les trajectoires
+    void simulate(const BlackScholesModel& model, double maturity, std::mt19937& rng);
+
+private:
+    int paths;
+    int steps;
+    std::size_t rowPitch;
+    T* data;
+};
+
+typedef BasicPathMatrix<double> PathMatrix;
+typedef BasicPathMatrix<float> PathMatrixF;
+
+// Bloc de trajectoires simul dans la mmoire de travail d'un thread (modles de Heston, 
+// volatilit locale,  sauts et multi-actifs) : le prix  la date j de la trajectoire first + i est
+// data[j * pitch + i], pour i < count. Le bloc n'est valide que pendant l'appel du visiteur.
+struct PathBlock {
+    const double* data;
+    std::size_t pitch; // cart entre deux dates
+    int index;         // Numro du bloc, dans l'ordre des trajectoires
+    int first;         // Indice de la premire trajectoire
+    int count;         // Nombre de trajectoires
+    int steps;         // Nombre de pas
+
+    // Vue sur la trajectoire first + i
+    PathView path(int i) const {
+        return PathView(data + i, steps + 1, static_cast<std::ptrdiff_t>(pitch));
+    }
+
+    // Recopie le bloc dans les colonnes [first, first + count) de paths
+    void copyTo(PathMatrix& paths) const;
+};
+
+// Visiteur appel une fois par bloc simul, depuis les threads de parallelFor (appels concurrents)
+typedef std::function<void(const PathBlock&)> PathBlockVisitor;
+
+// Pas d'un modle sur un bloc de count trajectoires : la date 0 de block est dj remplie, le noyau
+// crit les dates 1  steps (prix de la trajectoire i  la date j en block[j * pitch + i])  partir
+// des nombres de rng. Ses tampons de travail viennent de l'arne du thread (PathArena::Scope)
+typedef std::function<void(double* block, std::size_t pitch, int count, std::mt19937& rng)> PathBlockKernel;
+
+// Simulation par blocs commune aux modles de Heston,  volatilit locale,  sauts et multi-actifs :
+// numPaths trajectoires de steps pas, par blocs de blockPaths traits en parallle. Chaque bloc a son
+// propre gnrateur, de graine tire de rng dans l'ordre des blocs (rsultat indpendant du nombre de
+// threads) ; sa date 0 vaut initial, kernel simule les pas, puis le bloc est pass  visit depuis la
+// mmoire de travail du thread (mmoire indpendante de numPaths)
+void simulateBlocks(int numPaths, int steps, int blockPaths, double initial, std::mt19937& rng,
+                    const PathBlockKernel& kernel, const PathBlockVisitor& visit, unsigned numThreads = 0);
+
+// Visiteur qui recopie chaque bloc dans paths
+PathBlockVisitor copyBlocksTo(PathMatrix& paths);
+
+#endif // PATH_MATRIX_H
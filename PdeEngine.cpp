@@ -0,0 +1,181 @@
+#include "PdeEngine.h"
+#include "BarrierOption.h"
+#include "CallOption.h"
+#include "PathArena.h" // Mmoire de travail de la grille
+#include "PutOption.h"
+#include <algorithm>   // Pour std::min et std::max
+#include <cmath>       // Pour std::exp, std::log, std::sqrt
+#include <stdexcept>   // Pour std::invalid_argument
+
+// Constante de Broadie-Glasserman-Kou : -zeta(1/2) / sqrt(2 pi)
+static const double BGK_BETA = 0.5825971579390106;
+
+// Constructeur du moteur
+PdeEngine::PdeEngine(int spaceSteps_, int timeSteps_, int rannacherSteps_, double numStdDevs_, int monitoringDates_)
+    : spaceSteps(spaceSteps_), timeSteps(timeSteps_), rannacherSteps(rannacherSteps_),
+      numStdDevs(numStdDevs_), monitoringDates(monitoringDates_) {}
+
+// Call europen
+PdeResult PdeEngine::price(const BlackScholesModel& model, const CallOption& option) const {
+    return solve(model, option.strike, option.maturity, OptionType::Call, 0.0, false);
+}
+
+// Put europen
+PdeResult PdeEngine::price(const BlackScholesModel& model, const PutOption& option) const {
+    return solve(model, option.strike, option.maturity, OptionType::Put, 0.0, false);
+}
+
+// Option barrire : dsactivante rsolue directement, activante par parit in-out
+PdeResult PdeEngine::price(const BlackScholesModel& model, const BarrierOption& option) const {
+    bool upBarrier = (option.barrierType == BarrierType::UpAndOut || option.barrierType == BarrierType::UpAndIn);
+    bool knockOut = (option.barrierType == BarrierType::UpAndOut || option.barrierType == BarrierType::DownAndOut);
+
+    // Observation discrte : barrire loigne de exp(beta * sigma * sqrt(dt))
+    double barrier = option.barrier;
+    if (monitoringDates > 0) {
+        double shift = BGK_BETA * model.volatility * std::sqrt(option.maturity / monitoringDates);
+        barrier *= std::exp(upBarrier ? shift : -shift);
+    }
+
+    bool breached = upBarrier ? model.spot >= barrier : model.spot <= barrier;
+    PdeResult out = breached ? PdeResult{0.0, 0.0, 0.0}
+                             : solve(model, option.strike, option.maturity, option.optionType, barrier, upBarrier);
+    if (knockOut) return out;
+
+    PdeResult vanilla = solve(model, option.strike, option.maturity, option.optionType, 0.0, false);
+    return PdeResult{vanilla.price - out.price, vanilla.delta - out.delta, vanilla.gamma - out.gamma};
+}
+
+// Rsolution de l'EDP de Black-Scholes en x = ln(S), en temps restant tau
+//   V_tau = 1/2 sigma^2 V_xx + (r - q - 1/2 sigma^2) V_x - r V
+PdeResult PdeEngine::solve(const BlackScholesModel& model, double strike, double maturity, OptionType optionType,
+                           double barrier, bool upBarrier) const {
+    if (maturity <= 0.0 || model.volatility <= 0.0 || model.spot <= 0.0) {
+        throw std::invalid_argument("Maturity, volatility and spot must be positive in PdeEngine::solve.");
+    }
+    if (model.hasTermStructure()) {
+        throw std::invalid_argument("PdeEngine uses scalar parameters only: curves and cash dividends are not supported.");
+    }
+    if (spaceSteps < 4 || timeSteps < 1) {
+        throw std::invalid_argument("Grid too small in PdeEngine::solve.");
+    }
+
+    const int n = spaceSteps;
+    const double sigma = model.volatility;
+    const double x0 = std::log(model.spot);
+    const double halfWidth = numStdDevs * sigma * std::sqrt(maturity);
+
+    // Une barrire au-del de la grille n'est jamais atteinte en pratique : bord vanille
+    const bool hasBarrier = barrier > 0.0 &&
+                            (upBarrier ? std::log(barrier) < x0 + halfWidth : std::log(barrier) > x0 - halfWidth);
+
+    // Grille uniforme dont un noeud k concide avec le spot (et un bord avec la barrire)
+    int k;
+    double dx, xMin;
+    if (!hasBarrier) {
+        k = n / 2;
+        dx = 2.0 * halfWidth / n;
+        xMin = x0 - k * dx;
+    } else if (upBarrier) {
+        double xMax = std::log(barrier);
+        k = static_cast<int>(std::lround(halfWidth / ((xMax - x0 + halfWidth) / n)));
+        k = std::min(std::max(k, 1), n - 1);
+        dx = (xMax - x0) / (n - k);
+        xMin = xMax - n * dx;
+    } else {
+        xMin = std::log(barrier);
+        double xMax = x0 + halfWidth;
+        k = static_cast<int>(std::lround((x0 - xMin) / ((xMax - xMin) / n)));
+        k = std::min(std::max(k, 1), n - 1);
+        dx = (x0 - xMin) / k;
+    }
+    const double sMin = std::exp(xMin);
+    const double sMax = std::exp(xMin + n * dx);
+
+    // Oprateur discret L V_i = a V_{i-1} + b V_i + c V_{i+1}
+    const double mu = model.rate - model.dividend - 0.5 * sigma * sigma;
+    const double alpha = 0.5 * sigma * sigma / (dx * dx);
+    const double beta = 0.5 * mu / dx;
+    const double a = alpha - beta;
+    const double b = -2.0 * alpha - model.rate;
+    const double c = alpha + beta;
+
+    // Un pas de Crank-Nicolson de dt et un demi-pas implicite de dt/2 ont la mme matrice
+    // I - dt/2 L : une seule factorisation sert aux deux schmas
+    const double dt = maturity / timeSteps;
+    const double h = 0.5 * dt;
+    const double lower = -h * a;
+    const double diag = 1.0 - h * b;
+    const double upper = -h * c;
+
+    PathArena::Scope scope;
+    double* values = scope.allocate(n + 1);   // Valeurs aux noeuds
+    double* rhs = scope.allocate(n + 1);      // Second membre puis solution intermdiaire
+    double* ratio = scope.allocate(n + 1);    // Coefficients c'_i de l'limination de Thomas
+    double* inverse = scope.allocate(n + 1);  // Inverses des pivots
+
+    // Factorisation de Thomas sur les noeuds intrieurs 1..n-1
+    inverse[1] = 1.0 / diag;
+    ratio[1] = upper * inverse[1];
+    for (int i = 2; i < n; ++i) {
+        inverse[i] = 1.0 / (diag - lower * ratio[i - 1]);
+        ratio[i] = upper * inverse[i];
+    }
+
+    // Conditions aux bords : Dirichlet nul sur la barrire, asymptote vanille sinon
+    const bool lowerIsBarrier = hasBarrier && !upBarrier;
+    const bool upperIsBarrier = hasBarrier && upBarrier;
+    auto lowerBoundary = [&](double tau) {
+        if (lowerIsBarrier || optionType == OptionType::Call) return 0.0;
+        return strike * std::exp(-model.rate * tau) - sMin * std::exp(-model.dividend * tau);
+    };
+    auto upperBoundary = [&](double tau) {
+        if (upperIsBarrier || optionType == OptionType::Put) return 0.0;
+        return sMax * std::exp(-model.dividend * tau) - strike * std::exp(-model.rate * tau);
+    };
+
+    // Condition terminale (tau = 0)
+    for (int i = 0; i <= n; ++i) {
+        double s = std::exp(xMin + i * dx);
+        values[i] = (optionType == OptionType::Call) ? std::max(s - strike, 0.0) : std::max(strike - s, 0.0);
+    }
+    if (lowerIsBarrier) values[0] = 0.0;
+    if (upperIsBarrier) values[n] = 0.0;
+
+    // Avance jusqu' tau ; crankNicolson ajoute la partie explicite dt/2 L V
+    auto advance = [&](double tau, bool crankNicolson) {
+        double left = lowerBoundary(tau);
+        double right = upperBoundary(tau);
+        for (int i = 1; i < n; ++i) {
+            double explicitPart = crankNicolson ? h * (a * values[i - 1] + b * values[i] + c * values[i + 1]) : 0.0;
+            rhs[i] = values[i] + explicitPart;
+        }
+        rhs[1] -= lower * left;
+        rhs[n - 1] -= upper * right;
+
+        // Descente puis remonte
+        rhs[1] *= inverse[1];
+        for (int i = 2; i < n; ++i) rhs[i] = (rhs[i] - lower * rhs[i - 1]) * inverse[i];
+        values[n - 1] = rhs[n - 1];
+        for (int i = n - 2; i >= 1; --i) values[i] = rhs[i] - ratio[i] * values[i + 1];
+        values[0] = left;
+        values[n] = right;
+    };
+
+    // Dmarrage de Rannacher puis Crank-Nicolson
+    const int smoothing = std::min(rannacherSteps, timeSteps);
+    for (int m = 0; m < timeSteps; ++m) {
+        if (m < smoothing) {
+            advance(m * dt + h, false);
+            advance((m + 1) * dt, false);
+        } else {
+            advance((m + 1) * dt, true);
+        }
+    }
+
+    // Sensibilits par diffrences centres au noeud du spot (conversion de x vers S)
+    const double dVdx = (values[k + 1] - values[k - 1]) / (2.0 * dx);
+    const double d2Vdx2 = (values[k + 1] - 2.0 * values[k] + values[k - 1]) / (dx * dx);
+    const double spot = model.spot;
+    return PdeResult{values[k], dVdx / spot, (d2Vdx2 - dVdx) / (spot * spot)};
+}
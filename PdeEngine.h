@@ -0,0 +1,61 @@
+#ifndef PDE_ENGINE_H
+#define PDE_ENGINE_H
+
+#include "BlackScholesModel.h"
+#include "OptionType.h"
+
+class CallOption;
+class PutOption;
+class BarrierOption;
+
+// Rsultat d'un pricing par diffrences finies
+struct PdeResult {
+    double price; // Prix actualis
+    double delta; // Drive premire par rapport au spot (lue sur la grille)
+    double gamma; // Drive seconde par rapport au spot (lue sur la grille)
+};
+
+// Moteur EDP (diffrences finies) pour les vanilles et les barrires, alternative au Monte-Carlo
+//
+// L'quation de Black-Scholes est rsolue en x = ln(S) sur une grille uniforme, de la maturit
+// vers la date 0, par Crank-Nicolson. Les rannacherSteps premiers pas sont remplacs chacun par
+// deux demi-pas implicites (dmarrage de Rannacher) pour amortir les oscillations dues au
+// point anguleux du payoff. Chaque pas se ramne  un systme tridiagonal  coefficients
+// constants, factoris une seule fois puis rsolu par l'algorithme de Thomas.
+//
+// Le spot est plac exactement sur un noeud : delta et gamma sont obtenus par diffrences
+// centres sur la grille, sans interpolation. Les barrires sont des conditions de Dirichlet
+// (valeur nulle) au bord de la grille ; les options activantes sont obtenues par parit in-out.
+// Seuls les paramtres scalaires du modle sont utiliss : un modle avec courbes ou dividendes
+// cash (BlackScholesModel::hasTermStructure) lve std::invalid_argument.
+class PdeEngine {
+public:
+    int spaceSteps;      // Nombre d'intervalles en espace
+    int timeSteps;       // Nombre de pas de temps
+    int rannacherSteps;  // Nombre de pas initiaux remplacs par deux demi-pas implicites
+    double numStdDevs;   // Demi-largeur de la grille en carts-types de ln(S_T)
+    int monitoringDates; // Nombre de dates d'observation de la barrire (0 : observation continue)
+
+    // Constructeur
+    // Avec monitoringDates > 0, la barrire est dplace par la correction de Broadie-Glasserman-Kou
+    // pour reproduire une observation discrte (celle du Monte-Carlo  monitoringDates pas)
+    PdeEngine(int spaceSteps_ = 400, int timeSteps_ = 200, int rannacherSteps_ = 2,
+              double numStdDevs_ = 5.0, int monitoringDates_ = 0);
+
+    // Prix, delta et gamma des options vanilles europennes
+    PdeResult price(const BlackScholesModel& model, const CallOption& option) const;
+    PdeResult price(const BlackScholesModel& model, const PutOption& option) const;
+
+    // Prix, delta et gamma d'une option barrire
+    // Si le spot est dj au-del de la barrire, l'option dsactivante vaut 0 et l'activante
+    // vaut la vanille correspondante
+    PdeResult price(const BlackScholesModel& model, const BarrierOption& option) const;
+
+private:
+    // Rsout l'EDP pour un payoff vanille de type optionType, avec une barrire dsactivante
+    // haute (upBarrier) ou basse ; barrier <= 0 signifie l'absence de barrire
+    PdeResult solve(const BlackScholesModel& model, double strike, double maturity, OptionType optionType,
+                    double barrier, bool upBarrier) const;
+};
+
+#endif // PDE_ENGINE_H
@@ -0,0 +1,220 @@
+#include "PortfolioPricer.h"
+#include "CallOption.h"
+#include "DeltaHedge.h"       // Couvertures dcoupes par pas
+#include "ExoticOption.h"
+#include "MonteCarloEngine.h" // Sommes des payoffs par morceau
+#include "Parallel.h"         // Pour defaultThreadCount
+#include "PutOption.h"
+#include <algorithm>          // Pour std::min et std::max
+#include <chrono>             // Pour la dure totale
+#include <functional>         // Corps des tches
+#include <random>             // Pour std::mt19937 et std::seed_seq
+#include <stdexcept>          // Pour std::invalid_argument
+#include <utility>            // Pour std::pair
+
+// tiquette des tches qui soumettent les pas ou morceaux d'une exotique (sans mesure rapporte)
+static const int SPAWN_TAG = -1;
+
+PortfolioPricer::PortfolioPricer(int numPaths_, int steps_, int hedgeSteps_, int chunkPaths_, int batchSize_,
+                                 unsigned seed_, unsigned numThreads_)
+    : numPaths(numPaths_), steps(steps_), hedgeSteps(hedgeSteps_), chunkPaths(chunkPaths_), batchSize(batchSize_),
+      seed(seed_), numThreads(numThreads_), cache(nullptr) {
+    if (chunkPaths <= 0 || batchSize <= 0) {
+        throw std::invalid_argument("PortfolioPricer chunk and batch sizes must be positive.");
+    }
+    if (numPaths <= 0 || steps <= 0 || hedgeSteps <= 0) {
+        throw std::invalid_argument("PortfolioPricer path, step and hedge-step counts must be positive.");
+    }
+}
+
+// Threads conservs d'un appel  l'autre ; recrs si numThreads a chang
+WorkStealingScheduler& PortfolioPricer::workers() const {
+    const unsigned wanted = numThreads == 0 ? defaultThreadCount() : numThreads;
+    if (!scheduler || scheduler->size() != wanted) {
+        scheduler.reset(); // Attend et arrte les anciens threads
+        scheduler.reset(new WorkStealingScheduler(wanted));
+    }
+    return *scheduler;
+}
+
+PortfolioResult PortfolioPricer::run(const BlackScholesModel& model, const std::vector<PricingJob>& jobs) const {
+    const int numJobs = static_cast<int>(jobs.size());
+
+    // Vrification des travaux et dcoupage en tches : couvertures, morceaux Monte-Carlo, lots analytiques
+    std::vector<int> vanillaSign(numJobs, 0);
+    std::vector<const ExoticOption*> exotics(numJobs, nullptr);
+    std::vector<std::unique_ptr<DeltaHedge> > hedges(numJobs);     // Couvertures d'exotiques
+    std::vector<std::vector<MonteCarloDelta> > hedgeDeltas(numJobs); // Deltas par pas (nuls aprs dsactivation)
+    std::vector<int> firstChunk(numJobs, 0); // Indice de la premire somme partielle du travail
+    std::vector<PortfolioTask> tasks;
+    std::vector<std::pair<std::size_t, std::size_t> > spawned; // Tches [begin, end) d'une mme exotique
+    int numChunks = 0;
+    for (int j = 0; j < numJobs; ++j) {
+        const PricingJob& job = jobs[j];
+        if (job.method == PricingMethod::Analytic) {
+            if (dynamic_cast<const CallOption*>(job.option)) {
+                vanillaSign[j] = 1;
+            } else if (dynamic_cast<const PutOption*>(job.option)) {
+                vanillaSign[j] = -1;
+            } else {
+                throw std::invalid_argument("Analytic pricing requires a CallOption or a PutOption.");
+            }
+        } else if (job.method == PricingMethod::MonteCarlo) {
+            if ((exotics[j] = dynamic_cast<const ExoticOption*>(job.option)) == nullptr) {
+                throw std::invalid_argument("Monte-Carlo pricing requires an ExoticOption.");
+            }
+        } else if (const ExoticOption* exotic = dynamic_cast<const ExoticOption*>(job.option)) {
+            // Trajectoire couverte tire ici ; une tche par pas dont le delta est  calculer
+            hedges[j].reset(new DeltaHedge(*exotic, model, hedgeSteps, PricingContext(seed).derive(j)));
+            hedgeDeltas[j].assign(hedgeSteps, MonteCarloDelta{0.0, 0.0});
+            const std::size_t begin = tasks.size();
+            for (int i = 0; i < hedgeSteps; ++i) {
+                if (!hedges[j]->knockedOut(i)) tasks.push_back(PortfolioTask{PricingMethod::HedgeCost, j, 1, i, TaskTiming()});
+            }
+            spawned.emplace_back(begin, tasks.size());
+        } else {
+            tasks.push_back(PortfolioTask{PricingMethod::HedgeCost, j, 1, 0, TaskTiming()});
+        }
+    }
+    for (int j = 0; j < numJobs; ++j) {
+        if (!exotics[j]) continue;
+        firstChunk[j] = numChunks;
+        const int count = (numPaths + chunkPaths - 1) / chunkPaths;
+        const std::size_t begin = tasks.size();
+        for (int k = 0; k < count; ++k) tasks.push_back(PortfolioTask{PricingMethod::MonteCarlo, j, 1, k, TaskTiming()});
+        spawned.emplace_back(begin, tasks.size());
+        numChunks += count;
+    }
+    std::vector<int> analyticJobs;
+    for (int j = 0; j < numJobs; ++j) {
+        if (vanillaSign[j] != 0) analyticJobs.push_back(j);
+    }
+    for (std::size_t first = 0; first < analyticJobs.size(); first += batchSize) {
+        int count = static_cast<int>(std::min<std::size_t>(batchSize, analyticJobs.size() - first));
+        tasks.push_back(PortfolioTask{PricingMethod::Analytic, static_cast<int>(first), count, 0, TaskTiming()});
+    }
+
+    PortfolioResult result;
+    result.values.assign(numJobs, 0.0);
+    result.standardErrors.assign(numJobs, 0.0);
+    std::vector<PayoffSums> partial(numChunks);
+
+    WorkStealingScheduler& scheduler = workers();
+    auto start = std::chrono::steady_clock::now();
+    const double origin = scheduler.elapsed();
+
+    // Corps de la tche t
+    auto body = [&](std::size_t t) -> std::function<void()> {
+        const PortfolioTask& task = tasks[t];
+        switch (task.method) {
+        case PricingMethod::HedgeCost:
+            if (hedges[task.firstJob]) {
+                return [&, task]() {
+                    hedgeDeltas[task.firstJob][task.chunk] = hedges[task.firstJob]->delta(task.chunk);
+                };
+            }
+            return [&, task]() {
+                result.values[task.firstJob] = jobs[task.firstJob].option->hedgeCost(model, hedgeSteps,
+                                                                          PricingContext(seed).derive(task.firstJob));
+            };
+        case PricingMethod::MonteCarlo:
+            return [&, task]() {
+                const int first = task.chunk * chunkPaths;
+                std::seed_seq sequence{seed, static_cast<unsigned>(task.firstJob), static_cast<unsigned>(task.chunk)};
+                std::mt19937 rng(sequence);
+                const ExoticOption& option = *exotics[task.firstJob];
+                partial[firstChunk[task.firstJob] + task.chunk] = MonteCarloEngine::accumulate(
+                    option, model, std::min(chunkPaths, numPaths - first), steps, option.maturity,
+                    SimulationPrecision::Double, rng);
+            };
+        case PricingMethod::Analytic:
+            break;
+        }
+        // firstJob indexe ici analyticJobs
+        return [&, task]() {
+            for (int i = task.firstJob; i < task.firstJob + task.numJobs; ++i) {
+                const int j = analyticJobs[i];
+                result.values[j] = cache ? cache->priceAnalytic(*jobs[j].option, model, vanillaSign[j] > 0)
+                                         : model.priceAnalytic(jobs[j].option, vanillaSign[j] > 0);
+            }
+        };
+    };
+
+    // Pas de couverture et morceaux Monte-Carlo d'une exotique soumis depuis un thread de travail : ils
+    // vont dans la file de ce thread, o les threads inoccups les volent ; les autres tches sont injectes
+    std::vector<char> isSpawned(tasks.size(), 0);
+    for (const auto& range : spawned) {
+        std::fill(isSpawned.begin() + range.first, isSpawned.begin() + range.second, 1);
+        scheduler.submit([&, range]() {
+            for (std::size_t t = range.first; t < range.second; ++t) scheduler.submit(body(t), static_cast<int>(t));
+        }, SPAWN_TAG);
+    }
+    for (std::size_t t = 0; t < tasks.size(); ++t) {
+        if (!isSpawned[t]) scheduler.submit(body(t), static_cast<int>(t));
+    }
+    scheduler.wait();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.numThreads = scheduler.size();
+
+    // Runion des morceaux dans l'ordre et des pas de couverture
+    for (int j = 0; j < numJobs; ++j) {
+        if (hedges[j]) {
+            HedgeResult hedge = hedges[j]->cost(hedgeDeltas[j], hedgeSteps);
+            result.values[j] = hedge.cost;
+            result.standardErrors[j] = hedge.standardError;
+        }
+        if (!exotics[j]) continue;
+        const int count = (numPaths + chunkPaths - 1) / chunkPaths;
+        PayoffSums sums = partial[firstChunk[j]];
+        for (int k = 1; k < count; ++k) sums.add(partial[firstChunk[j] + k]);
+        MonteCarloResult estimate = sums.result();
+        result.values[j] = estimate.price;
+        result.standardErrors[j] = estimate.standardError;
+    }
+
+    // Mesures rattaches aux tches ; firstJob des lots ramen  l'indice du travail
+    for (TaskTiming timing : scheduler.takeTimings()) {
+        if (timing.tag == SPAWN_TAG) continue;
+        timing.start -= origin;
+        tasks[timing.tag].timing = timing;
+    }
+    for (PortfolioTask& task : tasks) {
+        if (task.method == PricingMethod::Analytic) task.firstJob = analyticJobs[task.firstJob];
+    }
+    result.tasks = std::move(tasks);
+    return result;
+}
+
+void PortfolioPricer::printTelemetry(const PortfolioResult& result, std::ostream& out) {
+    static const char* names[] = {"Analytique", "Monte-Carlo", "Couverture"};
+    out << "--- Ordonnancement (" << result.tasks.size() << " tches, " << result.numThreads << " threads, "
+        << result.seconds << " s) ---\n";
+
+    for (int m = 0; m < 3; ++m) {
+        int count = 0;
+        double total = 0.0, longest = 0.0;
+        for (const PortfolioTask& task : result.tasks) {
+            if (static_cast<int>(task.method) != m) continue;
+            ++count;
+            total += task.timing.seconds;
+            longest = std::max(longest, task.timing.seconds);
+        }
+        if (count == 0) continue;
+        out << names[m] << " : " << count << " tche(s), " << total << " s au total, "
+            << total / count << " s en moyenne, " << longest << " s au plus\n";
+    }
+
+    for (unsigned w = 0; w < result.numThreads; ++w) {
+        int count = 0, stolen = 0;
+        double busy = 0.0, last = 0.0;
+        for (const PortfolioTask& task : result.tasks) {
+            if (task.timing.worker != w) continue;
+            ++count;
+            if (task.timing.stolen) ++stolen;
+            busy += task.timing.seconds;
+            last = std::max(last, task.timing.start + task.timing.seconds);
+        }
+        out << "Thread " << w << " : " << count << " tche(s) dont " << stolen << " vole(s), occup "
+            << busy << " s, dernire fin  " << last << " s\n";
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef PORTFOLIO_PRICER_H
+#define PORTFOLIO_PRICER_H
+
+#include "BlackScholesModel.h"
+#include "Option.h"
+#include "PricingCache.h"
+#include "WorkStealingScheduler.h"
+#include <memory>  // Ordonnanceur conserv d'un appel  l'autre
+#include <ostream> // Pour l'affichage des mesures
+#include <vector>  // Pour les travaux et les rsultats
+
+// Calcul demand pour une transaction
+enum class PricingMethod {
+    Analytic,   // Formule ferme (CallOption et PutOption)
+    MonteCarlo, // Prix Monte-Carlo (ExoticOption)
+    HedgeCost   // Cot de rplication (toute option)
+};
+
+// Travail lmentaire : une option et le calcul demand
+struct PricingJob {
+    const Option* option;
+    PricingMethod method;
+};
+
+// Tche confie  l'ordonnanceur et sa mesure
+struct PortfolioTask {
+    PricingMethod method;
+    int firstJob;      // Premier travail trait
+    int numJobs;       // Nombre de travaux (lot de prix analytiques) ou 1
+    int chunk;         // Indice du morceau de trajectoires (Monte-Carlo), du pas de couverture, ou 0
+    TaskTiming timing; // Thread, vol, dbut et dure
+};
+
+// Rsultats d'un portefeuille
+struct PortfolioResult {
+    std::vector<double> values;         // Valeur de chaque travail
+    std::vector<double> standardErrors; // Erreur standard (prix Monte-Carlo, couverture d'une exotique), 0 sinon
+    std::vector<PortfolioTask> tasks;   // Tches excutes, dans l'ordre de soumission
+    double seconds;                     // Dure totale (origine des dbuts des tches : dbut du calcul)
+    unsigned numThreads;                // Threads de travail utiliss
+};
+
+// Calcul d'un portefeuille htrogne sur un WorkStealingScheduler
+// Les prix Monte-Carlo sont dcoups en morceaux de chunkPaths trajectoires (le morceau k du travail
+// j est simul avec un gnrateur initialis par (seed, j, k), et les morceaux sont runis dans
+// l'ordre : le rsultat ne dpend pas du nombre de threads) ; les prix analytiques, de l'ordre de la
+// microseconde, sont regroups par lots de batchSize et lus dans cache s'il est fourni. Le cot de
+// rplication d'une exotique (contexte PricingContext(seed).derive(j)) est dcoup en une tche par
+// pas de couverture (DeltaHedge::delta), les pas tant runis aprs coup ; celui d'une option
+// vanille,  deltas analytiques, est une seule tche.
+// Les pas de couverture et les morceaux Monte-Carlo d'une exotique sont soumis par une tche
+// intermdiaire, depuis un thread de travail : ils vont dans la file de ce thread et les threads
+// inoccups les volent, ce qui rpartit une exotique longue sur tous les threads. Ces tches
+// intermdiaires sont injectes en premier et, la file d'injection tant servie dans l'ordre,
+// dmarrent en premier ; les lots analytiques et les couvertures de vanilles suivent. L'ordonnanceur est cr au premier appel  run() et conserv
+// tant que numThreads ne change pas : run() ne doit pas tre appel simultanment depuis plusieurs threads.
+class PortfolioPricer {
+public:
+    int numPaths;        // Trajectoires par prix Monte-Carlo
+    int steps;           // Pas de temps par trajectoire
+    int hedgeSteps;      // Dates de couverture par cot de rplication
+    int chunkPaths;      // Trajectoires par tche Monte-Carlo
+    int batchSize;       // Prix analytiques par tche
+    unsigned seed;       // Graine des prix Monte-Carlo et des cots de rplication
+    unsigned numThreads; // 0 : nombre de coeurs
+    PricingCache* cache; // Cache des prix analytiques, conserv d'un appel  run()  l'autre (facultatif)
+
+    // Constructeur ; lve std::invalid_argument si un nombre de trajectoires, de pas ou une taille de tche
+    // n'est pas strictement positif
+    PortfolioPricer(int numPaths_ = 100000, int steps_ = 100, int hedgeSteps_ = 100, int chunkPaths_ = 8192,
+                    int batchSize_ = 256, unsigned seed_ = 0, unsigned numThreads_ = 0);
+
+    // Calcule tous les travaux ; lve std::invalid_argument si une mthode ne s'applique pas  l'option
+    PortfolioResult run(const BlackScholesModel& model, const std::vector<PricingJob>& jobs) const;
+
+    // Affiche les mesures : temps par type de tche, occupation et vols par thread
+    static void printTelemetry(const PortfolioResult& result, std::ostream& out);
+
+private:
+    // Ordonnanceur  numThreads threads, cr ou recr si besoin
+    WorkStealingScheduler& workers() const;
+
+    mutable std::unique_ptr<WorkStealingScheduler> scheduler; // Threads conservs d'un run()  l'autre
+};
+
+#endif // PORTFOLIO_PRICER_H
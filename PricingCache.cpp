@@ -0,0 +1,89 @@
+#include "PricingCache.h"
+#include "BlackScholesModel.h"
+#include "ExoticOption.h"
+#include "MonteCarloEngine.h" // Simulation avec gnrateur fourni
+#include <random>             // Pour std::mt19937
+#include <stdexcept>          // Pour std::invalid_argument
+
+// Constructeur du cache
+PricingCache::PricingCache(std::size_t capacity_)
+    : capacity(capacity_), hits(0), misses(0), evictions(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("PricingCache capacity must be positive.");
+    }
+}
+
+// Cl : produit, modle, moteur ; la simulation part d'un gnrateur initialis avec seed
+double PricingCache::price(const ExoticOption& option, const BlackScholesModel& model, int numPaths, int steps,
+                           unsigned seed, SimulationPrecision precision) {
+    PricingKey key;
+    option.appendKey(key);
+    model.appendKey(key);
+    key.add("MonteCarlo").add(static_cast<long long>(numPaths)).add(static_cast<long long>(steps))
+       .add(static_cast<long long>(seed)).add(static_cast<long long>(precision));
+    return getOrCompute(key, [&]() {
+        std::mt19937 rng(seed);
+        return MonteCarloEngine::run(option, model, numPaths, steps, option.maturity, precision, rng).price;
+    });
+}
+
+double PricingCache::priceAnalytic(const Option& option, const BlackScholesModel& model, bool isCall) {
+    PricingKey key;
+    option.appendKey(key);
+    model.appendKey(key);
+    key.add("Analytic").add(static_cast<long long>(isCall));
+    return getOrCompute(key, [&]() { return model.priceAnalytic(&option, isCall); });
+}
+
+// Recherche sous verrou, calcul hors verrou, insertion en tte avec viction de la queue
+double PricingCache::getOrCompute(const PricingKey& key, const std::function<double()>& compute) {
+    std::vector<double> values;
+    if (!find(key, values)) {
+        values.assign(1, compute());
+        insert(key, values);
+    }
+    return values[0];
+}
+
+bool PricingCache::find(const PricingKey& key, std::vector<double>& values) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found == index.end()) {
+        ++misses;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, found->second); // Devient la plus rcente
+    ++hits;
+    values = found->second->second;
+    return true;
+}
+
+void PricingCache::insert(const PricingKey& key, const std::vector<double>& values) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end()) { // Calcule entre-temps par un autre thread
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    entries.emplace_front(key, values);
+    index.emplace(key, entries.begin());
+    if (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+        ++evictions;
+    }
+}
+
+PricingCacheStats PricingCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return PricingCacheStats{hits, misses, evictions, entries.size()};
+}
+
+void PricingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
@@ -0,0 +1,73 @@
+#ifndef PRICING_CACHE_H
+#define PRICING_CACHE_H
+
+#include "PricingKey.h"
+#include "SimulationPrecision.h"
+#include <cstddef>       // Pour std::size_t
+#include <functional>    // Pour std::function
+#include <list>          // Ordre d'utilisation (LRU)
+#include <mutex>         // Pour std::mutex
+#include <unordered_map> // Index des entres
+#include <utility>       // Pour std::pair
+#include <vector>        // Valeurs d'une entre
+
+class BlackScholesModel;
+class ExoticOption;
+class Option;
+
+// Statistiques d'utilisation du cache
+struct PricingCacheStats {
+    std::size_t hits;      // Prix trouvs dans le cache
+    std::size_t misses;    // Prix calculs
+    std::size_t evictions; // Entres retires faute de place
+    std::size_t size;      // Nombre d'entres actuel
+};
+
+// Cache de prix born, partag entre threads, avec viction de l'entre la moins rcemment utilise
+//
+// La cl regroupe les champs du produit (Option::appendKey), du modle (BlackScholesModel::appendKey)
+// et les rglages du moteur (trajectoires, pas, graine, prcision). Un prix Monte-Carlo n'est
+// rutilisable que si la simulation est dterministe : les surcharges Monte-Carlo prennent donc
+// une graine explicite, qui fait partie de la cl. Le calcul d'un prix absent se fait hors du
+// verrou ; deux threads demandant simultanment la mme cl peuvent donc la calculer tous deux.
+// Une entre peut porter plusieurs valeurs (prix et grecques d'une rponse du PricingServer).
+class PricingCache {
+public:
+    // Constructeur : capacity entres au plus
+    explicit PricingCache(std::size_t capacity = 4096);
+
+    // Prix Monte-Carlo d'une option exotique avec une graine fixe
+    double price(const ExoticOption& option, const BlackScholesModel& model, int numPaths, int steps,
+                 unsigned seed, SimulationPrecision precision = SimulationPrecision::Double);
+
+    // Prix analytique d'un call ou d'un put
+    double priceAnalytic(const Option& option, const BlackScholesModel& model, bool isCall);
+
+    // Prix associ  key, calcul par compute en cas d'absence puis mmoris
+    double getOrCompute(const PricingKey& key, const std::function<double()>& compute);
+
+    // Valeurs associes  key ; false (dfaut compt) si elles sont absentes
+    bool find(const PricingKey& key, std::vector<double>& values);
+
+    // Mmorise les valeurs de key (sans effet si la cl est dj prsente)
+    void insert(const PricingKey& key, const std::vector<double>& values);
+
+    // Statistiques depuis la construction ou le dernier clear()
+    PricingCacheStats stats() const;
+
+    // Retire toutes les entres et remet les compteurs  zro
+    void clear();
+
+private:
+    typedef std::list<std::pair<PricingKey, std::vector<double> > > EntryList;
+
+    std::size_t capacity;
+    EntryList entries; // De la plus rcente  la plus ancienne
+    std::unordered_map<PricingKey, EntryList::iterator, PricingKey::Hasher> index;
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t evictions;
+    mutable std::mutex mutex;
+};
+
+#endif // PRICING_CACHE_H
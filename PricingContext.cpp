@@ -0,0 +1,13 @@
+#include "PricingContext.h"
+
+PricingContext PricingContext::fromEntropy() {
+    return PricingContext(std::random_device{}());
+}
+
+// Graine drive par std::seed_seq : deux flux voisins ont des gnrateurs dcorrls
+PricingContext PricingContext::derive(unsigned stream) const {
+    std::seed_seq sequence{seedValue, stream};
+    unsigned derived;
+    sequence.generate(&derived, &derived + 1);
+    return PricingContext(derived);
+}
@@ -0,0 +1,33 @@
+#ifndef PRICING_CONTEXT_H
+#define PRICING_CONTEXT_H
+
+#include <random> // Pour std::mt19937
+
+// Contexte de pricing : origine de tous les nombres alatoires d'un calcul
+// Les prix Monte-Carlo et les cots de rplication tirent leurs nombres d'un gnrateur construit
+//  partir de la graine du contexte : une mme graine donne des rsultats identiques bit  bit
+// (comparaison  des rsultats de rfrence, cache de prix, nombres alatoires communs). Un calcul
+// qui a besoin de plusieurs flux indpendants (un par pas de couverture, par exemple) les obtient
+// par derive(stream), qui ne dpend que de la graine et du numro du flux, pas de l'ordre des appels.
+class PricingContext {
+public:
+    // Contexte de graine seed (par dfaut celle de std::mt19937)
+    explicit PricingContext(unsigned seed_ = std::mt19937::default_seed) : seedValue(seed_) {}
+
+    // Contexte de graine tire de std::random_device (rsultats non reproductibles)
+    static PricingContext fromEntropy();
+
+    // Graine du contexte
+    unsigned seed() const { return seedValue; }
+
+    // Gnrateur initialis par la graine
+    std::mt19937 generator() const { return std::mt19937(seedValue); }
+
+    // Contexte du flux stream, de graine drive de (seed, stream)
+    PricingContext derive(unsigned stream) const;
+
+private:
+    unsigned seedValue;
+};
+
+#endif // PRICING_CONTEXT_H
@@ -0,0 +1,37 @@
+#include "PricingKey.h"
+#include <cstring> // Pour std::memcpy et std::strlen
+
+// Un rel est ajout par ses 8 octets (-0.0 ramen  0.0 pour que des valeurs gales aient la mme cl)
+PricingKey& PricingKey::add(double value) {
+    if (value == 0.0) value = 0.0;
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    data.push_back('d');
+    data.append(bytes, sizeof(double));
+    return *this;
+}
+
+PricingKey& PricingKey::add(long long value) {
+    char bytes[sizeof(long long)];
+    std::memcpy(bytes, &value, sizeof(long long));
+    data.push_back('i');
+    data.append(bytes, sizeof(long long));
+    return *this;
+}
+
+// Texte prcd de sa longueur (pas d'ambigut entre champs conscutifs)
+PricingKey& PricingKey::add(const char* text) {
+    data.push_back('s');
+    add(static_cast<long long>(std::strlen(text)));
+    data.append(text);
+    return *this;
+}
+
+std::uint64_t PricingKey::hash() const {
+    std::uint64_t h = 14695981039346656037ULL; // Base FNV
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ULL; // Nombre premier FNV
+    }
+    return h;
+}
@@ -0,0 +1,35 @@
+#ifndef PRICING_KEY_H
+#define PRICING_KEY_H
+
+#include <cstddef> // Pour std::size_t
+#include <cstdint> // Pour std::uint64_t
+#include <string>  // Pour la squence d'octets
+
+// Cl de cache : suite canonique des champs du produit, du modle et des rglages du moteur
+// Les champs sont srialiss dans l'ordre d'ajout (type, puis octets de la valeur) ; deux cls
+// sont gales si leurs squences d'octets le sont. Le hash (FNV-1a 64 bits) ne dpend que de
+// cette squence : il est identique d'une excution  l'autre.
+class PricingKey {
+public:
+    PricingKey& add(double value);
+    PricingKey& add(long long value);
+    PricingKey& add(const char* text);
+
+    // Hash FNV-1a 64 bits de la squence d'octets
+    std::uint64_t hash() const;
+
+    // Squence d'octets (comparaisons, stockage)
+    const std::string& bytes() const { return data; }
+
+    bool operator==(const PricingKey& other) const { return data == other.data; }
+
+    // Foncteur de hachage pour les conteneurs non ordonns
+    struct Hasher {
+        std::size_t operator()(const PricingKey& key) const { return static_cast<std::size_t>(key.hash()); }
+    };
+
+private:
+    std::string data;
+};
+
+#endif // PRICING_KEY_H
@@ -0,0 +1,234 @@
+#include "PricingProtocol.h"
+#include <cerrno>       // Pour errno et EINTR
+#include <cstring>      // Pour std::memcpy et std::strerror
+#include <stdexcept>    // Pour std::invalid_argument et std::runtime_error
+#include <sys/socket.h> // Pour socket, connect, send, recv
+#include <sys/un.h>     // Pour sockaddr_un
+#include <unistd.h>     // Pour close
+
+// Srialisation champ par champ (reprsentation native, sans remplissage)
+class FrameWriter {
+public:
+    FrameWriter() : data(sizeof(std::uint32_t)) {}
+
+    template <typename T>
+    void put(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void put(const std::string& text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        data.insert(data.end(), text.begin(), text.end());
+    }
+
+    // Trame termine : longueur de la charge en tte
+    std::vector<char> finish() {
+        std::uint32_t size = static_cast<std::uint32_t>(data.size() - sizeof(std::uint32_t));
+        std::memcpy(data.data(), &size, sizeof(size));
+        return std::move(data);
+    }
+
+private:
+    std::vector<char> data;
+};
+
+class FrameReader {
+public:
+    FrameReader(const char* data_, std::size_t size_) : data(data_), size(size_), offset(0) {}
+
+    template <typename T>
+    void get(T& value) {
+        require(sizeof(T));
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    void get(std::string& text) {
+        std::uint32_t length;
+        get(length);
+        require(length);
+        text.assign(data + offset, length);
+        offset += length;
+    }
+
+    void finish() const {
+        if (offset != size) throw std::invalid_argument("Pricing message has trailing bytes.");
+    }
+
+private:
+    void require(std::size_t bytes) const {
+        if (size - offset < bytes) throw std::invalid_argument("Pricing message is truncated.");
+    }
+
+    const char* data;
+    std::size_t size;
+    std::size_t offset;
+};
+
+std::vector<char> PricingProtocol::encode(const PricingRequest& request) {
+    FrameWriter writer;
+    writer.put(request.id);
+    writer.put(static_cast<std::uint8_t>(request.product));
+    writer.put(static_cast<std::uint8_t>(request.optionType));
+    writer.put(static_cast<std::uint8_t>(request.barrierType));
+    writer.put(request.strike);
+    writer.put(request.maturity);
+    writer.put(request.barrier);
+    writer.put(request.spot);
+    writer.put(request.rate);
+    writer.put(request.volatility);
+    writer.put(request.dividend);
+    writer.put(request.numPaths);
+    writer.put(request.steps);
+    writer.put(request.seed);
+    return writer.finish();
+}
+
+std::vector<char> PricingProtocol::encode(const PricingResponse& response) {
+    FrameWriter writer;
+    writer.put(response.id);
+    writer.put(static_cast<std::uint8_t>(response.ok ? 1 : 0));
+    writer.put(response.price);
+    writer.put(response.standardError);
+    writer.put(response.delta);
+    writer.put(response.gamma);
+    writer.put(response.vega);
+    writer.put(response.rho);
+    writer.put(response.batchSize);
+    writer.put(response.error);
+    return writer.finish();
+}
+
+PricingRequest PricingProtocol::decodeRequest(const char* payload, std::size_t size) {
+    FrameReader reader(payload, size);
+    PricingRequest request;
+    std::uint8_t product, optionType, barrierType;
+    reader.get(request.id);
+    reader.get(product);
+    reader.get(optionType);
+    reader.get(barrierType);
+    reader.get(request.strike);
+    reader.get(request.maturity);
+    reader.get(request.barrier);
+    reader.get(request.spot);
+    reader.get(request.rate);
+    reader.get(request.volatility);
+    reader.get(request.dividend);
+    reader.get(request.numPaths);
+    reader.get(request.steps);
+    reader.get(request.seed);
+    reader.finish();
+    if (product > static_cast<std::uint8_t>(ProductKind::Lookback) || optionType > 1 ||
+        barrierType > static_cast<std::uint8_t>(BarrierType::DownAndIn)) {
+        throw std::invalid_argument("Pricing request has an unknown product, option or barrier type.");
+    }
+    request.product = static_cast<ProductKind>(product);
+    request.optionType = static_cast<OptionType>(optionType);
+    request.barrierType = static_cast<BarrierType>(barrierType);
+    return request;
+}
+
+std::uint64_t PricingProtocol::requestId(const char* payload, std::size_t size) {
+    std::uint64_t id = 0;
+    if (size >= sizeof(id)) std::memcpy(&id, payload, sizeof(id));
+    return id;
+}
+
+PricingResponse PricingProtocol::decodeResponse(const char* payload, std::size_t size) {
+    FrameReader reader(payload, size);
+    PricingResponse response;
+    std::uint8_t ok;
+    reader.get(response.id);
+    reader.get(ok);
+    reader.get(response.price);
+    reader.get(response.standardError);
+    reader.get(response.delta);
+    reader.get(response.gamma);
+    reader.get(response.vega);
+    reader.get(response.rho);
+    reader.get(response.batchSize);
+    reader.get(response.error);
+    reader.finish();
+    response.ok = ok != 0;
+    return response;
+}
+
+void PricingProtocol::writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL); // Pas de SIGPIPE si le pair est parti
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Pricing connection write failed: ") + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+// Lecture de size octets ; rend le nombre d'octets lus avant la fermeture
+static std::size_t readAll(int fd, char* data, std::size_t size) {
+    std::size_t done = 0;
+    while (done < size) {
+        ssize_t count = ::recv(fd, data + done, size - done, 0);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Pricing connection read failed: ") + std::strerror(errno));
+        }
+        if (count == 0) break;
+        done += static_cast<std::size_t>(count);
+    }
+    return done;
+}
+
+bool PricingProtocol::readFrame(int fd, std::vector<char>& payload) {
+    std::uint32_t size;
+    std::size_t got = readAll(fd, reinterpret_cast<char*>(&size), sizeof(size));
+    if (got == 0) return false;
+    if (got != sizeof(size)) throw std::runtime_error("Pricing connection closed inside a frame.");
+    if (size > MAX_PAYLOAD) throw std::runtime_error("Pricing frame exceeds the maximum payload size.");
+    payload.resize(size);
+    if (readAll(fd, payload.data(), size) != size) {
+        throw std::runtime_error("Pricing connection closed inside a frame.");
+    }
+    return true;
+}
+
+PricingClient::PricingClient(const std::string& socketPath) : fd(-1) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Pricing socket path is too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::string reason = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Cannot connect to pricing server " + socketPath + ": " + reason);
+    }
+}
+
+PricingClient::~PricingClient() {
+    ::close(fd);
+}
+
+void PricingClient::send(const PricingRequest& request) {
+    std::vector<char> frame = PricingProtocol::encode(request);
+    PricingProtocol::writeAll(fd, frame.data(), frame.size());
+}
+
+PricingResponse PricingClient::receive() {
+    std::vector<char> payload;
+    if (!PricingProtocol::readFrame(fd, payload)) {
+        throw std::runtime_error("Pricing server closed the connection.");
+    }
+    return PricingProtocol::decodeResponse(payload.data(), payload.size());
+}
+
+PricingResponse PricingClient::price(const PricingRequest& request) {
+    send(request);
+    return receive();
+}
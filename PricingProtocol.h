@@ -0,0 +1,99 @@
+#ifndef PRICING_PROTOCOL_H
+#define PRICING_PROTOCOL_H
+
+#include "BarrierOption.h"
+#include "OptionType.h"
+#include <cstdint> // Pour les entiers de taille fixe
+#include <string>  // Pour les chemins et les messages d'erreur
+#include <vector>  // Pour les trames
+
+// Produit demand au serveur de pricing
+enum class ProductKind : std::uint8_t { Call, Put, Asian, Barrier, Lookback };
+
+// Demande de prix : produit, modle Black-Scholes (paramtres constants) et rglages Monte-Carlo
+struct PricingRequest {
+    std::uint64_t id;        // Identifiant choisi par le client, repris dans la rponse
+    ProductKind product;
+    OptionType optionType;   // Asian, Barrier, Lookback
+    BarrierType barrierType; // Barrier
+    double strike;
+    double maturity;
+    double barrier;          // Barrier
+    double spot;
+    double rate;
+    double volatility;
+    double dividend;
+    std::int32_t numPaths;   // Exotiques
+    std::int32_t steps;      // Exotiques
+    std::uint32_t seed;      // Exotiques
+};
+
+// Rponse : prix et grecques, ou message d'erreur
+struct PricingResponse {
+    std::uint64_t id;
+    bool ok;
+    double price;
+    double standardError;  // 0 pour un prix analytique
+    double delta;
+    double gamma;
+    double vega;
+    double rho;
+    std::int32_t batchSize; // Demandes qui ont partag les mmes trajectoires (1 pour un prix analytique)
+    std::string error;      // Renseign si ok == false
+};
+
+// Protocole binaire du serveur de pricing sur socket Unix
+// Chaque message est une trame : longueur de la charge (uint32) puis charge. La charge est la suite
+// des champs dans l'ordre de dclaration, en reprsentation native (client et serveur sont sur la
+// mme machine) ; une chane est prcde de sa longueur (uint32). Une connexion peut enchaner
+// plusieurs demandes sans attendre les rponses, qui reviennent dans l'ordre de leur calcul.
+namespace PricingProtocol {
+
+// Taille maximale d'une charge accepte
+const std::uint32_t MAX_PAYLOAD = 1 << 16;
+
+// Trame complte (longueur incluse)
+std::vector<char> encode(const PricingRequest& request);
+std::vector<char> encode(const PricingResponse& response);
+
+// Dcodage d'une charge (sans la longueur) ; lve std::invalid_argument si elle est mal forme
+PricingRequest decodeRequest(const char* payload, std::size_t size);
+PricingResponse decodeResponse(const char* payload, std::size_t size);
+
+// Identifiant d'une demande (premier champ), lisible mme si la suite de la charge est mal forme ;
+// 0 si la charge est trop courte pour le contenir
+std::uint64_t requestId(const char* payload, std::size_t size);
+
+// criture complte d'un tampon ; lve std::runtime_error si la connexion est rompue
+void writeAll(int fd, const char* data, std::size_t size);
+
+// Lecture d'une trame complte ; rend false si la connexion est ferme avant son dbut
+// Lve std::runtime_error si elle est ferme au milieu ou si la longueur dpasse MAX_PAYLOAD
+bool readFrame(int fd, std::vector<char>& payload);
+
+} // namespace PricingProtocol
+
+// Client du serveur de pricing
+class PricingClient {
+public:
+    // Connexion au socket ; lve std::runtime_error en cas d'chec
+    explicit PricingClient(const std::string& socketPath);
+    ~PricingClient();
+
+    PricingClient(const PricingClient&) = delete;
+    PricingClient& operator=(const PricingClient&) = delete;
+
+    // Envoi d'une demande sans attendre la rponse
+    void send(const PricingRequest& request);
+
+    // Rponse suivante ; lve std::runtime_error si le serveur a ferm la connexion
+    PricingResponse receive();
+
+    // Envoi puis attente de la rponse
+    PricingResponse price(const PricingRequest& request);
+
+private:
+    int fd;
+};
+
+#endif // PRICING_PROTOCOL_H
@@ -0,0 +1,586 @@
+#include "PricingServer.h"
+#include "AsianOption.h"
+#include "BlackScholesModel.h"
+#include "CallOption.h"
+#include "LookbackOption.h"
+#include "PathMatrix.h"  // Trajectoires communes d'un lot
+#include "PricingKey.h"  // Cl de regroupement des demandes
+#include "PutOption.h"
+#include <algorithm>     // Pour std::remove_if
+#include <cerrno>        // Pour errno
+#include <chrono>        // Fentre de regroupement
+#include <cmath>         // Pour std::exp, std::sqrt et std::isfinite
+#include <cstring>       // Pour std::memcpy et std::strerror
+#include <fcntl.h>       // Pour fcntl (tube non bloquant)
+#include <memory>        // Pour std::shared_ptr et std::unique_ptr
+#include <mutex>         // Rponses remises au thread de lecture
+#include <poll.h>        // Pour poll
+#include <random>        // Pour std::mt19937
+#include <stdexcept>     // Pour std::invalid_argument et std::runtime_error
+#include <string>        // Pour std::to_string
+#include <sys/socket.h>  // Pour socket, bind, listen, accept, recv
+#include <sys/un.h>      // Pour sockaddr_un
+#include <unistd.h>      // Pour close, pipe, unlink, write
+#include <unordered_map> // Lots par cl
+#include <utility>       // Pour std::pair
+
+// Pas des diffrences finies (relatif pour le spot, absolus pour la volatilit et le taux)
+static const double VANILLA_BUMP = 1e-4;
+static const double EXOTIC_SPOT_BUMP = 1e-2;
+static const double EXOTIC_VOL_BUMP = 1e-2;
+static const double EXOTIC_RATE_BUMP = 1e-3;
+
+// Nombre maximal de prix d'un lot (numPaths * (steps + 1), 256 Mo en double) : la matrice des
+// trajectoires est alloue d'un bloc  partir de valeurs fournies par le client
+static const long long MAX_PATH_VALUES = 1LL << 25;
+
+// Connexion d'un client, lue et crite par le seul thread de lecture ; le descripteur est ferm
+// quand plus aucune rponse ne lui est destine
+struct Connection {
+    explicit Connection(int fd_) : fd(fd_), unanswered(0), readClosed(false), broken(false) {}
+    ~Connection() { ::close(fd); }
+
+    int fd;
+    std::vector<char> input;  // Octets reus pas encore dcoups en trames
+    std::vector<char> output; // Rponses encodes pas encore envoyes
+    int unanswered;           // Demandes reues dont la rponse n'est pas encore revenue du calcul
+    bool readClosed;          // Le client n'envoie plus rien (il peut encore lire ses rponses)
+    bool broken;              // criture impossible : le client est parti
+};
+
+// Vide un tube non bloquant (octets de rveil)
+static void drainPipe(int fd) {
+    char buffer[256];
+    while (::read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+// Rponses calcules, remises au thread de lecture qui les crit
+// Un thread de calcul dpose la trame et rveille la boucle par le tube de la bote ; la bote est
+// partage avec les tches, si bien que son tube reste ouvert tant qu'une tche peut y crire.
+class Outbox {
+public:
+    typedef std::vector<std::pair<std::shared_ptr<Connection>, std::vector<char> > > Frames;
+
+    Outbox() {
+        if (::pipe(fds) != 0) {
+            throw std::runtime_error(std::string("Cannot create pricing server response pipe: ") + std::strerror(errno));
+        }
+        ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    }
+    ~Outbox() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    Outbox(const Outbox&) = delete;
+    Outbox& operator=(const Outbox&) = delete;
+
+    // Appele depuis un thread de calcul
+    void post(const std::shared_ptr<Connection>& connection, const PricingResponse& response) {
+        std::vector<char> frame = PricingProtocol::encode(response);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.emplace_back(connection, std::move(frame));
+        }
+        char byte = 0;
+        ssize_t ignored = ::write(fds[1], &byte, 1); // Tube plein : la boucle est dj rveille
+        (void)ignored;
+    }
+
+    // Appele par le thread de lecture : trames dposes depuis le dernier appel
+    Frames take() {
+        drainPipe(fds[0]);
+        Frames taken;
+        std::lock_guard<std::mutex> lock(mutex);
+        taken.swap(frames);
+        return taken;
+    }
+
+    int readFd() const { return fds[0]; }
+
+private:
+    int fds[2];
+    std::mutex mutex;
+    Frames frames;
+};
+
+// Demande reue et connexion  qui rpondre
+struct PendingRequest {
+    std::shared_ptr<Connection> connection;
+    PricingRequest request;
+};
+
+static PricingResponse failure(std::uint64_t id, const std::string& message) {
+    return PricingResponse{id, false, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, message};
+}
+
+// Ajout d'une trame  envoyer (thread de lecture)
+static void enqueue(Connection& connection, const std::vector<char>& frame) {
+    if (!connection.broken) connection.output.insert(connection.output.end(), frame.begin(), frame.end());
+}
+
+// Envoi de ce que le socket accepte sans bloquer ; un client parti ne concerne que lui
+static void flush(Connection& connection) {
+    while (!connection.output.empty()) {
+        ssize_t sent = ::send(connection.fd, connection.output.data(), connection.output.size(),
+                              MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return; // Reprise quand le client aura lu
+            connection.broken = true;
+            connection.output.clear();
+            return;
+        }
+        connection.output.erase(connection.output.begin(), connection.output.begin() + sent);
+    }
+}
+
+static bool isVanilla(const PricingRequest& request) {
+    return request.product == ProductKind::Call || request.product == ProductKind::Put;
+}
+
+static void validate(const PricingRequest& request) {
+    const double values[] = {request.spot, request.volatility, request.maturity, request.strike,
+                             request.rate, request.dividend, request.barrier};
+    for (double value : values) {
+        if (!std::isfinite(value)) throw std::invalid_argument("Pricing request has a NaN or infinite parameter.");
+    }
+    if (!(request.spot > 0.0) || !(request.volatility > 0.0) || !(request.maturity > 0.0) || !(request.strike >= 0.0)) {
+        throw std::invalid_argument("Pricing request requires positive spot, volatility and maturity.");
+    }
+    if (request.product == ProductKind::Barrier && !(request.barrier > 0.0)) {
+        throw std::invalid_argument("Barrier pricing request requires a positive barrier.");
+    }
+    if (!isVanilla(request) && (request.numPaths <= 0 || request.steps <= 0)) {
+        throw std::invalid_argument("Monte-Carlo pricing request requires positive numPaths and steps.");
+    }
+    if (!isVanilla(request) &&
+        static_cast<long long>(request.numPaths) * (static_cast<long long>(request.steps) + 1) > MAX_PATH_VALUES) {
+        throw std::invalid_argument("Monte-Carlo pricing request is too large: numPaths * (steps + 1) exceeds " +
+                                    std::to_string(MAX_PATH_VALUES) + ".");
+    }
+}
+
+static BlackScholesModel makeModel(const PricingRequest& request) {
+    return BlackScholesModel(request.spot, request.rate, request.volatility, request.dividend);
+}
+
+static std::unique_ptr<ExoticOption> makeExotic(const PricingRequest& request) {
+    switch (request.product) {
+    case ProductKind::Asian:
+        return std::unique_ptr<ExoticOption>(new AsianOption(request.strike, request.maturity, request.optionType));
+    case ProductKind::Barrier:
+        return std::unique_ptr<ExoticOption>(new BarrierOption(request.strike, request.maturity, request.barrier,
+                                                               request.barrierType, request.optionType));
+    case ProductKind::Lookback:
+        return std::unique_ptr<ExoticOption>(new LookbackOption(request.strike, request.maturity, request.optionType));
+    default:
+        throw std::invalid_argument("Pricing request is not an exotic option.");
+    }
+}
+
+// Cl de regroupement : modle, maturit et rglages Monte-Carlo
+static PricingKey batchKey(const PricingRequest& request) {
+    PricingKey key;
+    makeModel(request).appendKey(key);
+    key.add(request.maturity)
+        .add(static_cast<long long>(request.numPaths))
+        .add(static_cast<long long>(request.steps))
+        .add(static_cast<long long>(request.seed));
+    return key;
+}
+
+// Cl d'une rponse : produit, modle et, pour une exotique, rglages Monte-Carlo (hors identifiant)
+static PricingKey responseKey(const PricingRequest& request) {
+    PricingKey key;
+    key.add("PricingServer").add(static_cast<long long>(request.product)).add(request.strike).add(request.maturity);
+    makeModel(request).appendKey(key);
+    if (!isVanilla(request)) {
+        key.add(static_cast<long long>(request.optionType))
+            .add(static_cast<long long>(request.numPaths))
+            .add(static_cast<long long>(request.steps))
+            .add(static_cast<long long>(request.seed));
+    }
+    if (request.product == ProductKind::Barrier) {
+        key.add(request.barrier).add(static_cast<long long>(request.barrierType));
+    }
+    return key;
+}
+
+// Rponse mmorise pour la mme demande ; false si elle est absente
+static bool lookup(PricingCache& cache, const PricingRequest& request, PricingResponse& response) {
+    std::vector<double> values;
+    if (!cache.find(responseKey(request), values)) return false;
+    response = failure(request.id, "");
+    response.ok = true;
+    response.price = values[0];
+    response.standardError = values[1];
+    response.delta = values[2];
+    response.gamma = values[3];
+    response.vega = values[4];
+    response.rho = values[5];
+    response.batchSize = static_cast<std::int32_t>(values[6]); // Lot qui l'a calcule
+    return true;
+}
+
+// Mmorise une rponse calcule (les refus ne sont pas mmoriss)
+static void remember(PricingCache& cache, const PricingRequest& request, const PricingResponse& response) {
+    if (!response.ok) return;
+    cache.insert(responseKey(request), {response.price, response.standardError, response.delta, response.gamma,
+                                        response.vega, response.rho, static_cast<double>(response.batchSize)});
+}
+
+PricingResponse PricingServer::priceVanilla(const PricingRequest& request) {
+    validate(request);
+    const bool isCall = request.product == ProductKind::Call;
+    std::unique_ptr<Option> option;
+    if (isCall) {
+        option.reset(new CallOption(request.strike, request.maturity));
+    } else {
+        option.reset(new PutOption(request.strike, request.maturity));
+    }
+
+    BlackScholesModel model = makeModel(request);
+    const double price = model.priceAnalytic(option.get(), isCall);
+    const double spotStep = VANILLA_BUMP * model.spot;
+    BlackScholesModel up = model, down = model;
+    up.spot += spotStep;
+    down.spot -= spotStep;
+    const double priceUp = up.priceAnalytic(option.get(), isCall);
+    const double priceDown = down.priceAnalytic(option.get(), isCall);
+    up = model;
+    down = model;
+    up.rate += VANILLA_BUMP;
+    down.rate -= VANILLA_BUMP;
+
+    PricingResponse response = failure(request.id, "");
+    response.ok = true;
+    response.price = price;
+    response.delta = (priceUp - priceDown) / (2.0 * spotStep);
+    response.gamma = (priceUp - 2.0 * price + priceDown) / (spotStep * spotStep);
+    response.vega = model.vegaAnalytic(option.get());
+    response.rho = (up.priceAnalytic(option.get(), isCall) - down.priceAnalytic(option.get(), isCall)) /
+                   (2.0 * VANILLA_BUMP);
+    response.batchSize = 1;
+    return response;
+}
+
+// Multiplie toutes les dates de toutes les trajectoires par factor (spot initial choqu)
+static void scalePaths(PathMatrix& paths, double factor) {
+    for (int j = 0; j <= paths.numSteps(); ++j) {
+        double* row = paths.step(j);
+        for (int i = 0; i < paths.numPaths(); ++i) row[i] *= factor;
+    }
+}
+
+std::vector<PricingResponse> PricingServer::priceBatch(const std::vector<PricingRequest>& requests) {
+    if (requests.empty()) {
+        throw std::invalid_argument("PricingServer::priceBatch requires at least one request.");
+    }
+    const PricingRequest& first = requests[0];
+    const std::size_t count = requests.size();
+    std::vector<std::unique_ptr<ExoticOption> > options;
+    for (const PricingRequest& request : requests) {
+        validate(request);
+        options.push_back(makeExotic(request));
+    }
+
+    const BlackScholesModel model = makeModel(first);
+    const double maturity = first.maturity;
+    const double discount = std::exp(-model.rateIntegral(0.0, maturity));
+    PathMatrix paths(first.numPaths, first.steps);
+    std::mt19937 rng(first.seed);
+    paths.simulate(model, maturity, rng);
+
+    // Prix et erreur standard sur les trajectoires de base
+    std::vector<PricingResponse> responses;
+    std::vector<double> mean(count);
+    for (std::size_t r = 0; r < count; ++r) {
+        double sum = 0.0, sumSquares = 0.0;
+        for (int i = 0; i < paths.numPaths(); ++i) {
+            double payoff = options[r]->payoff(paths.path(i));
+            sum += payoff;
+            sumSquares += payoff * payoff;
+        }
+        const int n = paths.numPaths();
+        mean[r] = sum / n;
+        double variance = n > 1 ? (sumSquares / n - mean[r] * mean[r]) * n / (n - 1) : 0.0;
+
+        PricingResponse response = failure(requests[r].id, "");
+        response.ok = true;
+        response.price = discount * mean[r];
+        response.standardError = discount * std::sqrt(variance / n);
+        response.batchSize = static_cast<std::int32_t>(count);
+        responses.push_back(response);
+    }
+
+    // Delta et gamma : homothtie des trajectoires (exacte en Black-Scholes)
+    const double spotStep = EXOTIC_SPOT_BUMP * model.spot;
+    std::vector<double> up(count);
+    scalePaths(paths, 1.0 + EXOTIC_SPOT_BUMP);
+    for (std::size_t r = 0; r < count; ++r) up[r] = options[r]->averagePayoff(paths);
+    scalePaths(paths, (1.0 - EXOTIC_SPOT_BUMP) / (1.0 + EXOTIC_SPOT_BUMP));
+    for (std::size_t r = 0; r < count; ++r) {
+        double down = options[r]->averagePayoff(paths);
+        responses[r].delta = discount * (up[r] - down) / (2.0 * spotStep);
+        responses[r].gamma = discount * (up[r] - 2.0 * mean[r] + down) / (spotStep * spotStep);
+    }
+
+    // Vega : mmes nombres alatoires, volatilit choque
+    BlackScholesModel shifted = model;
+    shifted.volatility += EXOTIC_VOL_BUMP;
+    rng.seed(first.seed);
+    paths.simulate(shifted, maturity, rng);
+    for (std::size_t r = 0; r < count; ++r) {
+        responses[r].vega = (discount * options[r]->averagePayoff(paths) - responses[r].price) / EXOTIC_VOL_BUMP;
+    }
+
+    // Rho : mmes nombres alatoires, taux choqu (drive et actualisation)
+    shifted = model;
+    shifted.rate += EXOTIC_RATE_BUMP;
+    const double shiftedDiscount = std::exp(-shifted.rateIntegral(0.0, maturity));
+    rng.seed(first.seed);
+    paths.simulate(shifted, maturity, rng);
+    for (std::size_t r = 0; r < count; ++r) {
+        responses[r].rho =
+            (shiftedDiscount * options[r]->averagePayoff(paths) - responses[r].price) / EXOTIC_RATE_BUMP;
+    }
+    return responses;
+}
+
+PricingServer::PricingServer(const std::string& socketPath_, unsigned numThreads, int batchWindowMicros_,
+                             std::size_t cacheCapacity)
+    : socketPath(socketPath_), batchWindowMicros(batchWindowMicros_), cache(cacheCapacity), pool(numThreads),
+      stopping(false) {
+    if (::pipe(wakeFds) != 0) {
+        throw std::runtime_error(std::string("Cannot create pricing server wake pipe: ") + std::strerror(errno));
+    }
+    ::fcntl(wakeFds[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(wakeFds[1], F_SETFL, O_NONBLOCK);
+}
+
+PricingServer::~PricingServer() {
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+}
+
+// Sr dans un gestionnaire de signal : une criture atomique et un write
+void PricingServer::stop() {
+    stopping = true;
+    char byte = 0;
+    ssize_t ignored = ::write(wakeFds[1], &byte, 1);
+    (void)ignored;
+}
+
+// Lots de la fentre : une tche par groupe d'exotiques, une tche pour les vanilles et les refus
+// Les rponses en cache ne sont pas recalcules ; chaque rponse est remise  outbox
+static void dispatch(ThreadPool& pool, PricingCache& cache, const std::shared_ptr<Outbox>& outbox,
+                     std::vector<PendingRequest>& pending) {
+    std::vector<std::vector<PendingRequest> > groups;
+    std::unordered_map<PricingKey, std::size_t, PricingKey::Hasher> groupIndex;
+    std::vector<PendingRequest> singles;
+    for (PendingRequest& item : pending) {
+        bool batchable = !isVanilla(item.request);
+        try {
+            validate(item.request);
+        } catch (const std::invalid_argument&) {
+            batchable = false; // Refuse par priceVanilla ou priceBatch avec le mme message
+        }
+        if (!batchable) {
+            singles.push_back(std::move(item));
+            continue;
+        }
+        auto inserted = groupIndex.emplace(batchKey(item.request), groups.size());
+        if (inserted.second) groups.emplace_back();
+        groups[inserted.first->second].push_back(std::move(item));
+    }
+    pending.clear();
+
+    PricingCache* responses = &cache;
+    for (auto& group : groups) {
+        auto shared = std::make_shared<std::vector<PendingRequest> >(std::move(group));
+        pool.submit([shared, responses, outbox]() {
+            // Demandes absentes du cache, simules ensemble
+            std::vector<PricingResponse> results(shared->size());
+            std::vector<PricingRequest> missing;
+            std::vector<std::size_t> position;
+            for (std::size_t r = 0; r < shared->size(); ++r) {
+                if (!lookup(*responses, (*shared)[r].request, results[r])) {
+                    missing.push_back((*shared)[r].request);
+                    position.push_back(r);
+                }
+            }
+            if (!missing.empty()) {
+                std::vector<PricingResponse> computed;
+                try {
+                    computed = PricingServer::priceBatch(missing);
+                } catch (const std::exception& error) {
+                    computed.clear();
+                    for (const PricingRequest& request : missing) computed.push_back(failure(request.id, error.what()));
+                }
+                for (std::size_t m = 0; m < missing.size(); ++m) {
+                    remember(*responses, missing[m], computed[m]);
+                    results[position[m]] = computed[m];
+                }
+            }
+            for (std::size_t r = 0; r < shared->size(); ++r) outbox->post((*shared)[r].connection, results[r]);
+        });
+    }
+    if (!singles.empty()) {
+        auto shared = std::make_shared<std::vector<PendingRequest> >(std::move(singles));
+        pool.submit([shared, responses, outbox]() {
+            for (const PendingRequest& item : *shared) {
+                PricingResponse response;
+                try {
+                    if (!isVanilla(item.request)) validate(item.request); // Exotique refuse
+                    if (!lookup(*responses, item.request, response)) {
+                        response = PricingServer::priceVanilla(item.request);
+                        remember(*responses, item.request, response);
+                    }
+                } catch (const std::exception& error) {
+                    response = failure(item.request.id, error.what());
+                }
+                outbox->post(item.connection, response);
+            }
+        });
+    }
+}
+
+// Dcoupe les trames compltes reues ; rend false si la connexion doit tre ferme
+static bool extractFrames(const std::shared_ptr<Connection>& connection, std::vector<PendingRequest>& pending) {
+    std::vector<char>& input = connection->input;
+    std::size_t offset = 0;
+    while (input.size() - offset >= sizeof(std::uint32_t)) {
+        std::uint32_t size;
+        std::memcpy(&size, input.data() + offset, sizeof(size));
+        if (size > PricingProtocol::MAX_PAYLOAD) return false;
+        if (input.size() - offset - sizeof(size) < size) break;
+        const char* payload = input.data() + offset + sizeof(size);
+        try {
+            pending.push_back(PendingRequest{connection, PricingProtocol::decodeRequest(payload, size)});
+            ++connection->unanswered;
+        } catch (const std::invalid_argument& error) {
+            // Identifiant repris s'il a pu tre lu, 0 sinon
+            enqueue(*connection, PricingProtocol::encode(failure(PricingProtocol::requestId(payload, size), error.what())));
+        }
+        offset += sizeof(size) + size;
+    }
+    input.erase(input.begin(), input.begin() + offset);
+    return true;
+}
+
+void PricingServer::run() {
+    typedef std::chrono::steady_clock Clock;
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Pricing socket path is too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath.c_str()); // Socket laiss par une excution prcdente
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        std::string reason = std::strerror(errno);
+        if (listenFd >= 0) ::close(listenFd);
+        throw std::runtime_error("Cannot listen on pricing socket " + socketPath + ": " + reason);
+    }
+
+    std::vector<std::shared_ptr<Connection> > connections;
+    std::vector<PendingRequest> pending;
+    std::shared_ptr<Outbox> outbox = std::make_shared<Outbox>();
+    long long unanswered = 0; // Demandes reues dont la rponse n'est pas revenue du calcul
+    bool draining = false;    // Arrt demand : plus de lecture, rponses restantes envoyes
+    Clock::time_point windowStart;
+    std::vector<char> chunk(1 << 16);
+
+    for (;;) {
+        if (stopping && !draining) {
+            draining = true;
+            if (!pending.empty()) dispatch(pool, cache, outbox, pending); // Demandes dj reues
+        }
+        if (draining && unanswered == 0 &&
+            std::none_of(connections.begin(), connections.end(),
+                         [](const std::shared_ptr<Connection>& c) { return !c->output.empty(); })) {
+            break;
+        }
+
+        // Lecture tant que le client envoie, criture tant qu'une rponse attend ; sinon ignore
+        std::vector<pollfd> fds;
+        fds.push_back(pollfd{wakeFds[0], POLLIN, 0});
+        fds.push_back(pollfd{outbox->readFd(), POLLIN, 0});
+        fds.push_back(pollfd{draining ? -1 : listenFd, POLLIN, 0});
+        for (const auto& connection : connections) {
+            short events = 0;
+            if (!draining && !connection->readClosed) events |= POLLIN;
+            if (!connection->output.empty()) events |= POLLOUT;
+            fds.push_back(pollfd{events != 0 ? connection->fd : -1, events, 0});
+        }
+
+        int timeout = -1; // Rien en attente : sommeil jusqu' la prochaine demande ou rponse
+        if (!pending.empty()) {
+            long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - windowStart).count();
+            timeout = static_cast<int>(std::max(0LL, (batchWindowMicros - elapsed + 999) / 1000));
+        }
+        if (::poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+            ::close(listenFd);
+            throw std::runtime_error(std::string("Pricing server poll failed: ") + std::strerror(errno));
+        }
+        if (fds[0].revents != 0) drainPipe(wakeFds[0]); // stopping est lu en tte de boucle
+
+        // Rponses revenues du calcul
+        if (fds[1].revents != 0) {
+            for (auto& item : outbox->take()) {
+                --unanswered;
+                --item.first->unanswered;
+                enqueue(*item.first, item.second);
+            }
+        }
+
+        const bool wasEmpty = pending.empty();
+        for (std::size_t c = 0; c < connections.size(); ++c) {
+            Connection& connection = *connections[c];
+            const short revents = fds[c + 3].revents;
+            if (!draining && !connection.readClosed && (revents & (POLLIN | POLLHUP | POLLERR))) {
+                ssize_t count = ::recv(connection.fd, chunk.data(), chunk.size(), MSG_DONTWAIT);
+                if (count > 0) {
+                    connection.input.insert(connection.input.end(), chunk.data(), chunk.data() + count);
+                    std::size_t before = pending.size();
+                    if (!extractFrames(connections[c], pending)) connection.broken = true; // Trame trop longue
+                    unanswered += static_cast<long long>(pending.size() - before);
+                } else if (count == 0) {
+                    connection.readClosed = true;
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    connection.broken = true;
+                }
+            }
+            flush(connection); // Rponses arrives ou place libre dans le socket
+        }
+        // Connexion retire si le client est parti, ou s'il a fini d'envoyer et tout reu ; une demande
+        // en cours garde sa connexion par son PendingRequest
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const std::shared_ptr<Connection>& c) {
+                                             return c->broken ||
+                                                    (c->readClosed && c->unanswered == 0 && c->output.empty());
+                                         }),
+                          connections.end());
+
+        if (fds[2].revents & POLLIN) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) connections.push_back(std::make_shared<Connection>(fd));
+        }
+
+        if (wasEmpty && !pending.empty()) windowStart = Clock::now();
+        if (!pending.empty() &&
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - windowStart).count() >= batchWindowMicros) {
+            dispatch(pool, cache, outbox, pending);
+        }
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+}
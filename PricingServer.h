@@ -0,0 +1,64 @@
+#ifndef PRICING_SERVER_H
+#define PRICING_SERVER_H
+
+#include "PricingCache.h"
+#include "PricingProtocol.h"
+#include "ThreadPool.h"
+#include <atomic> // Pour l'arrt
+#include <string> // Pour le chemin du socket
+#include <vector> // Pour les lots
+
+// Serveur de pricing rsident sur un socket Unix (mode --server du programme)
+//
+// Un seul thread lit toutes les connexions (poll) et dcoupe les trames ; les demandes reues
+// pendant une fentre de regroupement (batchWindowMicros aprs la premire) sont runies en lots.
+// Les exotiques d'un mme lot partagent le modle, la maturit et les rglages Monte-Carlo
+// (trajectoires, pas, graine) : les trajectoires sont simules une fois pour tout le lot, quel
+// que soit le nombre de clients. Les calls et puts sont valus analytiquement. Chaque lot est
+// calcul sur le ThreadPool du serveur, qui reste en place entre les demandes. Les rponses sont
+// lues d'abord dans un PricingCache (cl : produit, modle et rglages Monte-Carlo, hors
+// identifiant) ; seules les demandes absentes sont calcules, puis mmorises. Les threads de
+// calcul n'crivent pas sur les sockets : ils remettent les rponses encodes au thread de lecture,
+// qui les envoie sans bloquer, au rythme o chaque client les lit.
+// Une demande mal forme,  paramtre NaN ou infini, ou dont les trajectoires dpasseraient 2^25
+// prix (numPaths * (steps + 1)) est refuse par une rponse d'erreur portant son identifiant.
+class PricingServer {
+public:
+    // Constructeur : chemin du socket, threads de calcul (0 : nombre de coeurs), fentre de regroupement,
+    // nombre de rponses gardes en cache
+    explicit PricingServer(const std::string& socketPath_, unsigned numThreads = 0, int batchWindowMicros_ = 2000,
+                           std::size_t cacheCapacity = 4096);
+    ~PricingServer();
+
+    PricingServer(const PricingServer&) = delete;
+    PricingServer& operator=(const PricingServer&) = delete;
+
+    // Cre le socket et sert les demandes jusqu' stop() ; lve std::runtime_error si le socket
+    // ne peut pas tre cr. Le fichier du socket est supprim  l'arrt.
+    void run();
+
+    // Demande l'arrt de run() (depuis un autre thread ou un gestionnaire de signal) ;
+    // les demandes reues sont calcules et leurs rponses envoyes avant le retour de run()
+    void stop();
+
+    // Statistiques du cache des rponses
+    PricingCacheStats cacheStats() const { return cache.stats(); }
+
+    // Prix et grecques d'un lot d'exotiques sur trajectoires communes : delta et gamma par
+    // homothtie des trajectoires (+-1 % du spot), vega et rho par une nouvelle simulation
+    // avec les mmes nombres alatoires (+0.01 de volatilit, +0.1 % de taux)
+    static std::vector<PricingResponse> priceBatch(const std::vector<PricingRequest>& requests);
+
+    // Prix et grecques analytiques d'un call ou d'un put
+    static PricingResponse priceVanilla(const PricingRequest& request);
+
+private:
+    std::string socketPath;
+    int batchWindowMicros;
+    PricingCache cache;       // Dclar avant pool : les tches s'en servent jusqu' leur fin
+    ThreadPool pool;
+    int wakeFds[2];           // Tube de rveil de la boucle de lecture (stop)
+    std::atomic<bool> stopping;
+};
+
+#endif // PRICING_SERVER_H
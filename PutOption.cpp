@@ -1,7 +1,9 @@
 #include "PutOption.h"
 #include "BlackScholesModel.h" // Pour accder aux paramtres du modle Black-Scholes
+#include "PricingKey.h" // Cl de cache
 #include <cmath> // Pour les calculs mathmatiques, notamment std::max et std::exp
 #include <algorithm> // Pour std::max
+#include <random> // Pour std::mt19937 et std::generate_canonical
 
 // Constructeur de la classe PutOption
 // Initialise les paramtres strike (prix d'exercice) et maturity (maturit) via la classe mre Option
@@ -15,46 +17,53 @@ double PutOption::payoff(double spot) const {
 }
 
 // Mthode pour calculer le cot de rplication par delta hedging
-// Utilise le modle Black-Scholes pour ajuster dynamiquement le portefeuille
-double PutOption::hedgeCost(const BlackScholesModel& model, int steps) const {
+// La trajectoire couverte suit les intgrales par pas du modle (courbes et dividendes cash compris),
+// le delta  la date t est le delta analytique du modle vu depuis t (BlackScholesModel::rolled)
+// et le cash est capitalis avec la courbe de taux
+double PutOption::hedgeCost(const BlackScholesModel& model, int steps, const PricingContext& context) const {
     double dt = maturity / steps; // Intervalle de temps entre deux tapes
+    PathArena::Scope scratch;
+    const StepSchedule schedule = model.schedule(maturity, steps, scratch); // Intgrales par pas
+    double x = schedule.initialSpot; // Sous-jacent hors dividendes cash
     double spot = model.spot; // Prix initial du sous-jacent
     double previousDelta = 0.0; // Delta  l'tape prcdente, initialis  0
+    std::mt19937 rng = context.generator(); // Gnrateur de la trajectoire couverte
 
     // Calcul du delta initial (t = 0)
-    double d1 = (std::log(spot / strike) +
-                (model.rate - model.dividend + 0.5 * model.volatility * model.volatility) * maturity) /
-                (model.volatility * std::sqrt(maturity)); // Formule de Black-Scholes pour d1
-    double currentDelta = std::exp(-model.dividend * maturity) *
-                          (0.5 * (1.0 + std::erf(d1 / std::sqrt(2.0))) - 1.0); // Delta initial pour un put
+    double currentDelta = model.deltaAnalytic(this, false); // Delta initial
     double cash = currentDelta * spot; // Montant initial en cash
 
     // Boucle pour ajuster dynamiquement le portefeuille  chaque tape
     for (int i = 1; i <= steps; ++i) {
-        double time = i * dt; // Temps actuel
+        double time = (i == steps) ? maturity : i * dt; // Temps actuel (maturit exacte au dernier pas)
 
         // Simulation du prix du sous-jacent
         if (i < steps) { // Pas de simulation au dernier pas
-            double drift = (model.rate - model.dividend - 0.5 * model.volatility * model.volatility) * dt;
-            double diffusion = model.volatility * std::sqrt(dt) * ((double)rand() / RAND_MAX - 0.5); // Perturbation alatoire
-            spot *= std::exp(drift + diffusion); // Mise  jour du prix simul
+            double shock = std::generate_canonical<double, 53>(rng) - 0.5; // Perturbation alatoire
+            x *= std::exp(schedule.drift[i - 1] + schedule.diffusion[i - 1] * shock); // Mise  jour du prix simul
+            spot = x + schedule.dividendOffset[i];
         }
 
         previousDelta = currentDelta; // Stockage du delta prcdent
 
-        // Calcul du delta  l'instant t (t = maturity - time)
-        d1 = (std::log(spot / strike) +
-                     (model.rate - model.dividend + 0.5 * model.volatility * model.volatility) * (maturity - time)) /
-                    (model.volatility * std::sqrt(maturity - time)); // Mise  jour de d1
-        currentDelta = std::exp(-model.dividend * (maturity - time)) *
-                       (0.5 * (1.0 + std::erf(d1 / std::sqrt(2.0))) - 1.0); // Nouveau delta pour un put
+        // Calcul du delta  l'instant t, sous le modle vu depuis t (maturit restante maturity - time)
+        BlackScholesModel local = model.rolled(time);
+        local.spot = spot;
+        PutOption remaining(strike, maturity - time);
+        currentDelta = local.deltaAnalytic(&remaining, false); // Nouveau delta
 
         // Ajustement du portefeuille
         cash += (currentDelta - previousDelta) * spot; // Ajustement du cash pour reflter le changement de delta
-        cash *= std::exp(model.rate * dt); // Actualisation du cash avec le taux sans risque
+        cash *= std::exp(model.rateIntegral((i - 1) * dt, time)); // Capitalisation du cash avec le taux sans risque
     }
 
     // Retourner le cot total de rplication
     // Le cot est ajust par le dernier delta et le payoff final
     return cash - currentDelta * spot + payoff(spot);
 }
+
+// Cl de cache du produit
+void PutOption::appendKey(PricingKey& key) const {
+    key.add("PutOption");
+    Option::appendKey(key);
+}
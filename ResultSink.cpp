@@ -0,0 +1,303 @@
+#include "ResultSink.h"
+#include <algorithm> // Pour std::min et std::max
+#include <charconv>  // Pour std::to_chars
+#include <cstring>   // Pour std::memcpy et std::memcmp
+#include <fstream>   // Relecture des fichiers en colonnes
+#include <stdexcept> // Pour std::invalid_argument et std::runtime_error
+
+// Blocs en circulation avec un thread d'criture (un en remplissage, les autres en criture)
+static const int BACKGROUND_BLOCKS = 4;
+
+// En-tte des fichiers en colonnes
+static const char COLUMNAR_MAGIC[8] = {'P', 'R', 'C', 'O', 'L', '0', '0', '2'};
+
+// Octets d'une ligne hors identifiant (index, prix, erreur standard, statut, fin d'identifiant)
+static const std::size_t COLUMNAR_ROW_BYTES = 8 + 8 + 8 + 1 + 4;
+
+// Longueur d'identifiant suppose pour dimensionner un groupe, et plus petit groupe commenc dans
+// le reste d'un bloc
+static const std::size_t COLUMNAR_ID_HINT = 16;
+static const std::size_t COLUMNAR_MIN_GROUP = 4096;
+
+BlockWriter::BlockWriter(const std::string& filename_, bool background_, std::size_t blockSize_)
+    : filename(filename_), file(std::fopen(filename_.c_str(), "wb")), background(background_), blockSize(blockSize_),
+      used(0), closing(false), failed(false) {
+    if (!file) {
+        throw std::runtime_error("Cannot create result file " + filename + ".");
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0); // Les blocs remplacent le tampon de la bibliothque C
+    current = Block{std::unique_ptr<char[]>(new char[blockSize]), 0};
+    if (background) {
+        for (int b = 1; b < BACKGROUND_BLOCKS; ++b) {
+            freeBlocks.push_back(Block{std::unique_ptr<char[]>(new char[blockSize]), 0});
+        }
+        ioThread = std::thread([this]() { ioLoop(); });
+    }
+}
+
+BlockWriter::~BlockWriter() {
+    if (file) {
+        try {
+            close();
+        } catch (const std::runtime_error&) {
+        }
+    }
+}
+
+char* BlockWriter::reserve(std::size_t size) {
+    if (size > blockSize) {
+        throw std::invalid_argument("BlockWriter::reserve exceeds the block size.");
+    }
+    if (used + size > blockSize) submit();
+    return current.data.get() + used;
+}
+
+void BlockWriter::write(const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        if (used == blockSize) submit();
+        std::size_t count = std::min(size, blockSize - used);
+        std::memcpy(current.data.get() + used, bytes, count);
+        used += count;
+        bytes += count;
+        size -= count;
+    }
+}
+
+void BlockWriter::writeBlock(const Block& block) {
+    if (std::fwrite(block.data.get(), 1, block.size, file) != block.size) failed = true;
+}
+
+// Bloc courant confi  l'criture ; un bloc libre le remplace
+void BlockWriter::submit() {
+    if (used == 0) return;
+    current.size = used;
+    used = 0;
+    if (!background) {
+        writeBlock(current);
+        if (failed) throw std::runtime_error("Cannot write result file " + filename + ".");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    fullBlocks.push_back(std::move(current));
+    changed.notify_all();
+    changed.wait(lock, [this]() { return !freeBlocks.empty(); });
+    current = std::move(freeBlocks.front());
+    freeBlocks.pop_front();
+}
+
+void BlockWriter::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        changed.wait(lock, [this]() { return closing || !fullBlocks.empty(); });
+        if (fullBlocks.empty()) return; // Fermeture et plus rien  crire
+        Block block = std::move(fullBlocks.front());
+        fullBlocks.pop_front();
+        lock.unlock();
+        if (!failed) writeBlock(block);
+        lock.lock();
+        freeBlocks.push_back(std::move(block));
+        changed.notify_all();
+    }
+}
+
+void BlockWriter::close() {
+    if (!file) return;
+    submit();
+    if (background) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        changed.notify_all();
+        ioThread.join();
+    }
+    if (std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    if (failed) {
+        throw std::runtime_error("Cannot write result file " + filename + ".");
+    }
+}
+
+void ResultSink::write(const std::vector<TradeResult>& results) {
+    for (const TradeResult& result : results) write(result);
+}
+
+bool ResultSink::isColumnar(const std::string& filename) {
+    return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".col") == 0;
+}
+
+std::unique_ptr<ResultSink> ResultSink::open(const std::string& filename, bool backgroundIo) {
+    if (isColumnar(filename)) return std::unique_ptr<ResultSink>(new ColumnarResultSink(filename, backgroundIo));
+    return std::unique_ptr<ResultSink>(new CsvResultSink(filename, backgroundIo));
+}
+
+CsvResultSink::CsvResultSink(const std::string& filename, bool backgroundIo) : writer(filename, backgroundIo) {
+    static const char header[] = "index,id,status,price,standard_error\n";
+    writer.write(header, sizeof(header) - 1);
+}
+
+// Vrai si l'identifiant doit tre crit entre guillemets
+static bool needsQuotes(const std::string& id) {
+    return id.find_first_of(",\"\r\n") != std::string::npos;
+}
+
+// Une ligne formate directement dans le bloc
+void CsvResultSink::write(const TradeResult& result) {
+    // Trois nombres, l'identifiant (guillemets doubls au pire), le statut, sparateurs
+    const std::size_t maxSize = 3 * 32 + 2 * result.id.size() + 2 + 5 + 5;
+    char* begin = writer.reserve(maxSize);
+    char* end = begin + maxSize;
+    char* out = std::to_chars(begin, end, result.index).ptr;
+    *out++ = ',';
+    if (needsQuotes(result.id)) {
+        *out++ = '"';
+        for (char c : result.id) {
+            if (c == '"') *out++ = '"';
+            *out++ = c;
+        }
+        *out++ = '"';
+    } else {
+        std::memcpy(out, result.id.data(), result.id.size());
+        out += result.id.size();
+    }
+    *out++ = ',';
+    const char* status = result.status == TradeStatus::Ok ? "ok" : "error";
+    const std::size_t statusSize = std::strlen(status);
+    std::memcpy(out, status, statusSize);
+    out += statusSize;
+    *out++ = ',';
+    out = std::to_chars(out, end, result.price).ptr;
+    *out++ = ',';
+    out = std::to_chars(out, end, result.standardError).ptr;
+    *out++ = '\n';
+    writer.commit(static_cast<std::size_t>(out - begin));
+}
+
+void CsvResultSink::close() {
+    writer.close();
+}
+
+ColumnarResultSink::ColumnarResultSink(const std::string& filename, bool backgroundIo, std::size_t rowsPerGroup_)
+    : writer(filename, backgroundIo), rowsPerGroup(rowsPerGroup_ > 0 ? rowsPerGroup_ : 1), group(nullptr),
+      groupSpace(0), groupRows(0), rows(0), idBytes(0) {
+    writer.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+}
+
+// Copie d'une valeur  une adresse quelconque du bloc
+template <typename T>
+static void store(char* destination, T value) {
+    std::memcpy(destination, &value, sizeof(T));
+}
+
+// Nouveau groupe dans le reste du bloc courant, ou dans un nouveau bloc si ce reste est trop petit
+void ColumnarResultSink::startGroup(std::size_t idSize) {
+    const std::size_t needed = sizeof(std::uint32_t) + COLUMNAR_ROW_BYTES + idSize;
+    if (needed > writer.capacity()) {
+        throw std::invalid_argument("Trade id is too long for a columnar result block.");
+    }
+    std::size_t space = writer.available();
+    if (space < std::max(needed, COLUMNAR_MIN_GROUP)) space = writer.capacity();
+    group = writer.reserve(space);
+    groupSpace = space;
+    groupRows = (space - needed) / (COLUMNAR_ROW_BYTES + COLUMNAR_ID_HINT) + 1;
+    groupRows = std::min(groupRows, rowsPerGroup);
+    rows = 0;
+    idBytes = 0;
+}
+
+// Colonnes d'un groupe de capacit c : index en 0, prix en 8c, erreurs standard en 16c, statuts en
+// 24c, fins d'identifiants en 25c, identifiants en 29c (aprs le nombre de lignes)
+void ColumnarResultSink::write(const TradeResult& result) {
+    const std::size_t idSize = result.id.size();
+    if (group && (rows == groupRows ||
+                  sizeof(std::uint32_t) + groupRows * COLUMNAR_ROW_BYTES + idBytes + idSize > groupSpace)) {
+        flushGroup();
+    }
+    if (!group) startGroup(idSize);
+
+    char* columns = group + sizeof(std::uint32_t);
+    const std::size_t c = groupRows;
+    store(columns + 8 * rows, static_cast<long long>(result.index));
+    store(columns + 8 * c + 8 * rows, result.price);
+    store(columns + 16 * c + 8 * rows, result.standardError);
+    store(columns + 24 * c + rows, static_cast<std::uint8_t>(result.status));
+    std::memcpy(columns + 29 * c + idBytes, result.id.data(), idSize);
+    idBytes += idSize;
+    store(columns + 25 * c + 4 * rows, static_cast<std::uint32_t>(idBytes));
+    ++rows;
+}
+
+// Nombre de lignes, colonnes resserres sur les lignes crites, puis validation dans le bloc
+void ColumnarResultSink::flushGroup() {
+    if (!group) return;
+    store(group, static_cast<std::uint32_t>(rows));
+    char* columns = group + sizeof(std::uint32_t);
+    const std::size_t c = groupRows, n = rows;
+    if (n < c) { // Chaque colonne recule : copies dans l'ordre des colonnes
+        std::memmove(columns + 8 * n, columns + 8 * c, 8 * n);
+        std::memmove(columns + 16 * n, columns + 16 * c, 8 * n);
+        std::memmove(columns + 24 * n, columns + 24 * c, n);
+        std::memmove(columns + 25 * n, columns + 25 * c, 4 * n);
+        std::memmove(columns + 29 * n, columns + 29 * c, idBytes);
+    }
+    writer.commit(sizeof(std::uint32_t) + n * COLUMNAR_ROW_BYTES + idBytes);
+    group = nullptr;
+}
+
+void ColumnarResultSink::close() {
+    flushGroup();
+    const std::uint32_t end = 0;
+    writer.write(&end, sizeof(end));
+    writer.close();
+}
+
+template <typename T>
+static void readColumn(std::ifstream& file, std::vector<T>& column, std::size_t rows) {
+    column.resize(rows);
+    file.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(rows * sizeof(T)));
+}
+
+std::vector<TradeResult> ColumnarResultSink::read(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open result file " + filename + ".");
+    }
+    char magic[sizeof(COLUMNAR_MAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("Result file " + filename + " is not a columnar result file.");
+    }
+
+    std::vector<TradeResult> results;
+    std::vector<long long> indices;
+    std::vector<double> prices, standardErrors;
+    std::vector<std::uint8_t> statuses;
+    std::vector<std::uint32_t> idEnds;
+    std::string ids;
+    for (;;) {
+        std::uint32_t rows = 0;
+        file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+        if (!file) break;
+        if (rows == 0) return results;
+        readColumn(file, indices, rows);
+        readColumn(file, prices, rows);
+        readColumn(file, standardErrors, rows);
+        readColumn(file, statuses, rows);
+        readColumn(file, idEnds, rows);
+        if (!file) break;
+        ids.resize(idEnds.back());
+        file.read(&ids[0], static_cast<std::streamsize>(ids.size()));
+        if (!file) break;
+        std::uint32_t begin = 0;
+        for (std::uint32_t r = 0; r < rows; ++r) {
+            if (idEnds[r] < begin || idEnds[r] > ids.size() || statuses[r] > static_cast<std::uint8_t>(TradeStatus::Error)) {
+                throw std::runtime_error("Result file " + filename + " is corrupted.");
+            }
+            results.push_back(TradeResult{indices[r], ids.substr(begin, idEnds[r] - begin), prices[r], standardErrors[r],
+                                          static_cast<TradeStatus>(statuses[r])});
+            begin = idEnds[r];
+        }
+    }
+    throw std::runtime_error("Result file " + filename + " is truncated.");
+}
@@ -0,0 +1,144 @@
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include "BatchPricer.h" // Pour TradeResult
+#include <condition_variable> // Rveil du thread d'criture
+#include <cstdint>            // Pour std::uint32_t
+#include <cstdio>             // Pour std::FILE
+#include <deque>              // Blocs pleins et blocs libres
+#include <memory>             // Pour std::unique_ptr
+#include <mutex>              // Pour std::mutex
+#include <string>             // Pour les noms de fichiers
+#include <thread>             // Thread d'criture
+#include <vector>             // Pour les colonnes
+
+// criture d'un fichier par grands blocs prallous
+// Les donnes sont formates directement dans le bloc courant (reserve puis commit) ; un bloc
+// plein est crit d'un seul appel. Avec background, l'criture se fait sur un thread ddi et
+// l'appelant continue dans un autre bloc ; il n'attend que si tous les blocs sont en cours
+// d'criture (disque plus lent que le calcul).
+class BlockWriter {
+public:
+    // Lve std::runtime_error si le fichier ne peut tre cr
+    BlockWriter(const std::string& filename_, bool background_, std::size_t blockSize_ = 1 << 20);
+
+    // Ferme le fichier si close n'a pas t appel (erreurs ignores)
+    ~BlockWriter();
+
+    BlockWriter(const BlockWriter&) = delete;
+    BlockWriter& operator=(const BlockWriter&) = delete;
+
+    // Emplacement d'au moins size octets dans le bloc courant (size <= taille d'un bloc)
+    char* reserve(std::size_t size);
+
+    // Valide les size premiers octets du dernier emplacement rserv
+    void commit(std::size_t size) { used += size; }
+
+    // Octets encore libres dans le bloc courant et taille d'un bloc
+    std::size_t available() const { return blockSize - used; }
+    std::size_t capacity() const { return blockSize; }
+
+    // Copie size octets (ventuellement sur plusieurs blocs)
+    void write(const void* data, std::size_t size);
+
+    // crit le dernier bloc et ferme le fichier ; lve std::runtime_error si une criture a chou
+    void close();
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    void submit();
+    void writeBlock(const Block& block);
+    void ioLoop();
+
+    std::string filename;
+    std::FILE* file;
+    bool background;
+    std::size_t blockSize;
+    Block current;
+    std::size_t used; // Octets valides du bloc courant
+
+    std::deque<Block> fullBlocks; //  crire (thread d'criture)
+    std::deque<Block> freeBlocks; // Rutilisables
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread ioThread;
+    bool closing;
+    bool failed; // Une criture a chou
+};
+
+// Destination des rsultats d'un traitement par lots
+class ResultSink {
+public:
+    virtual ~ResultSink() = default;
+
+    // Ajoute un rsultat
+    virtual void write(const TradeResult& result) = 0;
+
+    // Ajoute des rsultats dans l'ordre
+    void write(const std::vector<TradeResult>& results);
+
+    // Termine le fichier ; lve std::runtime_error en cas d'chec d'criture
+    virtual void close() = 0;
+
+    // Format dduit du nom : colonnes binaires pour l'extension .col, CSV sinon
+    static bool isColumnar(const std::string& filename);
+    static std::unique_ptr<ResultSink> open(const std::string& filename, bool backgroundIo = false);
+};
+
+// CSV "index,id,status,price,standard_error" (status : ok ou error) ; les doubles sont crits sous
+// leur plus courte forme dcimale relue exactement (std::to_chars : nan, inf et -inf compris), sans
+// locale ni flux format. Un identifiant contenant une virgule, un guillemet ou un saut de ligne est
+// crit entre guillemets, ses guillemets doubls (RFC 4180).
+class CsvResultSink : public ResultSink {
+public:
+    explicit CsvResultSink(const std::string& filename, bool backgroundIo = false);
+
+    void write(const TradeResult& result) override;
+    void close() override;
+
+    using ResultSink::write;
+
+private:
+    BlockWriter writer;
+};
+
+// Fichier binaire en colonnes, par groupes de lignes :
+//   en-tte "PRCOL002"
+//   pour chaque groupe : n (uint32), index (int64 x n), price (double x n), standard_error (double x n),
+//                        status (uint8 x n, valeur de TradeStatus), fins cumules des identifiants
+//                        (uint32 x n), octets des identifiants
+//   fin : n = 0
+// Chaque colonne d'un groupe est contigu : un lecteur peut ne charger que les prix.
+// Un groupe est crit en place dans le bloc courant du BlockWriter,  des emplacements de colonne
+// prvus pour la capacit du groupe, puis resserr au besoin  sa fermeture : les valeurs ne
+// transitent par aucun tampon intermdiaire. Un groupe tient dans un bloc.
+class ColumnarResultSink : public ResultSink {
+public:
+    explicit ColumnarResultSink(const std::string& filename, bool backgroundIo = false, std::size_t rowsPerGroup_ = 65536);
+
+    void write(const TradeResult& result) override;
+    void close() override;
+
+    using ResultSink::write;
+
+    // Relecture complte ; lve std::runtime_error si le fichier est illisible ou tronqu
+    static std::vector<TradeResult> read(const std::string& filename);
+
+private:
+    void startGroup(std::size_t idSize);
+    void flushGroup();
+
+    BlockWriter writer;
+    std::size_t rowsPerGroup;
+    char* group;             // Groupe en cours dans le bloc du BlockWriter (nullptr si aucun)
+    std::size_t groupSpace;  // Octets rservs pour le groupe
+    std::size_t groupRows;   // Capacit du groupe en lignes
+    std::size_t rows;        // Lignes crites
+    std::size_t idBytes;     // Octets d'identifiants crits
+};
+
+#endif // RESULT_SINK_H
@@ -0,0 +1,244 @@
+#include "RiskEngine.h"
+#include "CallOption.h"
+#include "ExoticOption.h"
+#include "MonteCarloEngine.h" // Prix et grecques Monte-Carlo des exotiques
+#include "Parallel.h"         // Pour parallelFor
+#include "PutOption.h"
+#include <algorithm>          // Pour std::push_heap, std::pop_heap, std::sort
+#include <cmath>              // Pour std::ceil et std::isfinite
+#include <fstream>            // Pour std::ifstream
+#include <functional>         // Pour std::greater
+#include <mutex>              // Fusion des queues des threads
+#include <random>             // Pour std::mt19937
+#include <sstream>            // Pour std::istringstream
+#include <stdexcept>          // Pour std::invalid_argument et std::runtime_error
+
+// Pas des diffrences finies (relatif pour le spot, absolus pour la volatilit et le taux)
+// Les prix Monte-Carlo des exotiques (payoffs discontinus) demandent des pas plus larges
+static const double SPOT_BUMP = 1e-4;
+static const double VOL_BUMP = 1e-4;
+static const double RATE_BUMP = 1e-4;
+static const double EXOTIC_SPOT_BUMP = 1e-2;
+static const double EXOTIC_VOL_BUMP = 1e-2;
+static const double EXOTIC_RATE_BUMP = 1e-3;
+
+// Nombre minimal de scnarios par thread
+static const std::size_t SCENARIO_GRAIN = 64;
+
+// Pires pertes vues jusqu'ici : tas min de taille borne (la plus petite des pires pertes au sommet)
+class TailAccumulator {
+public:
+    explicit TailAccumulator(std::size_t capacity_) : capacity(capacity_) { losses.reserve(capacity + 1); }
+
+    void push(double loss) {
+        if (losses.size() < capacity) {
+            losses.push_back(loss);
+            std::push_heap(losses.begin(), losses.end(), std::greater<double>());
+        } else if (loss > losses.front()) {
+            std::pop_heap(losses.begin(), losses.end(), std::greater<double>());
+            losses.back() = loss;
+            std::push_heap(losses.begin(), losses.end(), std::greater<double>());
+        }
+    }
+
+    void merge(const TailAccumulator& other) {
+        for (double loss : other.losses) push(loss);
+    }
+
+    // Pertes de la queue, de la plus grande  la plus petite
+    std::vector<double> sorted() const {
+        std::vector<double> result = losses;
+        std::sort(result.begin(), result.end(), std::greater<double>());
+        return result;
+    }
+
+private:
+    std::size_t capacity;
+    std::vector<double> losses;
+};
+
+// Constructeur du moteur de risque
+RiskEngine::RiskEngine(double confidence_, RevaluationMethod method_, int numPaths_, int steps_, unsigned seed_,
+                       unsigned numThreads_)
+    : confidence(confidence_), method(method_), numPaths(numPaths_), steps(steps_), seed(seed_),
+      numThreads(numThreads_) {}
+
+// Lecture ligne  ligne
+std::vector<MarketMove> RiskEngine::loadMoves(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open scenario file " + filename + ".");
+    }
+    std::vector<MarketMove> moves;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        MarketMove move;
+        if (!(fields >> move.spotReturn)) continue; // Ligne vide
+        std::string rest;
+        if (!(fields >> move.volShift >> move.rateShift) || (fields >> rest)) {
+            throw std::invalid_argument("Malformed scenario at line " + std::to_string(lineNumber) + " of " + filename + ".");
+        }
+        if (!std::isfinite(move.spotReturn) || !std::isfinite(move.volShift) || !std::isfinite(move.rateShift) ||
+            !(move.spotReturn > -1.0)) {
+            throw std::invalid_argument("Invalid scenario at line " + std::to_string(lineNumber) + " of " + filename +
+                                        ": moves must be finite and spotReturn > -1.");
+        }
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+// Modle dans le scnario
+static BlackScholesModel shockedModel(const BlackScholesModel& model, const MarketMove& move) {
+    BlackScholesModel shocked = model;
+    shocked.spot = model.spot * (1.0 + move.spotReturn);
+    shocked.volatility = model.volatility + move.volShift;
+    shocked.rate = model.rate + move.rateShift;
+    if (!model.volatilityCurve.empty()) shocked.volatilityCurve = model.volatilityCurve.shifted(move.volShift);
+    if (!model.rateCurve.empty()) shocked.rateCurve = model.rateCurve.shifted(move.rateShift);
+    return shocked;
+}
+
+// Transaction classe une fois : call (+1), put (-1) ou exotique
+struct Trade {
+    const Option* option;
+    const ExoticOption* exotic;
+    int vanillaSign;
+    double quantity;
+};
+
+// Prix d'une transaction (graine fixe pour les exotiques : nombres alatoires communs aux scnarios)
+static double tradeValue(const Trade& trade, const BlackScholesModel& model, int numPaths, int steps, unsigned seed) {
+    if (trade.vanillaSign != 0) return model.priceAnalytic(trade.option, trade.vanillaSign > 0);
+    std::mt19937 rng(seed);
+    return MonteCarloEngine::run(*trade.exotic, model, numPaths, steps, trade.option->maturity,
+                                 SimulationPrecision::Double, rng).price;
+}
+
+RiskResult RiskEngine::run(const BlackScholesModel& model, const std::vector<const Option*>& portfolio,
+                           const std::vector<double>& quantities, const std::vector<MarketMove>& moves) const {
+    if (portfolio.size() != quantities.size()) {
+        throw std::invalid_argument("RiskEngine::run requires one quantity per trade.");
+    }
+    if (moves.empty()) {
+        throw std::invalid_argument("RiskEngine::run requires at least one scenario.");
+    }
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw std::invalid_argument("RiskEngine::run requires a confidence level in (0, 1).");
+    }
+    // Comme dans ScenarioEngine : un scnario ne doit rendre ni le spot ni la volatilit (scalaire,
+    // ou sur un intervalle de la courbe) nuls ou ngatifs
+    const double lowestVol = model.volatilityCurve.empty() ? model.volatility : model.volatilityCurve.minValue();
+    for (const MarketMove& move : moves) {
+        if (!std::isfinite(move.spotReturn) || !std::isfinite(move.volShift) || !std::isfinite(move.rateShift)) {
+            throw std::invalid_argument("RiskEngine::run requires finite scenario moves.");
+        }
+        if (!(move.spotReturn > -1.0)) {
+            throw std::invalid_argument("RiskEngine::run scenario spotReturn must be greater than -1.");
+        }
+        if (!(lowestVol + move.volShift > 0.0)) {
+            throw std::invalid_argument("RiskEngine::run scenario vol shift makes the volatility non-positive.");
+        }
+    }
+
+    std::vector<Trade> trades(portfolio.size());
+    for (std::size_t t = 0; t < portfolio.size(); ++t) {
+        Trade& trade = trades[t];
+        trade.option = portfolio[t];
+        trade.exotic = nullptr;
+        trade.quantity = quantities[t];
+        if (dynamic_cast<const CallOption*>(trade.option)) {
+            trade.vanillaSign = 1;
+        } else if (dynamic_cast<const PutOption*>(trade.option)) {
+            trade.vanillaSign = -1;
+        } else if ((trade.exotic = dynamic_cast<const ExoticOption*>(trade.option)) != nullptr) {
+            trade.vanillaSign = 0;
+        } else {
+            throw std::invalid_argument("RiskEngine only prices CallOption, PutOption and ExoticOption.");
+        }
+    }
+
+    // Valeurs de base (et sensibilits) par transaction, en parallle ; une ligne de 5 valeurs par transaction
+    const bool greeks = method == RevaluationMethod::DeltaGammaVega;
+    std::vector<double> perTrade(trades.size() * 5, 0.0); // Valeur, delta, gamma, vega, rho
+    parallelFor(trades.size(), 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            const Trade& trade = trades[t];
+            double* row = perTrade.data() + 5 * t;
+            row[0] = tradeValue(trade, model, numPaths, steps, seed);
+            if (!greeks) continue;
+
+            const bool exotic = trade.exotic != nullptr;
+            const double volBump = exotic ? EXOTIC_VOL_BUMP : VOL_BUMP;
+            const double rateBump = exotic ? EXOTIC_RATE_BUMP : RATE_BUMP;
+            double h = (exotic ? EXOTIC_SPOT_BUMP : SPOT_BUMP) * model.spot;
+            BlackScholesModel up = model, down = model;
+            up.spot += h;
+            down.spot -= h;
+            double valueUp = tradeValue(trade, up, numPaths, steps, seed);
+            double valueDown = tradeValue(trade, down, numPaths, steps, seed);
+            row[1] = (valueUp - valueDown) / (2.0 * h);
+            row[2] = (valueUp - 2.0 * row[0] + valueDown) / (h * h);
+
+            MarketMove volMove{0.0, volBump, 0.0}, rateMove{0.0, 0.0, rateBump};
+            row[3] = (tradeValue(trade, shockedModel(model, volMove), numPaths, steps, seed) - row[0]) / volBump;
+            row[4] = (tradeValue(trade, shockedModel(model, rateMove), numPaths, steps, seed) - row[0]) / rateBump;
+        }
+    }, numThreads);
+
+    // Agrgation dans l'ordre des transactions
+    double portfolioGreeks[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    for (std::size_t t = 0; t < trades.size(); ++t) {
+        for (int k = 0; k < 5; ++k) portfolioGreeks[k] += trades[t].quantity * perTrade[5 * t + k];
+    }
+    const double baseValue = portfolioGreeks[0];
+
+    // Pertes par scnario : chaque thread conserve sa queue, fusionne ensuite sous verrou
+    // (l'ensemble des tailSize plus grandes pertes ne dpend pas de l'ordre de fusion)
+    const std::size_t numScenarios = moves.size();
+    const std::size_t tailSize = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::ceil((1.0 - confidence) * numScenarios - 1e-9)));
+    TailAccumulator tail(tailSize);
+    std::mutex tailMutex;
+
+    parallelFor(numScenarios, SCENARIO_GRAIN, [&](std::size_t begin, std::size_t end) {
+        TailAccumulator local(tailSize);
+        for (std::size_t s = begin; s < end; ++s) {
+            const MarketMove& move = moves[s];
+            double pnl;
+            if (greeks) {
+                double dS = model.spot * move.spotReturn;
+                pnl = portfolioGreeks[1] * dS + 0.5 * portfolioGreeks[2] * dS * dS +
+                      portfolioGreeks[3] * move.volShift + portfolioGreeks[4] * move.rateShift;
+            } else {
+                BlackScholesModel shocked = shockedModel(model, move);
+                double value = 0.0;
+                for (const Trade& trade : trades) {
+                    value += trade.quantity * tradeValue(trade, shocked, numPaths, steps, seed);
+                }
+                pnl = value - baseValue;
+            }
+            local.push(-pnl);
+        }
+        std::lock_guard<std::mutex> lock(tailMutex);
+        tail.merge(local);
+    }, numThreads);
+
+    std::vector<double> worst = tail.sorted();
+
+    double sum = 0.0;
+    for (double loss : worst) sum += loss;
+    RiskResult result;
+    result.valueAtRisk = worst.back();
+    result.expectedShortfall = sum / worst.size();
+    result.baseValue = baseValue;
+    result.numScenarios = static_cast<int>(numScenarios);
+    result.tailSize = static_cast<int>(worst.size());
+    return result;
+}
@@ -0,0 +1,65 @@
+#ifndef RISK_ENGINE_H
+#define RISK_ENGINE_H
+
+#include "BlackScholesModel.h"
+#include "Option.h"
+#include <string> // Pour le nom du fichier de scnarios
+#include <vector> // Pour le portefeuille et les scnarios
+
+// Mthode de rvaluation des transactions dans chaque scnario
+enum class RevaluationMethod { Full, DeltaGammaVega };
+
+// Variation de march d'un scnario (historique ou simul)
+struct MarketMove {
+    double spotReturn; // Rendement relatif du spot : S -> S (1 + spotReturn)
+    double volShift;   // Choc absolu de volatilit
+    double rateShift;  // Choc absolu de taux
+};
+
+// Mesures de risque d'un portefeuille (pertes positives)
+struct RiskResult {
+    double valueAtRisk;       // Perte dpasse dans une proportion 1 - confidence des scnarios
+    double expectedShortfall; // Perte moyenne au-del de la VaR (moyenne des tailSize pires pertes)
+    double baseValue;         // Valeur du portefeuille dans le modle de base
+    int numScenarios;         // Nombre de scnarios valus
+    int tailSize;             // Nombre de scnarios dans la queue
+};
+
+// VaR et Expected Shortfall par rvaluation d'un portefeuille sur une liste de scnarios
+//
+// Full : chaque transaction est reprice dans chaque scnario (priceAnalytic pour les calls et
+// puts, Monte-Carlo  graine fixe pour les exotiques : mmes nombres alatoires que le prix de base).
+// DeltaGammaVega : les sensibilits de chaque transaction sont calcules une fois, puis agrges
+// en sensibilits du portefeuille ; un scnario ne cote alors qu'un polynme, quel que soit le
+// nombre de transactions. Dans les deux cas, les scnarios sont rpartis sur les threads et chaque
+// thread ne conserve que ses pires pertes (tas born de taille tailSize) : la mmoire ne dpend
+// pas du nombre de scnarios ni de transactions, et le rsultat ne dpend pas du nombre de threads.
+class RiskEngine {
+public:
+    double confidence;        // Niveau de confiance (0.99 : VaR  99 %)
+    RevaluationMethod method; // Rvaluation complte ou approximation par les grecques
+    int numPaths;             // Trajectoires Monte-Carlo par prix d'exotique
+    int steps;                // Pas de temps par trajectoire
+    unsigned seed;            // Graine commune des prix Monte-Carlo
+    unsigned numThreads;      // 0 : nombre de coeurs
+
+    // Constructeur
+    RiskEngine(double confidence_ = 0.99, RevaluationMethod method_ = RevaluationMethod::DeltaGammaVega,
+               int numPaths_ = 20000, int steps_ = 100, unsigned seed_ = 0, unsigned numThreads_ = 0);
+
+    // Lecture d'un fichier de scnarios : une ligne "spotReturn volShift rateShift" par scnario
+    // (sparateurs espaces, tabulations ou virgules ; lignes vides et commentaires '#' ignors)
+    // Lve std::runtime_error si le fichier ne peut tre ouvert, std::invalid_argument si une ligne est mal forme,
+    // contient une valeur non finie ou un spotReturn <= -1
+    static std::vector<MarketMove> loadMoves(const std::string& filename);
+
+    // VaR et ES du portefeuille sum_t quantities[t] * portfolio[t]
+    // Lve std::invalid_argument si les tailles diffrent, si la liste de scnarios est vide, si le
+    // niveau de confiance n'est pas dans ]0, 1[, pour une option qui n'est ni un call, ni un put, ni une option exotique,
+    // ou pour un scnario non fini, de spotReturn <= -1 ou dont le choc de volatilit rendrait la volatilit
+    // (scalaire, ou sur un intervalle de la courbe) nulle ou ngative
+    RiskResult run(const BlackScholesModel& model, const std::vector<const Option*>& portfolio,
+                   const std::vector<double>& quantities, const std::vector<MarketMove>& moves) const;
+};
+
+#endif // RISK_ENGINE_H
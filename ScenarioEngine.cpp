@@ -0,0 +1,140 @@
+#include "ScenarioEngine.h"
+#include "CallOption.h"
+#include "ExoticOption.h"
+#include "NormalDistribution.h" // Normales communes  tous les scnarios
+#include "Parallel.h"           // Pour parallelFor
+#include "PathArena.h"          // Mmoire de travail (trajectoires relatives, sommes par scnario)
+#include "PutOption.h"
+#include <algorithm>            // Pour std::min
+#include <cmath>                // Pour std::exp
+#include <random>               // Pour std::mt19937
+#include <stdexcept>            // Pour std::invalid_argument
+
+// Trajectoires par bloc de normales communes
+static const int BLOCK_PATHS = 1024;
+
+// Constructeur du moteur de scnarios
+ScenarioEngine::ScenarioEngine(int numPaths_, int steps_, unsigned seed_, unsigned numThreads_)
+    : numPaths(numPaths_), steps(steps_), seed(seed_), numThreads(numThreads_) {}
+
+// Modle choqu
+static BlackScholesModel shiftedModel(const BlackScholesModel& model, double spotShift, double volShift) {
+    BlackScholesModel shifted = model;
+    shifted.spot = model.spot * (1.0 + spotShift);
+    shifted.volatility = model.volatility + volShift;
+    if (!model.volatilityCurve.empty()) shifted.volatilityCurve = model.volatilityCurve.shifted(volShift);
+    return shifted;
+}
+
+ScenarioCube ScenarioEngine::run(const BlackScholesModel& model, const std::vector<const Option*>& portfolio,
+                                 const std::vector<double>& spotShifts, const std::vector<double>& volShifts) const {
+    if (spotShifts.empty() || volShifts.empty()) {
+        throw std::invalid_argument("ScenarioEngine::run requires at least one spot shift and one vol shift.");
+    }
+    // Un choc additif ne doit pas rendre la volatilit nulle ou ngative (sur aucun intervalle de la courbe)
+    const double lowestVol = model.volatilityCurve.empty() ? model.volatility : model.volatilityCurve.minValue();
+    for (double volShift : volShifts) {
+        if (!(lowestVol + volShift > 0.0)) {
+            throw std::invalid_argument("ScenarioEngine::run vol shift makes the volatility non-positive.");
+        }
+    }
+    const int numSpots = static_cast<int>(spotShifts.size());
+    const int numVols = static_cast<int>(volShifts.size());
+    const int numTrades = static_cast<int>(portfolio.size());
+
+    // Classement des transactions (une seule fois)
+    std::vector<const ExoticOption*> exotics(numTrades, nullptr);
+    std::vector<int> vanillaSign(numTrades, 0); // +1 call, -1 put, 0 exotique
+    bool anyExotic = false;
+    for (int t = 0; t < numTrades; ++t) {
+        if (dynamic_cast<const CallOption*>(portfolio[t])) {
+            vanillaSign[t] = 1;
+        } else if (dynamic_cast<const PutOption*>(portfolio[t])) {
+            vanillaSign[t] = -1;
+        } else if ((exotics[t] = dynamic_cast<const ExoticOption*>(portfolio[t])) != nullptr) {
+            anyExotic = true;
+        } else {
+            throw std::invalid_argument("ScenarioEngine only prices CallOption, PutOption and ExoticOption.");
+        }
+    }
+
+    ScenarioCube cube{numSpots, numVols, numTrades,
+                      std::vector<double>(static_cast<std::size_t>(numSpots) * numVols * numTrades, 0.0)};
+
+    // Calls et puts : une tche par couple (choc de volatilit, transaction)
+    parallelFor(static_cast<std::size_t>(numVols) * numTrades, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t task = begin; task < end; ++task) {
+            const int j = static_cast<int>(task / numTrades);
+            const int t = static_cast<int>(task % numTrades);
+            if (vanillaSign[t] == 0) continue;
+            for (int i = 0; i < numSpots; ++i) {
+                BlackScholesModel scenario = shiftedModel(model, spotShifts[i], volShifts[j]);
+                cube.values[(static_cast<std::size_t>(i) * numVols + j) * numTrades + t] =
+                    scenario.priceAnalytic(portfolio[t], vanillaSign[t] > 0);
+            }
+        }
+    }, numThreads);
+    if (!anyExotic) return cube;
+
+    // Intgrales par pas de chaque couple (choc de volatilit, transaction exotique), indpendantes du spot
+    PathArena::Scope scratch;
+    std::vector<StepSchedule> schedules(static_cast<std::size_t>(numVols) * numTrades);
+    for (int j = 0; j < numVols; ++j) {
+        const BlackScholesModel volScenario = shiftedModel(model, 0.0, volShifts[j]);
+        for (int t = 0; t < numTrades; ++t) {
+            if (exotics[t]) schedules[static_cast<std::size_t>(j) * numTrades + t] =
+                volScenario.schedule(exotics[t]->maturity, steps, scratch);
+        }
+    }
+    // Sommes des payoffs par cellule du cube, accumules dans l'ordre des trajectoires
+    std::vector<double> sums(cube.values.size(), 0.0);
+
+    // Normales communes tires bloc par bloc (mmes tirages, dans le mme ordre, que
+    // MonteCarloEngine::run) ; chaque bloc est rvalu en parallle sur tous les couples
+    std::mt19937 rng(seed);
+    double* normals = scratch.allocate(static_cast<std::size_t>(BLOCK_PATHS) * steps);
+    for (int first = 0; first < numPaths; first += BLOCK_PATHS) {
+        const int count = std::min(BLOCK_PATHS, numPaths - first);
+        NormalDistribution::sample(rng, normals, static_cast<std::size_t>(count) * steps);
+
+        parallelFor(static_cast<std::size_t>(numVols) * numTrades, 1, [&](std::size_t begin, std::size_t end) {
+            PathArena::Scope local; // Arne du thread de travail
+            double* growth = local.allocate(steps); // Facteurs de croissance de la trajectoire
+            double* path = local.allocate(steps + 1);
+            for (std::size_t task = begin; task < end; ++task) {
+                const int j = static_cast<int>(task / numTrades);
+                const int t = static_cast<int>(task % numTrades);
+                if (!exotics[t]) continue;
+                const StepSchedule& schedule = schedules[task];
+
+                for (int p = 0; p < count; ++p) {
+                    const double* z = normals + static_cast<std::size_t>(p) * steps;
+                    for (int s = 0; s < steps; ++s) growth[s] = std::exp(schedule.drift[s] + schedule.diffusion[s] * z[s]);
+
+                    // Mme suite d'oprations que MonteCarloEngine : produit cumul depuis le spot
+                    // hors dividendes, puis dividendes cash rajouts
+                    for (int i = 0; i < numSpots; ++i) {
+                        path[0] = model.spot * (1.0 + spotShifts[i]) - schedule.dividendOffset[0];
+                        for (int s = 0; s < steps; ++s) path[s + 1] = path[s] * growth[s];
+                        if (schedule.hasCashDividends) {
+                            for (int s = 0; s <= steps; ++s) path[s] += schedule.dividendOffset[s];
+                        }
+                        sums[(static_cast<std::size_t>(i) * numVols + j) * numTrades + t] +=
+                            exotics[t]->payoff(PathView(path, steps + 1));
+                    }
+                }
+            }
+        }, numThreads);
+    }
+
+    for (int i = 0; i < numSpots; ++i) {
+        for (int j = 0; j < numVols; ++j) {
+            for (int t = 0; t < numTrades; ++t) {
+                if (!exotics[t]) continue;
+                const std::size_t cell = (static_cast<std::size_t>(i) * numVols + j) * numTrades + t;
+                cube.values[cell] = schedules[static_cast<std::size_t>(j) * numTrades + t].discount * (sums[cell] / numPaths);
+            }
+        }
+    }
+    return cube;
+}
@@ -0,0 +1,52 @@
+#ifndef SCENARIO_ENGINE_H
+#define SCENARIO_ENGINE_H
+
+#include "BlackScholesModel.h"
+#include "Option.h"
+#include <cstddef> // Pour std::size_t
+#include <vector>  // Pour le portefeuille, les chocs et le cube de rsultats
+
+// Cube dense des prix : un prix par (choc de spot, choc de volatilit, transaction)
+struct ScenarioCube {
+    int numSpotShifts;
+    int numVolShifts;
+    int numTrades;
+    std::vector<double> values; // values[(i * numVolShifts + j) * numTrades + t]
+
+    double at(int spotIndex, int volIndex, int trade) const {
+        return values[(static_cast<std::size_t>(spotIndex) * numVolShifts + volIndex) * numTrades + trade];
+    }
+};
+
+// Rvaluation complte d'un portefeuille sur une grille de chocs spot x volatilit
+//
+// Le scnario (i, j) est le modle de base avec spot * (1 + spotShifts[i]) et la volatilit (scalaire
+// et courbe) translate de volShifts[j]. Les chocs sont additifs : un choc qui rendrait la volatilit
+// nulle ou ngative (scalaire, ou sur un intervalle de la courbe) est rejet, pas tronqu  zro.
+// Les calls et puts sont reprics par priceAnalytic ; les options exotiques par Monte-Carlo avec
+// les mmes normales pour tous les scnarios (nombres
+// alatoires communs : les carts entre scnarios ne sont pas bruits par le tirage). Les normales
+// sont tires par blocs de trajectoires (la mmoire ne dpend pas de numPaths) ; pour chaque
+// trajectoire, les facteurs de croissance (les exponentielles) sont calculs une fois par choc de
+// volatilit et par transaction, puis rutiliss pour tous les chocs de spot. Les couples (choc de
+// volatilit, transaction) sont rpartis sur les threads ; le rsultat ne dpend pas du nombre de
+// threads. Un scnario sans choc suit les mmes oprations que MonteCarloEngine::run (gnrateur
+// initialis par seed) et donne le mme prix, bit  bit.
+class ScenarioEngine {
+public:
+    int numPaths;        // Trajectoires par prix Monte-Carlo
+    int steps;           // Pas de temps par trajectoire
+    unsigned seed;       // Graine des normales communes
+    unsigned numThreads; // 0 : nombre de coeurs
+
+    // Constructeur
+    ScenarioEngine(int numPaths_ = 20000, int steps_ = 100, unsigned seed_ = 0, unsigned numThreads_ = 0);
+
+    // Cube des prix du portefeuille (CallOption, PutOption ou ExoticOption)
+    // Lve std::invalid_argument pour un autre type d'option, une grille vide ou un choc de volatilit
+    // qui rendrait la volatilit nulle ou ngative
+    ScenarioCube run(const BlackScholesModel& model, const std::vector<const Option*>& portfolio,
+                     const std::vector<double>& spotShifts, const std::vector<double>& volShifts) const;
+};
+
+#endif // SCENARIO_ENGINE_H
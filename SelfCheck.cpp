@@ -0,0 +1,752 @@
+#include "SelfCheck.h"
+#include "AsianOption.h"
+#include "BarrierOption.h"
+#include "BatchPricer.h"      // Lots et runion des rsultats
+#include "Checkpoint.h"       // Points de reprise
+#include "CallOption.h"
+#include "DeltaHedge.h"       // Couverture reprenable
+#include "FourierPricer.h"    // Mthode COS
+#include "HestonModel.h"
+#include "ImpliedVolatility.h"
+#include "JumpDiffusionModel.h"
+#include "LatticeEngine.h"
+#include "LocalVolatilityModel.h"
+#include "LookbackOption.h"
+#include "MonteCarloEngine.h" // Calcul Monte-Carlo reprenable
+#include "MultiAssetModel.h"
+#include "NormalDistribution.h"
+#include "PathArena.h"
+#include "PathMatrix.h"
+#include "PdeEngine.h"
+#include "PricingServer.h"    // Serveur et clients sur socket Unix
+#include "PutOption.h"
+#include <algorithm>          // Pour std::max et std::minmax_element
+#include <cmath>              // Pour std::abs, std::sqrt, std::exp, std::log et std::erfc
+#include <csignal>            // Pour SIGKILL
+#include <cstdio>             // Pour std::remove
+#include <cstdint>            // Pour std::uintptr_t
+#include <cstdlib>            // Pour mkdtemp
+#include <fstream>            // Fichiers de transactions et de rsultats
+#include <functional>         // Vrifications nommes
+#include <iterator>           // Pour std::istreambuf_iterator
+#include <sstream>            // Pour std::ostringstream
+#include <stdexcept>          // Pour std::runtime_error
+#include <sys/wait.h>         // Pour waitpid
+#include <thread>             // Thread du serveur
+#include <unistd.h>           // Pour fork, access, usleep et rmdir
+#include <vector>
+
+// Rpertoire temporaire des fichiers de travail, supprim avec son contenu
+class ScratchDirectory {
+public:
+    ScratchDirectory() {
+        char pattern[] = "/tmp/pricer-check-XXXXXX";
+        if (!::mkdtemp(pattern)) throw std::runtime_error("Cannot create a temporary directory.");
+        directory = pattern;
+    }
+
+    ~ScratchDirectory() {
+        for (const std::string& file : files) std::remove(file.c_str());
+        ::rmdir(directory.c_str());
+    }
+
+    // Chemin d'un fichier du rpertoire
+    std::string file(const std::string& name) {
+        files.push_back(directory + "/" + name);
+        return files.back();
+    }
+
+private:
+    std::string directory;
+    std::vector<std::string> files;
+};
+
+// Contenu d'un fichier
+static std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Prix Monte-Carlo d'une option exotique sur les blocs d'un modle simul par blocs (simulate lance
+// la simulation avec le visiteur donn) : sommes par bloc runies dans l'ordre des blocs, erreur
+// standard de PayoffSums
+template <typename Simulate>
+static MonteCarloResult blockPrice(const ExoticOption& option, int numPaths, int blockPaths, double discount,
+                                   Simulate simulate) {
+    std::vector<PayoffSums> sums((numPaths + blockPaths - 1) / blockPaths, PayoffSums{0.0, 0.0, 0, discount});
+    simulate([&](const PathBlock& block) {
+        PayoffSums& own = sums[block.index];
+        for (int i = 0; i < block.count; ++i) {
+            const double payoff = option.payoff(block.path(i));
+            own.sum += payoff;
+            own.sumSquares += payoff * payoff;
+        }
+        own.numPaths = block.count;
+    });
+    PayoffSums total{0.0, 0.0, 0, discount};
+    for (const PayoffSums& blockSums : sums) total.add(blockSums);
+    return total.result();
+}
+
+// Loi normale : cdf compare  erfc, inverseCdf(cdf(x)) rend x, versions sur tableaux identiques
+static bool normalDistributionInverts(std::ostream& out) {
+    std::vector<double> x, p(1601), q(1601), inverse(1601);
+    for (int i = -800; i <= 800; ++i) x.push_back(0.01 * i);
+    NormalDistribution::cdf(x.data(), p.data(), x.size());
+    double cdfError = 0.0, inverseError = 0.0;
+    bool sameArrays = true;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        sameArrays = sameArrays && p[i] == NormalDistribution::cdf(x[i]);
+        cdfError = std::max(cdfError, std::abs(p[i] - 0.5 * std::erfc(-x[i] / std::sqrt(2.0))));
+    }
+    // Aller-retour sur la queue gauche ( droite, p proche de 1 perd ses dcimales)
+    NormalDistribution::inverseCdf(p.data(), inverse.data(), p.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (x[i] < -6.0 || x[i] > 0.0) continue;
+        sameArrays = sameArrays && inverse[i] == NormalDistribution::inverseCdf(p[i]);
+        inverseError = std::max(inverseError, std::abs(inverse[i] - x[i]) / std::max(1.0, std::abs(x[i])));
+    }
+    const bool ok = cdfError < 1e-14 && inverseError < 1e-10 && sameArrays;
+    out << "  cdf / erfc : cart " << cdfError << ", inverseCdf(cdf(x)) / x : cart relatif " << inverseError
+        << (sameArrays ? "" : ", tableaux diffrents du calcul scalaire") << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Volatilit implicite : prix analytiques d'un smile (calls au-dessus de la monnaie, puts en dessous)
+// inverss un par un et en batch
+static bool impliedVolatilityRecovers(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.03, 0.0, 0.01);
+    const ImpliedVolatilitySolver solver;
+    std::vector<VolQuote> quotes;
+    std::vector<double> expected;
+    for (double maturity : {0.5, 1.0, 3.0}) {
+        for (int k = 0; k <= 12; ++k) {
+            const double strike = 70.0 + 5.0 * k, moneyness = std::log(strike / 100.0);
+            BlackScholesModel quoted = model;
+            quoted.volatility = 0.2 - 0.05 * moneyness + 0.5 * moneyness * moneyness;
+            const CallOption option(strike, maturity);
+            quotes.push_back({strike, maturity, quoted.priceAnalytic(&option, strike >= 100.0), strike >= 100.0});
+            expected.push_back(quoted.volatility);
+        }
+    }
+    std::vector<double> batch(quotes.size());
+    solver.solve(model, quotes.data(), batch.data(), quotes.size(), 2);
+    // Le plus grand cart ; un NaN (cotation rejete) se propage et fait chouer la vrification
+    auto worst = [](double error, double vol, double expectedVol) {
+        const double gap = std::abs(vol - expectedVol);
+        return gap <= error ? error : gap;
+    };
+    double scalarError = 0.0, batchError = 0.0;
+    for (std::size_t i = 0; i < quotes.size(); ++i) {
+        const CallOption option(quotes[i].strike, quotes[i].maturity);
+        scalarError = worst(scalarError, solver.solve(model, &option, quotes[i].isCall, quotes[i].price), expected[i]);
+        batchError = worst(batchError, batch[i], expected[i]);
+    }
+    const bool ok = scalarError < 1e-8 && batchError < 1e-8;
+    out << "  " << quotes.size() << " cotations : cart de volatilit " << scalarError << " (une par une), "
+        << batchError << " (batch)" << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Arne : portes imbriques rendues en pile, tampons aligns, aucune allocation systme une fois chauffe
+static bool pathArenaReuses(std::ostream& out) {
+    PathArena arena;
+    auto aligned = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) % PathArena::ALIGNMENT == 0; };
+    PathArena::Scope outer(arena);
+    double* head = outer.allocate(3);
+    double* first = nullptr;
+    double* second = nullptr;
+    {
+        PathArena::Scope inner(arena);
+        first = inner.allocate(1 << 20); // Dpasse le premier bloc
+    }
+    {
+        PathArena::Scope inner(arena);
+        second = inner.allocate(1 << 20);
+    }
+    const bool reused = first == second && aligned(head) && aligned(first) && aligned(outer.allocateAs<float>(5));
+
+    // Un prix Monte-Carlo sur le thread appelant, rpt : la seconde fois, aucun bloc n'est demand
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const AsianOption option(100.0, 1.0, OptionType::Call);
+    std::mt19937 rng(5);
+    MonteCarloEngine::run(option, model, 5000, 64, option.maturity, SimulationPrecision::Double, rng);
+    const std::size_t warm = PathArena::allocationCount();
+    MonteCarloEngine::run(option, model, 5000, 64, option.maturity, SimulationPrecision::Double, rng);
+    const std::size_t allocations = PathArena::allocationCount() - warm;
+
+    const bool ok = reused && allocations == 0;
+    out << "  porte rendue puis rutilise : " << (first == second ? "mme tampon" : "tampon diffrent")
+        << ", alignement " << PathArena::ALIGNMENT << " : " << (reused ? "respect" : "non respect")
+        << ", allocations du second prix : " << allocations << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Matrice de trajectoires : lignes alignes, vues par trajectoire cohrentes avec l'accs (date,
+// trajectoire), version float proche de la version double sur le mme gnrateur, et prix  terme
+// actualis gal au spot net de dividendes (martingale)
+static bool pathMatrixConsistent(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const int numPaths = 10000, steps = 50;
+    const double maturity = 1.0;
+    PathMatrix paths(numPaths, steps);
+    PathMatrixF pathsF(numPaths, steps);
+    std::mt19937 rng(9), rngF(9);
+    paths.simulate(model, maturity, rng);
+    pathsF.simulate(model, maturity, rngF);
+
+    bool layout = paths.pitch() * sizeof(double) % PathMatrix::ALIGNMENT == 0 &&
+                  pathsF.pitch() * sizeof(float) % PathMatrixF::ALIGNMENT == 0;
+    for (int j = 0; j <= steps; ++j) {
+        layout = layout && reinterpret_cast<std::uintptr_t>(paths.step(j)) % PathMatrix::ALIGNMENT == 0;
+    }
+    double sum = 0.0, sumSquares = 0.0, floatGap = 0.0;
+    for (int i = 0; i < numPaths; ++i) {
+        const PathView path = paths.path(i);
+        for (int j = 0; j <= steps; ++j) {
+            layout = layout && path[j] == paths(j, i);
+            floatGap = std::max(floatGap, std::abs(pathsF(j, i) - path[j]) / path[j]);
+        }
+        sum += path.back();
+        sumSquares += path.back() * path.back();
+    }
+    const double discount = std::exp(-model.rate * maturity);
+    const double mean = sum / numPaths;
+    const double standardError = discount * std::sqrt((sumSquares / numPaths - mean * mean) / numPaths);
+    const double forward = discount * mean, expected = model.spot * std::exp(-model.dividend * maturity);
+
+    const bool ok = layout && floatGap < 1e-3 && std::abs(forward - expected) < 4.0 * standardError;
+    out << "  disposition " << (layout ? "cohrente" : "incohrente") << ", cart relatif float / double "
+        << floatGap << ", E[S_T] actualis " << forward << " pour " << expected << " (erreur standard "
+        << standardError << ")" << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Simulation en float : mmes nombres alatoires qu'en double, cart de prix trs infrieur  l'erreur standard
+static bool singlePrecisionAgrees(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const AsianOption asian(100.0, 1.0, OptionType::Call);
+    const BarrierOption barrier(100.0, 1.0, 130.0, BarrierType::UpAndOut, OptionType::Call);
+    const LookbackOption lookback(105.0, 1.0, OptionType::Put);
+    const std::pair<const char*, const ExoticOption*> options[] = {
+        {"asiatique", &asian}, {"barrire", &barrier}, {"lookback", &lookback}};
+
+    bool ok = true;
+    for (const auto& named : options) {
+        const PrecisionReport report = MonteCarloEngine::comparePrecision(*named.second, model, 50000, 64, 13);
+        const bool match = report.differenceInStdErrors < 0.1;
+        out << "  " << named.first << " : float " << report.singleResult.price << ", double "
+            << report.doubleResult.price << ", soit " << report.differenceInStdErrors << " erreur(s) standard"
+            << (match ? "" : "  <- cart") << "\n";
+        ok = ok && match;
+    }
+    return ok;
+}
+
+// EDP : vanilles compares aux formules fermes (prix, delta, gamma), barrire discrte compare au
+// Monte-Carlo sur les mmes dates d'observation
+static bool pdeMatchesAnalytic(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const PdeEngine pde;
+    const CallOption call(105.0, 1.0);
+    const PutOption put(95.0, 1.0);
+    BlackScholesModel up = model, down = model;
+    up.spot += 0.01;
+    down.spot -= 0.01;
+
+    bool ok = true;
+    for (const bool isCall : {true, false}) {
+        const Option* option = isCall ? static_cast<const Option*>(&call) : &put;
+        const PdeResult result = isCall ? pde.price(model, call) : pde.price(model, put);
+        const double price = model.priceAnalytic(option, isCall);
+        const double delta = model.deltaAnalytic(option, isCall);
+        const double gamma = (up.deltaAnalytic(option, isCall) - down.deltaAnalytic(option, isCall)) / 0.02;
+        const bool match = std::abs(result.price - price) < 1e-3 && std::abs(result.delta - delta) < 1e-4 &&
+                           std::abs(result.gamma - gamma) < 1e-5;
+        out << "  " << (isCall ? "call" : "put") << " : prix EDP " << result.price << " / " << price << ", delta "
+            << result.delta << " / " << delta << ", gamma " << result.gamma << " / " << gamma
+            << (match ? "" : "  <- cart") << "\n";
+        ok = ok && match;
+    }
+
+    const int steps = 64;
+    const BarrierOption barrier(100.0, 1.0, 130.0, BarrierType::UpAndOut, OptionType::Call);
+    const PdeResult discrete = PdeEngine(400, 200, 2, 5.0, steps).price(model, barrier);
+    std::mt19937 rng(21);
+    const MonteCarloResult mc = MonteCarloEngine::run(barrier, model, 200000, steps, barrier.maturity,
+                                                      SimulationPrecision::Double, rng);
+    const bool match = std::abs(discrete.price - mc.price) < 4.0 * mc.standardError;
+    out << "  up-and-out observe " << steps << " fois : EDP " << discrete.price << ", Monte-Carlo " << mc.price
+        << " (erreur standard " << mc.standardError << ")" << (match ? "" : "  <- cart") << "\n";
+    return ok && match;
+}
+
+// COS : calls et puts trs loin de la monnaie, seuls ou en une chane, compars  la formule
+// ferme (le domaine de troncature ne contient alors plus forcment y = 0)
+static bool cosMatchesAnalytic(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.03, 0.2, 0.0);
+    const FourierPricer fourier;
+    const double strikes[] = {0.5, 10.0, 60.0, 100.0, 160.0, 400.0, 1000.0};
+
+    std::vector<VolQuote> chain;
+    for (const double strike : strikes)
+        for (const bool isCall : {true, false}) chain.push_back({strike, 1.0, 0.0, isCall});
+    std::vector<double> chainPrices(chain.size());
+    fourier.price(model, chain.data(), chainPrices.data(), chain.size(), FourierMethod::Cos);
+
+    double worst = 0.0;
+    bool ok = true;
+    for (std::size_t i = 0; i < chain.size(); ++i) {
+        double alone = 0.0;
+        fourier.price(model, &chain[i], &alone, 1, FourierMethod::Cos);
+        const CallOption call(chain[i].strike, 1.0);
+        const PutOption put(chain[i].strike, 1.0);
+        const Option* option = chain[i].isCall ? static_cast<const Option*>(&call) : &put;
+        const double analytic = model.priceAnalytic(option, chain[i].isCall);
+        const double error = std::max(std::abs(alone - analytic), std::abs(chainPrices[i] - analytic));
+        worst = std::max(worst, error);
+        if (error > 1e-6 || alone < 0.0 || chainPrices[i] < 0.0) {
+            out << "  " << (chain[i].isCall ? "call" : "put") << " K = " << chain[i].strike << " : COS seul "
+                << alone << ", en chane " << chainPrices[i] << ", formule ferme " << analytic << "  <- cart\n";
+            ok = false;
+        }
+    }
+    out << "  " << chain.size() << " cotations de K = " << strikes[0] << "  K = " << strikes[6]
+        << " : cart maximal " << worst << "\n";
+    return ok;
+}
+
+// Sauts : Merton sans sauts gal  Black-Scholes, parit call-put des formules fermes (srie de
+// Merton, COS de Kou), formules fermes compares au Monte-Carlo d'un call  barrire lointaine
+static bool jumpDiffusionMatches(std::ostream& out) {
+    const CallOption call(100.0, 1.0);
+    const PutOption put(100.0, 1.0);
+    const BlackScholesModel blackScholes(100.0, 0.03, 0.2, 0.01);
+    const JumpDiffusionModel noJumps = JumpDiffusionModel::merton(100.0, 0.03, 0.2, 0.01, 0.0, -0.1, 0.15);
+    const double noJumpGap = std::abs(noJumps.priceAnalytic(&call, true) - blackScholes.priceAnalytic(&call, true));
+    bool ok = noJumpGap < 1e-10;
+    out << "  Merton sans sauts : cart  Black-Scholes " << noJumpGap << (ok ? "" : "  <- cart") << "\n";
+
+    const BarrierOption farBarrier(100.0, 1.0, 1e6, BarrierType::UpAndOut, OptionType::Call);
+    const int numPaths = 100000, steps = 50;
+    const std::pair<const char*, JumpDiffusionModel> models[] = {
+        {"Merton", JumpDiffusionModel::merton(100.0, 0.03, 0.2, 0.01, 1.0, -0.1, 0.15)},
+        {"Kou", JumpDiffusionModel::kou(100.0, 0.03, 0.2, 0.01, 1.0, 0.4, 10.0, 5.0)}};
+    for (const auto& named : models) {
+        const JumpDiffusionModel& model = named.second;
+        const double callPrice = model.priceAnalytic(&call, true), putPrice = model.priceAnalytic(&put, false);
+        const double forward = model.spot * std::exp(-model.dividend) - call.strike * std::exp(-model.rate);
+        const double parityGap = std::abs(callPrice - putPrice - forward);
+        std::mt19937 rng(31);
+        const MonteCarloResult mc = blockPrice(farBarrier, numPaths, JumpDiffusionModel::BLOCK_PATHS,
+                                               std::exp(-model.rate), [&](const PathBlockVisitor& visit) {
+            model.simulate(numPaths, steps, 1.0, rng, visit);
+        });
+        const bool match = parityGap < 1e-8 && std::abs(mc.price - callPrice) < 4.0 * mc.standardError;
+        out << "  " << named.first << " : call " << callPrice << ", Monte-Carlo " << mc.price << " (erreur standard "
+            << mc.standardError << "), parit call-put " << parityGap << (match ? "" : "  <- cart") << "\n";
+        ok = ok && match;
+    }
+    return ok;
+}
+
+// Volatilit locale : une nappe implicite plate donne une surface de Dupire plate, et le
+// Monte-Carlo du modle retrouve le prix de Black-Scholes (call  barrire lointaine)
+static bool localVolatilityFlat(std::ostream& out) {
+    const double flatVol = 0.2;
+    const std::vector<double> strikes = {60.0, 80.0, 100.0, 120.0, 160.0}, maturities = {0.25, 0.5, 1.0, 2.0};
+    const LocalVolatilityModel model(100.0, 0.03, 0.01, strikes, maturities,
+                                     std::vector<double>(strikes.size() * maturities.size(), flatVol));
+    double surfaceError = 0.0;
+    for (double t : {0.0, 0.3, 1.0, 1.9}) {
+        for (double s : {50.0, 80.0, 100.0, 130.0, 200.0}) {
+            surfaceError = std::max(surfaceError, std::abs(model.localVolatility(t, s) - flatVol));
+        }
+    }
+    const bool flat = surfaceError < 1e-6;
+    out << "  nappe plate  " << flatVol << " : cart maximal de la volatilit locale " << surfaceError
+        << (flat ? "" : "  <- cart") << "\n";
+
+    const BlackScholesModel blackScholes(100.0, 0.03, flatVol, 0.01);
+    const CallOption call(100.0, 1.0);
+    const BarrierOption farBarrier(100.0, 1.0, 1e6, BarrierType::UpAndOut, OptionType::Call);
+    const double analytic = blackScholes.priceAnalytic(&call, true);
+    const int numPaths = 100000, steps = 50;
+    std::mt19937 rng(37);
+    const MonteCarloResult mc = blockPrice(farBarrier, numPaths, LocalVolatilityModel::BLOCK_PATHS,
+                                           std::exp(-model.rate), [&](const PathBlockVisitor& visit) {
+        model.simulate(numPaths, steps, 1.0, rng, visit);
+    });
+    const bool match = std::abs(mc.price - analytic) < 4.0 * mc.standardError;
+    out << "  call : Monte-Carlo " << mc.price << " (erreur standard " << mc.standardError << "), Black-Scholes "
+        << analytic << (match ? "" : "  <- cart") << "\n";
+    return flat && match;
+}
+
+// Heston : formule de Lewis compare au Monte-Carlo du schma QE (call  barrire lointaine),
+// paramtres hors domaine rejets par le constructeur
+static bool hestonMatches(std::ostream& out) {
+    const HestonModel model(100.0, 0.03, 0.01, 0.04, 1.5, 0.04, 0.5, -0.7);
+    const CallOption call(100.0, 1.0);
+    const BarrierOption farBarrier(100.0, 1.0, 1e6, BarrierType::UpAndOut, OptionType::Call);
+    const double analytic = model.priceAnalytic(&call, true);
+    const int numPaths = 100000, steps = 50;
+    std::mt19937 rng(41);
+    const MonteCarloResult mc = blockPrice(farBarrier, numPaths, HestonModel::BLOCK_PATHS, std::exp(-model.rate),
+                                           [&](const PathBlockVisitor& visit) {
+        model.simulate(numPaths, steps, 1.0, rng, visit);
+    });
+    const bool match = std::abs(mc.price - analytic) < 4.0 * mc.standardError;
+    out << "  call : Lewis " << analytic << ", Monte-Carlo QE " << mc.price << " (erreur standard " << mc.standardError
+        << ")" << (match ? "" : "  <- cart") << "\n";
+
+    int rejected = 0;
+    const double invalid[][2] = {{0.0, 0.5}, {1.5, 0.0}}; // kappa = 0, puis xi = 0
+    for (const auto& parameters : invalid) {
+        try {
+            HestonModel(100.0, 0.03, 0.01, 0.04, parameters[0], 0.04, parameters[1], -0.7);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    out << "  kappa = 0 et xi = 0 : " << rejected << " modle(s) rejet(s) sur 2" << (rejected == 2 ? "" : "  <- cart")
+        << "\n";
+    return match && rejected == 2;
+}
+
+// Multi-actifs : un panier d'un seul actif retrouve le prix de Black-Scholes, et les rendements
+// simuls de trois actifs (un actif isol par les pondrations, mme graine) ont les corrlations
+// vises (produit L Z de la factorisation de Cholesky)
+static bool multiAssetMatches(std::ostream& out) {
+    const MultiAssetModel single({100.0}, {0.2}, {0.01}, 0.03, {1.0});
+    const BlackScholesModel blackScholes(100.0, 0.03, 0.2, 0.01);
+    const CallOption call(100.0, 1.0);
+    const BarrierOption farBarrier(100.0, 1.0, 1e6, BarrierType::UpAndOut, OptionType::Call);
+    const double analytic = blackScholes.priceAnalytic(&call, true);
+    const int numPaths = 100000, steps = 50;
+    std::mt19937 rng(43);
+    const MonteCarloResult mc = blockPrice(farBarrier, numPaths, MultiAssetModel::BLOCK_PATHS, std::exp(-single.rate),
+                                           [&](const PathBlockVisitor& visit) {
+        single.simulate(numPaths, steps, BasketType::Basket, {1.0}, 1.0, rng, visit);
+    });
+    const bool match = std::abs(mc.price - analytic) < 4.0 * mc.standardError;
+    out << "  panier d'un actif : Monte-Carlo " << mc.price << " (erreur standard " << mc.standardError
+        << "), Black-Scholes " << analytic << (match ? "" : "  <- cart") << "\n";
+
+    const int n = 3;
+    const std::vector<double> correlation = {1.0, 0.5, 0.3, 0.5, 1.0, -0.2, 0.3, -0.2, 1.0};
+    const MultiAssetModel model({100.0, 90.0, 110.0}, {0.2, 0.3, 0.25}, {0.0, 0.01, 0.02}, 0.03, correlation);
+    std::vector<std::vector<double> > returns(n);
+    for (int a = 0; a < n; ++a) {
+        std::vector<double> weights(n, 0.0);
+        weights[a] = 1.0;
+        PathMatrix paths(numPaths, 1);
+        std::mt19937 sameRng(47);
+        model.simulate(paths, BasketType::Basket, weights, 1.0, sameRng);
+        for (int i = 0; i < numPaths; ++i) returns[a].push_back(std::log(paths(1, i) / paths(0, i)));
+    }
+    auto sampleCorrelation = [numPaths](const std::vector<double>& x, const std::vector<double>& y) {
+        double mx = 0.0, my = 0.0, sxy = 0.0, sxx = 0.0, syy = 0.0;
+        for (int i = 0; i < numPaths; ++i) {
+            mx += x[i];
+            my += y[i];
+        }
+        mx /= numPaths;
+        my /= numPaths;
+        for (int i = 0; i < numPaths; ++i) {
+            sxy += (x[i] - mx) * (y[i] - my);
+            sxx += (x[i] - mx) * (x[i] - mx);
+            syy += (y[i] - my) * (y[i] - my);
+        }
+        return sxy / std::sqrt(sxx * syy);
+    };
+    double correlationError = 0.0;
+    for (int a = 0; a < n; ++a) {
+        for (int b = 0; b < a; ++b) {
+            const double gap = std::abs(sampleCorrelation(returns[a], returns[b]) - correlation[a * n + b]);
+            correlationError = std::max(correlationError, gap);
+        }
+    }
+    // Erreur standard d'une corrlation empirique : au plus 1 / sqrt(numPaths), soit environ 0.003
+    const bool correlated = correlationError < 0.015;
+    out << "  trois actifs : cart maximal des corrlations empiriques " << correlationError
+        << (correlated ? "" : "  <- cart") << "\n";
+    return match && correlated;
+}
+
+// Arbres : put europen compar  la formule ferme, put amricain au-dessus de l'europen et
+// identique d'un arbre  l'autre, call amricain sans dividende gal au call europen
+static bool latticeMatchesAnalytic(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01), noDividend(100.0, 0.05, 0.2, 0.0);
+    const PutOption put(105.0, 1.0);
+    const CallOption call(100.0, 1.0);
+    const double price = model.priceAnalytic(&put, false), delta = model.deltaAnalytic(&put, false);
+    const std::pair<const char*, LatticeType> types[] = {
+        {"CRR", LatticeType::CoxRossRubinstein}, {"Leisen-Reimer", LatticeType::LeisenReimer},
+        {"trinomial", LatticeType::Trinomial}};
+
+    bool ok = true;
+    std::vector<double> americans; // Put amricain, un prix par arbre
+    for (const auto& named : types) {
+        const LatticeEngine lattice(named.second);
+        const LatticeResult european = lattice.price(model, put, ExerciseStyle::European);
+        const LatticeResult american = lattice.price(model, put, ExerciseStyle::American);
+        const double callGap = lattice.price(noDividend, call, ExerciseStyle::American).price -
+                               lattice.price(noDividend, call, ExerciseStyle::European).price;
+        const bool match = std::abs(european.price - price) < 1e-2 && std::abs(european.delta - delta) < 1e-3 &&
+                           american.price > european.price + 0.1 && std::abs(callGap) < 1e-12;
+        out << "  " << named.first << " : put europen " << european.price << " / " << price << ", amricain "
+            << american.price << ", call amricain - europen sans dividende " << callGap
+            << (match ? "" : "  <- cart") << "\n";
+        americans.push_back(american.price);
+        ok = ok && match;
+    }
+    const auto range = std::minmax_element(americans.begin(), americans.end());
+    const double spread = *range.second - *range.first;
+    const bool agree = spread < 1e-2;
+    out << "  puts amricains : cart entre arbres " << spread << (agree ? "" : "  <- cart") << "\n";
+
+    // Drive forte, volatilit faible : sur 10 pas, sigma sqrt(dt) < r dt (probabilits CRR et trinomiales
+    // hors de [0, 1], probabilit de Leisen-Reimer arrondie  1) ; sur 2000 pas, les arbres sont valides
+    const BlackScholesModel drifting(100.0, 0.2, 0.01, 0.0);
+    const double driftingPrice = drifting.priceAnalytic(&call, true);
+    for (const auto& named : types) {
+        bool rejected = false;
+        try {
+            LatticeEngine(named.second, 10).price(drifting, call, ExerciseStyle::European);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        const double fine = LatticeEngine(named.second, 2000).price(drifting, call, ExerciseStyle::European).price;
+        const bool match = rejected && std::abs(fine - driftingPrice) < 1e-2;
+        out << "  " << named.first << ", r = 0.2 et sigma = 0.01 : 10 pas " << (rejected ? "rejets" : "accepts")
+            << ", 2000 pas " << fine << " / " << driftingPrice << (match ? "" : "  <- cart") << "\n";
+        ok = ok && match;
+    }
+    return ok && agree;
+}
+
+// cart admis entre une sensibilit AAD et sa diffrence finie (erreur de troncature des chocs)
+static bool agrees(double aad, double bumped) {
+    return std::abs(aad - bumped) <= 1e-3 * std::max(1.0, std::abs(bumped));
+}
+
+// Sensibilits AAD et diffrences finies centres, mmes nombres alatoires
+static bool aadMatchesBumps(std::ostream& out) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const PricingContext context(7);
+    const int numPaths = 20000, steps = 50;
+    const AsianOption asian(100.0, 1.0, OptionType::Call);
+    const LookbackOption lookback(110.0, 1.0, OptionType::Put); // Prix d'exercice loin du spot : pas de coude en S0
+    const std::pair<const char*, const ExoticOption*> options[] = {{"asiatique", &asian}, {"lookback", &lookback}};
+
+    bool ok = true;
+    for (const auto& named : options) {
+        const ExoticOption& option = *named.second;
+        MonteCarloGreeks greeks = option.greeks(model, numPaths, steps, context);
+        auto price = [&](const BlackScholesModel& bumped) {
+            return option.price(bumped, numPaths, steps, SimulationPrecision::Double, context);
+        };
+        BlackScholesModel up = model, down = model;
+        up.spot *= 1.001;
+        down.spot *= 0.999;
+        const double delta = (price(up) - price(down)) / (0.002 * model.spot);
+        up = down = model;
+        up.volatility += 1e-3;
+        down.volatility -= 1e-3;
+        const double vega = (price(up) - price(down)) / 2e-3;
+        up = down = model;
+        up.rate += 1e-4;
+        down.rate -= 1e-4;
+        const double rho = (price(up) - price(down)) / 2e-4;
+
+        const std::pair<const char*, std::pair<double, double> > pairs[] = {
+            {"delta", {greeks.delta, delta}}, {"vega", {greeks.vega, vega}}, {"rho", {greeks.rho, rho}}};
+        for (const auto& pair : pairs) {
+            const bool match = agrees(pair.second.first, pair.second.second);
+            out << "  " << named.first << " " << pair.first << " : AAD " << pair.second.first
+                << ", diffrences finies " << pair.second.second << (match ? "" : "  <- cart") << "\n";
+            ok = ok && match;
+        }
+    }
+    return ok;
+}
+
+// Calcul Monte-Carlo tu aprs son premier point de reprise, puis repris
+static bool monteCarloResumes(std::ostream& out, ScratchDirectory& scratch) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const AsianOption option(100.0, 1.0, OptionType::Call);
+    const int numPaths = 400000, steps = 64, chunkPaths = 4096;
+    const unsigned seed = 11;
+    const Checkpoint reference(scratch.file("reference.ckpt"));
+    const Checkpoint interrupted(scratch.file("interrupted.ckpt"));
+
+    MonteCarloResult expected = MonteCarloEngine::runCheckpointed(option, model, numPaths, steps, seed, reference, 1, chunkPaths);
+
+    pid_t pid = ::fork();
+    if (pid < 0) throw std::runtime_error("Cannot fork the interrupted computation.");
+    if (pid == 0) {
+        MonteCarloEngine::runCheckpointed(option, model, numPaths, steps, seed, interrupted, 1, chunkPaths);
+        ::_exit(0);
+    }
+    bool saved = false; // Point de reprise observ avant la fin du fils
+    int status = 0;
+    while (::waitpid(pid, &status, WNOHANG) == 0) {
+        if (::access(interrupted.path().c_str(), F_OK) == 0) {
+            ::kill(pid, SIGKILL);
+            ::waitpid(pid, &status, 0);
+            saved = true;
+            break;
+        }
+        ::usleep(1000);
+    }
+    if (!saved) {
+        out << "  le calcul s'est termin avant son premier point de reprise\n";
+        return false;
+    }
+    CheckpointState state;
+    interrupted.load(state);
+    MonteCarloResult resumed = MonteCarloEngine::runCheckpointed(option, model, numPaths, steps, seed, interrupted, 1, chunkPaths);
+    const bool ok = resumed.price == expected.price && resumed.standardError == expected.standardError;
+    out << "  Monte-Carlo interrompu au morceau " << state.counters[0] << " : prix repris " << resumed.price
+        << ", ininterrompu " << expected.price << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Couverture en delta arrte aprs quelques pas, puis reprise
+static bool hedgeResumes(std::ostream& out, ScratchDirectory& scratch) {
+    const BlackScholesModel model(100.0, 0.05, 0.2, 0.01);
+    const AsianOption option(100.0, 1.0, OptionType::Call);
+    const int steps = 12, stopAfter = 5;
+    const DeltaHedge hedge(option, model, steps, PricingContext(3), 2000);
+    const Checkpoint checkpoint(scratch.file("hedge.ckpt"));
+
+    HedgeResult expected = hedge.run();
+    int calls = 0;
+    HedgeResult partial = hedge.run(&checkpoint, 1, [&calls]() { return calls++ == stopAfter; });
+    HedgeResult resumed = hedge.run(&checkpoint, 1);
+    const bool ok = partial.deltaSteps == stopAfter && resumed.deltaSteps == steps &&
+                    resumed.cost == expected.cost && resumed.standardError == expected.standardError &&
+                    ::access(checkpoint.path().c_str(), F_OK) != 0;
+    out << "  couverture arrte au pas " << partial.deltaSteps << " : cot repris " << resumed.cost
+        << ", ininterrompu " << expected.cost << (ok ? "" : "  <- cart") << "\n";
+    return ok;
+}
+
+// Serveur : deux clients envoient des asiatiques entrelaces, regroupes en un lot ; chaque rponse
+// porte l'identifiant de sa demande, et une demande aux trajectoires trop grandes est refuse
+static bool serverBatches(std::ostream& out, ScratchDirectory& scratch) {
+    const std::string socketPath = scratch.file("server.sock");
+    PricingServer server(socketPath, 2, 200000); // Fentre large : toutes les demandes dans le mme lot
+    std::thread serving([&server]() { server.run(); });
+
+    bool ok = false;
+    try {
+        // Le socket n'existe qu'une fois run() lanc
+        for (int attempt = 0; attempt < 2000 && ::access(socketPath.c_str(), F_OK) != 0; ++attempt) ::usleep(1000);
+        PricingClient first(socketPath), second(socketPath);
+        PricingRequest request{0, ProductKind::Asian, OptionType::Call, BarrierType::UpAndOut, 100.0, 1.0, 0.0,
+                               100.0, 0.03, 0.2, 0.01, 2000, 20, 7};
+        for (std::uint64_t id = 1; id <= 4; ++id) {
+            request.id = id;
+            request.strike = 90.0 + 5.0 * id; // Strikes distincts : pas de rponse tire du cache
+            (id % 2 == 1 ? first : second).send(request);
+        }
+        request.id = 5;
+        request.numPaths = 1 << 25; // numPaths * (steps + 1) au-del de 2^25
+        first.send(request);
+
+        // Rponses de chaque client, dans un ordre quelconque : ids 1, 3, 5 puis 2, 4
+        int batched = 0, echoed = 0;
+        bool rejected = false;
+        for (int k = 0; k < 5; ++k) {
+            const PricingResponse response = k < 3 ? first.receive() : second.receive();
+            const bool fromFirst = k < 3;
+            if (response.id >= 1 && response.id <= 5 && (response.id % 2 == 1) == fromFirst) ++echoed;
+            if (response.id == 5) {
+                rejected = !response.ok;
+            } else if (response.ok && response.batchSize > 1) {
+                ++batched;
+            }
+        }
+        ok = batched == 4 && echoed == 5 && rejected;
+        out << "  2 clients, 5 demandes : " << echoed << " identifiant(s) repris, " << batched
+            << " prix calcul(s) en lot, demande trop grande " << (rejected ? "refuse" : "accepte")
+            << (ok ? "" : "  <- cart") << "\n";
+    } catch (...) {
+        server.stop();
+        serving.join();
+        throw;
+    }
+    server.stop();
+    serving.join();
+    return ok;
+}
+
+// Rsultats d'un seul processus et de trois lots runis
+static bool shardsMerge(const std::string& executable, std::ostream& out, ScratchDirectory& scratch) {
+    const std::string tradeFile = scratch.file("trades.txt");
+    {
+        std::ofstream trades(tradeFile);
+        trades << "model 100 0.05 0.2 0.01\nengine 2000 16 42\n";
+        for (int i = 0; i < 40; ++i) {
+            std::ostringstream id;
+            id << (i % 3 == 0 ? "t" : i % 3 == 1 ? "a,b" : "q\"") << i; // Identifiants  citer en CSV
+            trades << id.str() << (i % 4 == 0 ? " call 100 1\n" : i % 4 == 1 ? " asian put 95 1\n"
+                                  : i % 4 == 2 ? " lookback call 105 0.5\n" : " barrier call 100 1 130 upout\n");
+        }
+    }
+    const TradeBook book = BatchPricer::loadTrades(tradeFile);
+
+    bool ok = true;
+    for (const char* extension : {".csv", ".col"}) {
+        const std::string single = scratch.file(std::string("single") + extension);
+        const std::string sharded = scratch.file(std::string("sharded") + extension);
+        BatchPricer::writeShard(book, 0, 1, single);
+        BatchPricer::runSharded(executable, tradeFile, sharded, 3);
+        const bool same = readFile(single) == readFile(sharded) && BatchPricer::readResults(single).size() == book.trades.size();
+        out << "  " << book.trades.size() << " transactions, " << extension << " : lots runis "
+            << (same ? "identiques" : "diffrents") << " au calcul d'un seul processus\n";
+        ok = ok && same;
+    }
+    return ok;
+}
+
+int SelfCheck::run(const std::string& executable, std::ostream& out) {
+    ScratchDirectory scratch;
+    // Le calcul interrompu est lanc par fork avant que d'autres threads n'existent
+    const std::pair<const char*, std::function<bool()> > checks[] = {
+        {"Reprise d'un calcul Monte-Carlo", [&]() { return monteCarloResumes(out, scratch); }},
+        {"Reprise d'une couverture en delta", [&]() { return hedgeResumes(out, scratch); }},
+        {"Loi normale", [&]() { return normalDistributionInverts(out); }},
+        {"Volatilit implicite", [&]() { return impliedVolatilityRecovers(out); }},
+        {"Arne des trajectoires", [&]() { return pathArenaReuses(out); }},
+        {"Matrice de trajectoires", [&]() { return pathMatrixConsistent(out); }},
+        {"Simulation en simple prcision", [&]() { return singlePrecisionAgrees(out); }},
+        {"Sensibilits AAD / diffrences finies", [&]() { return aadMatchesBumps(out); }},
+        {"EDP de Crank-Nicolson", [&]() { return pdeMatchesAnalytic(out); }},
+        {"Arbres et exercice amricain", [&]() { return latticeMatchesAnalytic(out); }},
+        {"Mthode COS sur une large plage de strikes", [&]() { return cosMatchesAnalytic(out); }},
+        {"Modles  sauts", [&]() { return jumpDiffusionMatches(out); }},
+        {"Volatilit locale", [&]() { return localVolatilityFlat(out); }},
+        {"Modle de Heston", [&]() { return hestonMatches(out); }},
+        {"Modle multi-actifs", [&]() { return multiAssetMatches(out); }},
+        {"Serveur de pricing", [&]() { return serverBatches(out, scratch); }},
+        {"Runion des lots", [&]() { return shardsMerge(executable, out, scratch); }}};
+
+    int failures = 0;
+    for (const auto& check : checks) {
+        out << check.first << " :\n";
+        bool ok = false;
+        try {
+            ok = check.second();
+        } catch (const std::exception& error) {
+            out << "  " << error.what() << "\n";
+        }
+        out << (ok ? "  OK\n" : "  CHEC\n");
+        if (!ok) ++failures;
+    }
+    out << (failures == 0 ? "Toutes les vrifications ont russi.\n"
+                          : std::to_string(failures) + " vrification(s) en chec.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#ifndef SELF_CHECK_H
+#define SELF_CHECK_H
+
+#include <ostream> // Compte rendu des vrifications
+#include <string>  // Chemin de l'excutable
+
+// Vrifications de bout en bout du pricer (pricer --check)
+//
+// - loi normale : cdf compare  erfc, aller-retour inverseCdf(cdf(x)) et versions sur tableaux
+//   identiques aux versions scalaires ;
+// - volatilit implicite : les prix analytiques d'un smile redonnent ses volatilits, une par une et
+//   en batch ;
+// - arne des trajectoires : une porte rendue est rutilise, les tampons sont aligns et un prix
+//   Monte-Carlo rpt ne demande plus aucun bloc au systme ;
+// - matrice de trajectoires : lignes alignes, vues par trajectoire cohrentes, version float proche
+//   de la version double et prix  terme actualis gal au spot net de dividendes ;
+// - simulation en simple prcision : sur les mmes nombres alatoires, les prix float d'une
+//   asiatique, d'une barrire et d'une lookback restent  moins de 0.1 erreur standard des prix double ;
+// - sensibilits AAD (delta, vega, rho) d'une asiatique et d'une lookback compares aux diffrences
+//   finies centres des prix Monte-Carlo, sur les mmes nombres alatoires ;
+// - EDP : prix, delta et gamma d'un call et d'un put compars aux formules fermes, barrire observe
+//    dates discrtes compare au Monte-Carlo ;
+// - arbres CRR, Leisen-Reimer et trinomial : put europen compar  la formule ferme, put amricain
+//   au-dessus de l'europen et cohrent entre arbres, call amricain sans dividende gal  l'europen ;
+// - reprise aprs interruption : un calcul Monte-Carlo avec points de reprise tu en cours de route
+//   (processus fils) puis repris, et une couverture en delta arrte puis reprise, donnent le mme
+//   rsultat, bit  bit, qu'un calcul ininterrompu ;
+// - runion des lots : un fichier de transactions calcul par un seul processus et par
+//   BatchPricer::runSharded sur trois processus donne des fichiers de rsultats identiques, en CSV
+//   (identifiants entre guillemets compris) et en colonnes.
+// Les fichiers de travail sont crs dans un rpertoire temporaire, supprim ensuite.
+class SelfCheck {
+public:
+    // Excute les vrifications ; executable est relanc pour les lots (argv[0])
+    // Rend 0 si toutes russissent, 1 sinon
+    static int run(const std::string& executable, std::ostream& out);
+};
+
+#endif // SELF_CHECK_H
@@ -0,0 +1,8 @@
+#ifndef SIMULATION_PRECISION_H
+#define SIMULATION_PRECISION_H
+
+// Prcision de la simulation des trajectoires Monte-Carlo
+// (les sommes de payoffs sont toujours accumules en double)
+enum class SimulationPrecision { Double, Single };
+
+#endif // SIMULATION_PRECISION_H
@@ -0,0 +1,83 @@
+#include "TermStructure.h"
+#include "PricingKey.h" // Cl de cache
+#include <algorithm> // Pour std::max, std::min, std::min_element et std::upper_bound
+#include <stdexcept> // Pour std::invalid_argument
+
+// Courbe vide
+TermStructure::TermStructure() {}
+
+// Courbe  partir de piliers
+TermStructure::TermStructure(const std::vector<double>& times_, const std::vector<double>& values_)
+    : times(times_), values(values_) {
+    if (times.size() != values.size()) {
+        throw std::invalid_argument("TermStructure requires as many values as pillar times.");
+    }
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        if (times[i] <= (i == 0 ? 0.0 : times[i - 1])) {
+            throw std::invalid_argument("TermStructure pillar times must be positive and strictly increasing.");
+        }
+    }
+}
+
+// Valeur sur l'intervalle contenant t
+double TermStructure::value(double t) const {
+    std::size_t i = std::lower_bound(times.begin(), times.end(), t) - times.begin();
+    return values[std::min(i, values.size() - 1)];
+}
+
+// Parcours des intervalles rencontrs entre t0 et t1
+template <typename Func>
+double TermStructure::integrate(double t0, double t1, Func f) const {
+    double sum = 0.0;
+    double start = t0;
+    std::size_t i = std::upper_bound(times.begin(), times.end(), t0) - times.begin();
+    while (start < t1) {
+        double end = (i < times.size() - 1) ? std::min(times[i], t1) : t1; // Dernire valeur prolonge
+        sum += f(values[std::min(i, values.size() - 1)]) * (end - start);
+        start = end;
+        ++i;
+    }
+    return sum;
+}
+
+double TermStructure::integral(double t0, double t1) const {
+    return integrate(t0, t1, [](double v) { return v; });
+}
+
+double TermStructure::integralOfSquare(double t0, double t1) const {
+    return integrate(t0, t1, [](double v) { return v * v; });
+}
+
+// Minimum des valeurs par intervalle
+double TermStructure::minValue() const {
+    return values.empty() ? 0.0 : *std::min_element(values.begin(), values.end());
+}
+
+// Choc parallle : mmes piliers, valeurs translates
+TermStructure TermStructure::shifted(double amount) const {
+    TermStructure result = *this;
+    for (double& v : result.values) v += amount;
+    return result;
+}
+
+// Piliers postrieurs  t, ramens  t ; la dernire valeur reste prolonge
+TermStructure TermStructure::rolled(double t) const {
+    if (empty() || t <= 0.0) return *this;
+    TermStructure result;
+    std::size_t i = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    for (; i < times.size(); ++i) {
+        result.times.push_back(times[i] - t);
+        result.values.push_back(values[i]);
+    }
+    if (result.times.empty()) { // t au-del du dernier pilier : courbe constante
+        result.times.push_back(1.0);
+        result.values.push_back(values.back());
+    }
+    return result;
+}
+
+// Nombre de piliers puis couples (pilier, valeur)
+void TermStructure::appendKey(PricingKey& key) const {
+    key.add(static_cast<long long>(times.size()));
+    for (std::size_t i = 0; i < times.size(); ++i) key.add(times[i]).add(values[i]);
+}
@@ -0,0 +1,53 @@
+#ifndef TERM_STRUCTURE_H
+#define TERM_STRUCTURE_H
+
+#include <vector>
+
+class PricingKey;
+
+// Courbe dterministe constante par morceaux (taux court, taux de dividende, volatilit)
+// values[i] s'applique sur ]times[i - 1], times[i]] (avec times[-1] = 0) ; la dernire valeur
+// est prolonge au-del du dernier pilier. Une courbe vide signifie "paramtre scalaire du modle".
+class TermStructure {
+public:
+    // Courbe vide
+    TermStructure();
+
+    // Courbe  partir de piliers strictement croissants et des valeurs associes
+    // Lve std::invalid_argument si les tailles diffrent ou si les piliers ne sont pas croissants
+    TermStructure(const std::vector<double>& times_, const std::vector<double>& values_);
+
+    // Vrai si aucun pilier n'est dfini
+    bool empty() const { return values.empty(); }
+
+    // Valeur instantane  la date t
+    double value(double t) const;
+
+    // Intgrale de la courbe sur [t0, t1]
+    double integral(double t0, double t1) const;
+
+    // Intgrale du carr de la courbe sur [t0, t1] (variance intgre pour une volatilit)
+    double integralOfSquare(double t0, double t1) const;
+
+    // Plus petite valeur de la courbe (0 pour une courbe vide)
+    double minValue() const;
+
+    // Mme courbe translate de amount (choc parallle)
+    TermStructure shifted(double amount) const;
+
+    // Mme courbe vue depuis la date t : la valeur en s de la courbe rendue est la valeur en t + s
+    TermStructure rolled(double t) const;
+
+    // Ajoute les piliers et les valeurs  une cl de cache
+    void appendKey(PricingKey& key) const;
+
+private:
+    // Intgrale de f(valeur) sur [t0, t1], morceau par morceau
+    template <typename Func>
+    double integrate(double t0, double t1, Func f) const;
+
+    std::vector<double> times;  // Fins des intervalles
+    std::vector<double> values; // Valeur sur chaque intervalle
+};
+
+#endif // TERM_STRUCTURE_H
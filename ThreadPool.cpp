@@ -0,0 +1,49 @@
+#include "ThreadPool.h"
+#include "Parallel.h" // Pour defaultThreadCount
+
+// Cration des threads de travail
+ThreadPool::ThreadPool(unsigned numThreads) : stopping(false) {
+    if (numThreads == 0) numThreads = defaultThreadCount();
+    workers.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+// Les tches en file sont excutes avant l'arrt
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    available.notify_one();
+}
+
+// Boucle d'un thread de travail : attend une tche, l'excute hors verrou
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return; // Arrt demand et file vide
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,56 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable> // Rveil des threads de travail
+#include <deque>              // File des tches
+#include <functional>         // Pour std::function
+#include <future>             // Pour std::future et std::packaged_task
+#include <memory>             // Pour std::make_shared
+#include <mutex>              // Pour std::mutex
+#include <thread>             // Pour std::thread
+#include <vector>             // Pour les threads de travail
+
+// Groupe de threads de travail aliments par une file FIFO de tches
+// Les threads sont crs une fois et l'appelant n'attend pas : submit rend immdiatement un
+// std::future. ThreadPool::shared() excute aussi les blocs de parallelFor.
+class ThreadPool {
+public:
+    // Constructeur : numThreads threads (0 : nombre de coeurs)
+    explicit ThreadPool(unsigned numThreads = 0);
+
+    // Termine les tches dj soumises puis arrte les threads
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Soumet task() ; le future reoit sa valeur de retour ou son exception
+    template <typename Func>
+    auto submit(Func task) -> std::future<decltype(task())> {
+        typedef decltype(task()) Result;
+        auto packaged = std::make_shared<std::packaged_task<Result()> >(std::move(task));
+        std::future<Result> future = packaged->get_future();
+        post([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // Soumet task() sans future : task doit traiter elle-mme ses exceptions
+    void post(std::function<void()> task);
+
+    // Nombre de threads de travail
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Groupe partag par toute la bibliothque (cr au premier appel)
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()> > tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
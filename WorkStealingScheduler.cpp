@@ -0,0 +1,146 @@
+#include "WorkStealingScheduler.h"
+#include "Parallel.h" // Pour defaultThreadCount
+#include <stdexcept>  // Pour std::logic_error
+
+// Thread de travail courant (ordonnanceur et indice), pour les soumissions imbriques
+static thread_local const WorkStealingScheduler* currentScheduler = nullptr;
+static thread_local unsigned currentWorker = 0;
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned numThreads)
+    : epoch(std::chrono::steady_clock::now()), queued(0), pending(0), stopping(false) {
+    if (numThreads == 0) numThreads = defaultThreadCount();
+    queues.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t) queues.emplace_back(new WorkerQueue());
+    threads.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t) {
+        threads.emplace_back([this, t]() { workerLoop(t); });
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allDone.wait(lock, [this]() { return pending == 0; });
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void WorkStealingScheduler::submit(std::function<void()> task, int tag) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++pending;
+    }
+    if (currentScheduler == this) {
+        std::lock_guard<std::mutex> lock(queues[currentWorker]->mutex);
+        queues[currentWorker]->tasks.push_back(Task{std::move(task), tag});
+    } else {
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        injected.push_back(Task{std::move(task), tag});
+    }
+    {
+        // Incrment sous stateMutex : un thread qui s'endort ne peut pas manquer la tche
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queued.fetch_add(1);
+    }
+    workAvailable.notify_one();
+}
+
+void WorkStealingScheduler::wait() {
+    if (currentScheduler == this) {
+        throw std::logic_error("WorkStealingScheduler::wait cannot be called from one of its own tasks.");
+    }
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allDone.wait(lock, [this]() { return pending == 0; });
+        std::swap(error, failure);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+std::vector<TaskTiming> WorkStealingScheduler::takeTimings() {
+    std::vector<TaskTiming> timings;
+    for (auto& queue : queues) {
+        timings.insert(timings.end(), queue->timings.begin(), queue->timings.end());
+        queue->timings.clear();
+    }
+    return timings;
+}
+
+double WorkStealingScheduler::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// Propre file : la tche la plus rcente
+bool WorkStealingScheduler::popOwn(unsigned index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued.fetch_sub(1);
+    return true;
+}
+
+// File d'injection : la tche extrieure la plus ancienne
+bool WorkStealingScheduler::popInjected(Task& task) {
+    std::lock_guard<std::mutex> lock(injectedMutex);
+    if (injected.empty()) return false;
+    task = std::move(injected.front());
+    injected.pop_front();
+    queued.fetch_sub(1);
+    return true;
+}
+
+// Vol : la tche la plus ancienne du premier thread voisin qui en a une
+bool WorkStealingScheduler::steal(unsigned thief, Task& task) {
+    const unsigned n = size();
+    for (unsigned k = 1; k < n; ++k) {
+        WorkerQueue& queue = *queues[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingScheduler::execute(unsigned index, Task& task, bool stolen) {
+    auto start = std::chrono::steady_clock::now();
+    std::exception_ptr error;
+    try {
+        task.run();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    auto end = std::chrono::steady_clock::now();
+    queues[index]->timings.push_back(TaskTiming{task.tag, index, stolen,
+                                                std::chrono::duration<double>(start - epoch).count(),
+                                                std::chrono::duration<double>(end - start).count()});
+    task.run = nullptr; // Libre les captures avant de signaler la fin
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (error && !failure) failure = error;
+    if (--pending == 0) allDone.notify_all();
+}
+
+void WorkStealingScheduler::workerLoop(unsigned index) {
+    currentScheduler = this;
+    currentWorker = index;
+    for (;;) {
+        Task task;
+        if (popOwn(index, task) || popInjected(task)) {
+            execute(index, task, false);
+        } else if (steal(index, task)) {
+            execute(index, task, true);
+        } else {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this]() { return stopping || queued.load() > 0; });
+            if (stopping && queued.load() == 0) return;
+        }
+    }
+}
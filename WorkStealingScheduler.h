@@ -0,0 +1,96 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <atomic>             // Compteurs de tches
+#include <chrono>             // Pour la mesure des temps
+#include <condition_variable> // Rveil des threads de travail
+#include <deque>              // File de chaque thread
+#include <exception>          // Pour std::exception_ptr
+#include <functional>         // Pour std::function
+#include <memory>             // Pour std::unique_ptr
+#include <mutex>              // Pour std::mutex
+#include <thread>             // Pour std::thread
+#include <vector>             // Pour les threads et les mesures
+
+// Mesure d'une tche excute par le WorkStealingScheduler
+struct TaskTiming {
+    int tag;         // tiquette donne  la soumission
+    unsigned worker; // Thread qui a excut la tche
+    bool stolen;     // Tche prise dans la file d'un autre thread (jamais pour une soumission extrieure)
+    double start;    // Dbut, en secondes depuis la cration de l'ordonnanceur
+    double seconds;  // Dure d'excution
+};
+
+// Ordonnanceur par vol de tches
+// Une tche soumise depuis un thread de travail va dans la file de ce thread, qui y dpile ses
+// tches par la fin (les plus rcentes, dont les donnes sont encore en cache). Les tches soumises
+// de l'extrieur vont dans une file d'injection commune, servie dans l'ordre de soumission : les
+// tches soumises en premier dmarrent en premier. Un thread sans tche locale ni injecte vole la
+// tche la plus ancienne de la file d'un autre thread. Les charges htrognes (morceaux de
+// Monte-Carlo, lots de prix analytiques, pas de couverture) s'quilibrent ainsi dynamiquement, sans
+// dcoupage statique pralable. Chaque excution est mesure (TaskTiming).
+// Les threads sont conservs d'un wait()  l'autre : un mme ordonnanceur sert plusieurs lots.
+class WorkStealingScheduler {
+public:
+    // Constructeur : numThreads threads (0 : nombre de coeurs)
+    explicit WorkStealingScheduler(unsigned numThreads = 0);
+
+    // Arrte les threads aprs les tches dj soumises
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    // Soumet une tche ; tag est repris dans sa mesure
+    void submit(std::function<void()> task, int tag = 0);
+
+    // Attend la fin de toutes les tches soumises (y compris celles qu'elles ont soumises)
+    // Relance la premire exception leve par une tche
+    // Lve std::logic_error depuis une tche de cet ordonnanceur : elle compte parmi les tches
+    // attendues et l'attente ne finirait jamais
+    void wait();
+
+    // Mesures des tches termines depuis le dernier appel ( appeler aprs wait)
+    std::vector<TaskTiming> takeTimings();
+
+    // Nombre de threads de travail
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+    // Secondes coules depuis la cration (origine des dbuts de TaskTiming)
+    double elapsed() const;
+
+private:
+    struct Task {
+        std::function<void()> run;
+        int tag;
+    };
+
+    // File et mesures d'un thread de travail
+    struct WorkerQueue {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::vector<TaskTiming> timings; // crites par le seul thread propritaire
+    };
+
+    void workerLoop(unsigned index);
+    bool popOwn(unsigned index, Task& task);
+    bool popInjected(Task& task);
+    bool steal(unsigned thief, Task& task);
+    void execute(unsigned index, Task& task, bool stolen);
+
+    std::vector<std::unique_ptr<WorkerQueue> > queues;
+    std::deque<Task> injected;             // Soumissions extrieures, dans l'ordre
+    std::mutex injectedMutex;
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point epoch;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable; // Tche en file ou arrt
+    std::condition_variable allDone;       // Plus aucune tche en cours
+    std::atomic<long> queued;              // Tches en file
+    long pending;                          // Tches soumises non termines (sous stateMutex)
+    std::exception_ptr failure;            // Premire exception (sous stateMutex)
+    bool stopping;
+};
+
+#endif // WORK_STEALING_SCHEDULER_H
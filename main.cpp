@@ -4,9 +4,19 @@
 #include "BarrierOption.h"     // Classe pour les options barrire
 #include "AsianOption.h"       // Classe pour les options asiatiques
 #include "LookbackOption.h"    // Classe pour les options lookback
+#include "PdeEngine.h"         // Moteur EDP (diffrences finies) pour vanilles et barrires
+#include "LatticeEngine.h"     // Arbres binomiaux/trinomiaux (exercice amricain)
+#include "LongstaffSchwartzEngine.h" // Monte-Carlo de Longstaff-Schwartz (exercice anticip des exotiques)
+#include "PricingServer.h"     // Mode serveur sur socket Unix
+#include "BatchPricer.h"       // Pricing d'un fichier de transactions, rparti sur plusieurs processus
+#include "PricingContext.h"    // Graine commune de tous les calculs alatoires
+#include "SelfCheck.h"         // Vrifications de bout en bout (pricer --check)
+#include <csignal>             // Arrt du serveur par SIGINT / SIGTERM
+#include <cstdlib>             // Pour std::atoi
+#include <string>              // Pour les arguments de la ligne de commande
 #include <iostream>            // Pour les entres/sorties standard
-#include <memory>              // Pour std::unique_ptr (non utilis ici, mais peut tre pertinent pour les extensions)
-#include <vector>              // Pour grer les collections (non utilis dans ce code)
+#include <random>              // Pour le gnrateur du moteur de Longstaff-Schwartz
+#include <vector>              // Pour la liste des fichiers de lots  runir
 
 // Fonction pour afficher le menu des types d'options disponibles
 void displayMenu() {
@@ -24,8 +34,77 @@ void displayMenu() {
     std::cout << "0. Quitter\n";
 }
 
+// Serveur en cours d'excution (arrt depuis le gestionnaire de signal)
+static PricingServer* activeServer = nullptr;
+
+static void stopServer(int) {
+    if (activeServer) activeServer->stop();
+}
+
+// Mode serveur : pricer --server <socket> [threads]
+static int runServer(const std::string& socketPath, unsigned numThreads) {
+    PricingServer server(socketPath, numThreads);
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::cout << "Serveur de pricing  l'coute sur " << socketPath << "\n";
+    try {
+        server.run();
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << "\n";
+        activeServer = nullptr;
+        return 1;
+    }
+    activeServer = nullptr;
+    std::cout << "Serveur de pricing arrt.\n";
+    return 0;
+}
+
+// Modes de traitement par lots :
+//   pricer --batch <transactions> <rsultats> [processus]
+//   pricer --shard <transactions> <lot> <nombre de lots> <rsultats du lot> [threads]
+//   pricer --merge <rsultats> <rsultats des lots>...
+static int runBatch(int argc, char* argv[]) {
+    const std::string mode = argv[1];
+    try {
+        if (mode == "--batch" && argc >= 4) {
+            int numShards = argc >= 5 ? std::atoi(argv[4]) : 1;
+            if (numShards > 1) {
+                BatchPricer::runSharded(argv[0], argv[2], argv[3], numShards);
+            } else {
+                TradeBook book = BatchPricer::loadTrades(argv[2]);
+                BatchPricer::writeShard(book, 0, 1, argv[3]);
+            }
+        } else if (mode == "--shard" && argc >= 6) {
+            TradeBook book = BatchPricer::loadTrades(argv[2]);
+            unsigned numThreads = argc >= 7 ? static_cast<unsigned>(std::atoi(argv[6])) : 0;
+            BatchPricer::writeShard(book, std::atoi(argv[3]), std::atoi(argv[4]), argv[5], numThreads);
+        } else if (mode == "--merge" && argc >= 4) {
+            BatchPricer::merge(std::vector<std::string>(argv + 3, argv + argc), argv[2]);
+        } else {
+            std::cerr << "Arguments invalides pour " << mode << "\n";
+            return 2;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
 // Point d'entre principal du programme
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && std::string(argv[1]) == "--server") {
+        return runServer(argv[2], argc >= 4 ? static_cast<unsigned>(std::atoi(argv[3])) : 0);
+    }
+    if (argc >= 2 && (std::string(argv[1]) == "--batch" || std::string(argv[1]) == "--shard" ||
+                      std::string(argv[1]) == "--merge")) {
+        return runBatch(argc, argv);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--check") { // Vrifications : pricer --check
+        return SelfCheck::run(argv[0], std::cout);
+    }
+
     // Initialisation des paramtres du modle Black-Scholes
     double spot, rate, volatility, dividend;
     std::cout << "Entrez les paramtres du modle Black-Scholes :\n";
@@ -62,22 +141,36 @@ int main() {
         int numPaths = 10000;  // Nombre de simulations Monte-Carlo
         int steps = 100;       // Nombre de pas temporels
 
+        // Variante amricaine des exotiques (exercice possible  chaque pas)
+        LongstaffSchwartzEngine lsmEngine;
+        // Graine fixe : deux excutions avec les mmes paramtres affichent les mmes prix
+        PricingContext context;
+        std::mt19937 rng = context.generator();
+
         if (choice == 1) {
             // Option call
             CallOption callOption(strike, maturity);
             double price = model.priceAnalytic(&callOption, true); // Calcul analytique du prix
-            double hedgeCost = callOption.hedgeCost(model, steps); // Calcul du cot de rplication
+            double hedgeCost = callOption.hedgeCost(model, steps, context); // Calcul du cot de rplication
             std::cout << "Prix du call option : " << price << "\n";
             std::cout << "Cot de rplication : " << hedgeCost << "\n";
 
+            // Exercice amricain par arbre de Leisen-Reimer
+            LatticeResult american = LatticeEngine().price(model, callOption, ExerciseStyle::American);
+            std::cout << "Prix amricain (arbre) : " << american.price << "\n";
+
         } else if (choice == 2) {
             // Option put
             PutOption putOption(strike, maturity);
             double price = model.priceAnalytic(&putOption, false); // Calcul analytique du prix
-            double hedgeCost = putOption.hedgeCost(model, steps); // Calcul du cot de rplication
+            double hedgeCost = putOption.hedgeCost(model, steps, context); // Calcul du cot de rplication
             std::cout << "Prix du put option : " << price << "\n";
             std::cout << "Cot de rplication : " << hedgeCost << "\n";
 
+            // Exercice amricain par arbre de Leisen-Reimer
+            LatticeResult american = LatticeEngine().price(model, putOption, ExerciseStyle::American);
+            std::cout << "Prix amricain (arbre) : " << american.price << "\n";
+
         } else if (choice >= 3 && choice <= 6) {
             // Options barrires
             double barrier;
@@ -116,30 +209,41 @@ int main() {
             }
 
             BarrierOption barrierOption(strike, maturity, barrier, barrierType, optionType);
-            double price = barrierOption.price(model, numPaths, steps); // Calcul du prix par Monte-Carlo
-            double hedgeCost = barrierOption.hedgeCost(model, steps);  // Calcul du cot de rplication
+            double price = barrierOption.price(model, numPaths, steps, context); // Calcul du prix par Monte-Carlo
+            double hedgeCost = barrierOption.hedgeCost(model, steps, context);  // Calcul du cot de rplication
             std::cout << "Prix de l'option barrire : " << price << "\n";
             std::cout << "Cot de rplication : " << hedgeCost << "\n";
+            std::cout << "Prix amricain (Longstaff-Schwartz) : "
+                      << lsmEngine.price(barrierOption, model, numPaths, steps, rng).price << "\n";
+
+            // Moteur EDP avec la mme frquence d'observation de la barrire que le Monte-Carlo
+            PdeEngine pdeEngine(400, 200, 2, 5.0, steps);
+            PdeResult pde = pdeEngine.price(model, barrierOption);
+            std::cout << "Prix EDP : " << pde.price << " (delta : " << pde.delta << ", gamma : " << pde.gamma << ")\n";
 
         } else if (choice == 7 || choice == 8) {
             // Options asiatiques
             OptionType optionType = (choice == 7) ? OptionType::Call : OptionType::Put;
 
             AsianOption asianOption(strike, maturity, optionType);
-            double price = asianOption.price(model, numPaths, steps); // Calcul du prix par Monte-Carlo
-            double hedgeCost = asianOption.hedgeCost(model, steps);  // Calcul du cot de rplication
+            double price = asianOption.price(model, numPaths, steps, context); // Calcul du prix par Monte-Carlo
+            double hedgeCost = asianOption.hedgeCost(model, steps, context);  // Calcul du cot de rplication
             std::cout << "Prix de l'option asiatique : " << price << "\n";
             std::cout << "Cot de rplication : " << hedgeCost << "\n";
+            std::cout << "Prix amricain (Longstaff-Schwartz) : "
+                      << lsmEngine.price(asianOption, model, numPaths, steps, rng).price << "\n";
 
         } else if (choice == 9 || choice == 10) {
             // Options lookback
             OptionType optionType = (choice == 9) ? OptionType::Call : OptionType::Put;
 
             LookbackOption lookbackOption(strike, maturity, optionType);
-            double price = lookbackOption.price(model, numPaths, steps); // Calcul du prix par Monte-Carlo
-            double hedgeCost = lookbackOption.hedgeCost(model, steps);  // Calcul du cot de rplication
+            double price = lookbackOption.price(model, numPaths, steps, context); // Calcul du prix par Monte-Carlo
+            double hedgeCost = lookbackOption.hedgeCost(model, steps, context);  // Calcul du cot de rplication
             std::cout << "Prix de l'option lookback : " << price << "\n";
             std::cout << "Cot de rplication : " << hedgeCost << "\n";
+            std::cout << "Prix amricain (Longstaff-Schwartz) : "
+                      << lsmEngine.price(lookbackOption, model, numPaths, steps, rng).price << "\n";
 
         } else {
             std::cout << "Choix invalide. Veuillez ressayer.\n";